@@ -2,10 +2,98 @@
 
 #include "SimpleInventory.h"
 
-#include "SimpleInventorySlot.h"
 #include "SimpleInventoryLog.h"
+#include "SimpleInventoryStats.h"
 #include "SimpleInventoryChange.h"
 #include "SimpleInventoryChangeType.h"
+#include "SimpleInventoryItemAccessor.h"
+#include "SimpleInventoryItemRegistry.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+
+namespace SimpleInventorySort
+{
+    /** A slot's sort key, read once before sorting so comparisons on worker threads only touch plain values. */
+    struct FSortValue
+    {
+        /** 0: has a key, 1: the item has no such property, 2: empty slot. Lower groups always sort first. */
+        uint8 Group = 0;
+        
+        /** 0: integer, 1: floating point, 2: string. Only differs between slots if a property's type differs between structs. */
+        uint8 Kind = 0;
+        
+        int64 IntValue = 0;
+        double FloatValue = 0.0;
+        FString StringValue;
+    };
+    
+    static bool ValueLess(const FSortValue& A,
+                          const FSortValue& B) {
+        if (A.Kind != B.Kind) {
+            return A.Kind < B.Kind;
+        }
+        switch (A.Kind) {
+            case 0:
+                return A.IntValue < B.IntValue;
+            case 1:
+                return A.FloatValue < B.FloatValue;
+            default:
+                return A.StringValue < B.StringValue;
+        }
+    }
+    
+    /**
+     * Reads a property into a sort value.
+     *
+     * @param Property  The property, or nullptr if the item has none by that name.
+     * @param Memory    The item's memory.
+     * @param Value     The sort value to fill.
+     */
+    static void ReadPropertyValue(const FProperty* Property,
+                                  const void* Memory,
+                                  FSortValue& Value) {
+        if (!Property) {
+            Value.Group = 1;
+            return;
+        }
+        
+        const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Memory);
+        const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+        if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property)) {
+            NumericProperty = EnumProperty->GetUnderlyingProperty();
+        }
+        
+        if (NumericProperty && NumericProperty->IsFloatingPoint()) {
+            Value.Kind = 1;
+            Value.FloatValue = NumericProperty->GetFloatingPointPropertyValue(PropertyValue);
+        }
+        else if (NumericProperty) {
+            Value.IntValue = NumericProperty->GetSignedIntPropertyValue(PropertyValue);
+        }
+        else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property)) {
+            Value.IntValue = BoolProperty->GetPropertyValue(PropertyValue) ? 1 : 0;
+        }
+        else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property)) {
+            Value.Kind = 2;
+            Value.StringValue = NameProperty->GetPropertyValue(PropertyValue).ToString();
+        }
+        else if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property)) {
+            Value.Kind = 2;
+            Value.StringValue = StrProperty->GetPropertyValue(PropertyValue);
+        }
+        else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property)) {
+            Value.Kind = 2;
+            Value.StringValue = TextProperty->GetPropertyValue(PropertyValue).ToString();
+        }
+        else {
+            Value.Group = 1;
+        }
+    }
+}
 
 // Lifecycle
 
@@ -15,6 +103,80 @@
  */
 USimpleInventory::USimpleInventory() {
     InventorySlots.Reserve(MaxSlotSize);
+    
+    if (!HasAnyFlags(RF_ClassDefaultObject)) {
+        INC_DWORD_STAT(STAT_SimpleInventory_NumInventories);
+    }
+}
+
+/**
+ * Removes this inventory and its slots from the stat counters.
+ */
+void USimpleInventory::BeginDestroy() {
+    if (!HasAnyFlags(RF_ClassDefaultObject)) {
+        DEC_DWORD_STAT(STAT_SimpleInventory_NumInventories);
+        DEC_DWORD_STAT_BY(STAT_SimpleInventory_NumSlots, ReportedSlotCount);
+        ReportedSlotCount = 0;
+    }
+    
+    Super::BeginDestroy();
+}
+
+/**
+ * Fills in a pending copy before saving, so InventorySlots is written with the copied slots.
+ * After loading, rebuilds the slot indices and item totals, which are not saved. Slots saved as
+ * `USimpleInventorySlot` objects are converted by `FSimpleInventorySlot::SerializeFromMismatchedTag`.
+ *
+ * @param Ar  The archive.
+ */
+void USimpleInventory::Serialize(FArchive& Ar) {
+    const bool bSavingSlots = Ar.IsSaving() && !Ar.IsObjectReferenceCollector();
+    if (bSavingSlots && !IsInGameThread()) {
+        // A pending copy is only applied on the game thread, so its slots stand in for InventorySlots while they
+        // are written. The read lock keeps the game thread from applying or changing them meanwhile.
+        FReadScopeLock ReadLock(SlotLock);
+        const bool bWritePendingCopy = PendingCopy.IsValid();
+        if (bWritePendingCopy) {
+            PendingCopy.CopySlots(InventorySlots);
+        }
+        
+        Super::Serialize(Ar);
+        
+        if (bWritePendingCopy) {
+            InventorySlots.Empty();
+        }
+        return;
+    }
+    
+    if (bSavingSlots) {
+        ResolvePendingCopy();
+    }
+    
+    Super::Serialize(Ar);
+    
+    if (Ar.IsLoading() && !Ar.IsObjectReferenceCollector()) {
+        PendingCopy = FSimpleInventorySnapshot();
+        CachedSnapshot = FSimpleInventorySnapshot();
+        SlotViews.Empty();
+        RebuildSlotIndex();
+        ItemTotals.Reset();
+        AccumulateItemTotals(ItemTotals, 1);
+    }
+}
+
+/**
+ * Reports the lazily created slot views to the garbage collector. They are not a UPROPERTY since they are rebuilt
+ * on demand from InventorySlots. The items of a pending copy and of every snapshot are reported by their chunks.
+ *
+ * @param InThis     The inventory being scanned.
+ * @param Collector  The reference collector.
+ */
+void USimpleInventory::AddReferencedObjects(UObject* InThis,
+                                            FReferenceCollector& Collector) {
+    Super::AddReferencedObjects(InThis, Collector);
+    
+    USimpleInventory* This = CastChecked<USimpleInventory>(InThis);
+    Collector.AddReferencedObjects(This->SlotViews);
 }
 
 // Public Functions
@@ -30,6 +192,8 @@ USimpleInventory::USimpleInventory() {
 void USimpleInventory::AddItem(FInstancedStruct Item,
                                const int32 Count,
                                bool& Result)  {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::AddItem", STAT_SimpleInventory_AddItem);
+    FSlotWriteScope WriteScope(this);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::AddItem"));
     
     Result = false;
@@ -38,101 +202,48 @@ void USimpleInventory::AddItem(FInstancedStruct Item,
         return;
     }
     
-    static const FName IDPropName = TEXT("ID");
-    static const FName IsStackablePropName = TEXT("bIsStackable");
-    static const FName StackSizePropName = TEXT("StackSize");
-    
-    const UStruct* ItemStructType = Item.GetScriptStruct();
-    void* ItemStructMemory = Item.GetMutableMemory();
+    const UScriptStruct* ItemStructType = Item.GetScriptStruct();
+    const void* ItemStructMemory = Item.GetMemory();
     if (!ItemStructType || !ItemStructMemory) {
         UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItem || Struct type or memory is null"));
         return;
     }
     
     // Get the ItemID from the struct
-    FProperty* ItemIDProp = ItemStructType->FindPropertyByName(IDPropName);
-    FIntProperty* ItemIDIntProp = CastField<FIntProperty>(ItemIDProp);
-    if (!ItemIDIntProp) {
+    const FSimpleInventoryItemAccessor ItemAccessor = FSimpleInventoryItemAccessorCache::Get(ItemStructType);
+    if (!ItemAccessor.IsValid()) {
         UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItem || Struct missing valid 'ID' int property"));
         return;
     }
-    const int32 ItemID = ItemIDIntProp->GetPropertyValue_InContainer(ItemStructMemory);
+    const int32 ItemID = ItemAccessor.GetID(ItemStructMemory);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::AddItem || ItemID = %d"), ItemID);
     
-    int32 Remaining = Count;
-    
-    // --- Pass 1: Fill existing stacks ---
-    for (USimpleInventorySlot* iSlot : InventorySlots) {
-        if (!iSlot || !iSlot->Item.IsValid() || Remaining <= 0) {
-            continue;
-        }
-        
-        const UStruct* SlotStruct = iSlot->Item.GetScriptStruct();
-        void* SlotMemory = iSlot->Item.GetMutableMemory();
-        if (!SlotStruct || !SlotMemory) {
-            continue;
-        }
-        
-        FIntProperty* SlotIDProp = CastField<FIntProperty>(SlotStruct->FindPropertyByName(IDPropName));
-        FBoolProperty* StackableProp = CastField<FBoolProperty>(SlotStruct->FindPropertyByName(IsStackablePropName));
-        FIntProperty* StackSizeProp = CastField<FIntProperty>(SlotStruct->FindPropertyByName(StackSizePropName));
-        
-        if (!SlotIDProp || !StackableProp || !StackSizeProp) {
-            UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItem || Slot missing expected properties"));
-            continue;
-        }
-        
-        const int32 SlotItemID = SlotIDProp->GetPropertyValue_InContainer(SlotMemory);
-        const bool bStackable = StackableProp->GetPropertyValue_InContainer(SlotMemory);
-        const int32 MaxStackSize = StackSizeProp->GetPropertyValue_InContainer(SlotMemory);
-        
-        if (SlotItemID == ItemID && bStackable) {
-            int32 SpaceLeft = MaxStackSize - iSlot->Count;
-            if (SpaceLeft > 0) {
-                int32 ToAdd = FMath::Min(SpaceLeft, Remaining);
-                iSlot->Count += ToAdd;
-                Remaining -= ToAdd;
-                
-                USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-                Change->InventoryName = InventoryName;
-                Change->Type = ESimpleInventoryChangeType::ADDITION;
-                Change->Item = Item;
-                Change->Count = ToAdd;
-                OnInventoryChangeEvent.Broadcast(Change);
-                
-                UE_LOG(SimpleInventoryLog, Log, TEXT("USimpleInventory::AddItem || Added %d items to existing stack"), ToAdd);
-            }
-        }
-    }
+    Result = AddResolvedItem(FConstStructView(Item), ItemAccessor, ItemID, Count) == 0;
+}
+
+/**
+ * Adds an item by ID from its registered definition. New slots reference the definition instead of copying it.
+ *
+ * @param ItemID  The ID of a registered item definition.
+ * @param Count   The number of items to add.
+ * @param Result  True if the item(s) were added successfully, false otherwise.
+ */
+void USimpleInventory::AddItemByID(const int32 ItemID,
+                                   const int32 Count,
+                                   bool& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::AddItemByID", STAT_SimpleInventory_AddItemByID);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::AddItemByID || ItemID: %i | Count: %i"), ItemID, Count);
     
-    // --- Pass 2: Create new stacks ---
-    while (Remaining > 0 && InventorySlots.Num() < MaxSlotSize) {
-        const int32 ToAdd = Remaining;
-        
-        AddItemToNewSlot(Item, ToAdd);
-        
-        USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-        Change->InventoryName = InventoryName;
-        Change->Type = ESimpleInventoryChangeType::ADDITION;
-        Change->Item = Item;
-        Change->Count = ToAdd;
-        OnInventoryChangeEvent.Broadcast(Change);
-        
-        UE_LOG(SimpleInventoryLog, Log, TEXT("USimpleInventory::AddItem || Added %d items to new slot"), ToAdd);
-        
-        Remaining -= ToAdd;
+    Result = false;
+    const FConstStructView Definition = FSimpleInventoryItemRegistry::Find(ItemID);
+    if (!Definition.IsValid()) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItemByID || No registered definition for item %d"), ItemID);
+        return;
     }
     
-    Result = (Remaining == 0);
-    
-    if (!Result) {
-        UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItem || Inventory full, %d items could not be added"), Remaining);
-        
-        USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-        Change->InventoryName = InventoryName;
-        Change->Type = ESimpleInventoryChangeType::FULL;
-        OnInventoryChangeEvent.Broadcast(Change);
-    }
+    const FSimpleInventoryItemAccessor ItemAccessor = FSimpleInventoryItemAccessorCache::Get(Definition.GetScriptStruct());
+    Result = AddResolvedItem(Definition, ItemAccessor, ItemID, Count) == 0;
 }
 
 /**
@@ -146,6 +257,8 @@ void USimpleInventory::AddItem(FInstancedStruct Item,
 void USimpleInventory::RemoveItemAtIndex(const int32 Index,
                                          const int32 Count,
                                          bool& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::RemoveItemAtIndex", STAT_SimpleInventory_RemoveItemAtIndex);
+    FSlotWriteScope WriteScope(this);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::RemoveItemAtIndex || Index: %i | Count: %i"), Index, Count);
     
     if (!InventorySlots.IsValidIndex(Index)) {
@@ -153,23 +266,28 @@ void USimpleInventory::RemoveItemAtIndex(const int32 Index,
         return;
     }
     
-    USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-    Change->InventoryName = InventoryName;
-    Change->Type = ESimpleInventoryChangeType::REMOVAL;
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::REMOVAL;
     
-    USimpleInventorySlot *Slot = InventorySlots[Index];
-    Change->Type = ESimpleInventoryChangeType::REMOVAL;
-    Change->Item = Slot->Item;
-    Slot->Count -= Count;
+    FSimpleInventorySlot& Slot = InventorySlots[Index];
+    Change.ItemID = Slot.ItemID;
+    Change.SlotIndex = Index;
+    Change.Delta = -FMath::Min(Count, Slot.Count);
+    Slot.Count -= Count;
     
-    if (Slot->Count <= 0) {
-        InventorySlots.RemoveAt(Index);
-        Change->Count = 0;
+    if (Slot.Count <= 0) {
+        // Keep the removed item alive until the change is queued.
+        const FSimpleInventorySlot RemovedSlot = RemoveSlotAt(Index);
+        Change.Item = RemovedSlot.GetItem();
+        Change.Count = 0;
+        NotifyChange(Change);
     }
     else {
-        Change->Count = Slot->Count;
+        Change.Item = Slot.GetItem();
+        Change.Count = Slot.Count;
+        NotifyChange(Change);
     }
-    OnInventoryChangeEvent.Broadcast(Change);
     
     Result = true;
 }
@@ -183,46 +301,173 @@ void USimpleInventory::RemoveItemAtIndex(const int32 Index,
  */
 void USimpleInventory::RemoveItems(const TArray<FInstancedStruct>& Items,
                                    bool& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::RemoveItems", STAT_SimpleInventory_RemoveItems);
+    FSlotWriteScope WriteScope(this);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::RemoveItems"));
     
-    const FName IDPropName = FName("ID");
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::MULTI_REMOVAL;
     
-    uint8 RemainingCount = Items.Num();
-    for (FInstancedStruct Item : Items) {
-        const UStruct* ItemStructType = Item.GetScriptStruct();
-        void* ItemStructMemory = Item.GetMutableMemory();
+    int32 RemainingCount = Items.Num();
+    for (const FInstancedStruct& Item : Items) {
+        const FSimpleInventoryItemAccessor ItemAccessor = FSimpleInventoryItemAccessorCache::Get(Item.GetScriptStruct());
+        if (!ItemAccessor.IsValid() || !Item.GetMemory()) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::RemoveItems || Struct missing valid 'ID' int property"));
+            continue;
+        }
+        const int32 ItemID = ItemAccessor.GetID(Item.GetMemory());
         
-        FProperty* ItemIDProp = ItemStructType->FindPropertyByName(IDPropName);
-        FIntProperty* ItemIDIntProp = CastField<FIntProperty>(ItemIDProp);
-        int32 ItemID = ItemIDIntProp->GetPropertyValue_InContainer(ItemStructMemory);
+        // Emptied slots stay in place until every item is taken, so skip them.
+        const TArray<int32>* SlotIndices = SlotIndicesByItemID.Find(ItemID);
+        const int32* Index = SlotIndices ? SlotIndices->FindByPredicate([this](const int32 SlotIndex) {
+            return InventorySlots[SlotIndex].Count > 0;
+        }) : nullptr;
+        if (!Index) {
+            continue;
+        }
+        
+        InventorySlots[*Index].Count -= 1;
+        --RemainingCount;
+        Change.SlotIndices.AddUnique(*Index);
+        Change.AddItemDelta(ItemID, -1);
+    }
+    
+    // Remove emptied slots from the back, so the reported indices all name the slots as they were before the call.
+    Change.SlotIndices.Sort();
+    for (int32 Position = Change.SlotIndices.Num() - 1; Position >= 0; --Position) {
+        if (InventorySlots[Change.SlotIndices[Position]].Count <= 0) {
+            RemoveSlotAt(Change.SlotIndices[Position]);
+        }
+    }
+    
+    NotifyChange(Change);
+    Result = RemainingCount == 0;
+}
+
+/**
+ * Adds several items in one call. Each entry is validated once and placed through the item ID index,
+ * so no entry scans the whole inventory. All changes are merged into one BATCH change.
+ *
+ * With bAllOrNothing, placement is simulated first (existing stack space per ID, then new slots,
+ * including stacks opened by earlier entries) and nothing is added if any entry would not fit.
+ *
+ * @param Entries        The items and amounts to add.
+ * @param bAllOrNothing  If true, nothing is added unless every entry fits.
+ * @param EntryResults   True for each entry that was fully added.
+ * @param Result         True if every entry was fully added.
+ */
+void USimpleInventory::AddItems(const TArray<FSimpleInventoryItemEntry>& Entries,
+                                const bool bAllOrNothing,
+                                TArray<bool>& EntryResults,
+                                bool& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::AddItems", STAT_SimpleInventory_AddItems);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::AddItems || Entries: %i"), Entries.Num());
+    
+    EntryResults.Init(false, Entries.Num());
+    Result = false;
+    
+    TArray<FSimpleInventoryItemAccessor> Accessors;
+    Accessors.SetNum(Entries.Num());
+    bool bAllValid = true;
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex) {
+        const FInstancedStruct& Item = Entries[EntryIndex].Item;
+        Accessors[EntryIndex] = FSimpleInventoryItemAccessorCache::Get(Item.GetScriptStruct());
+        if (!Accessors[EntryIndex].IsValid() || !Item.GetMemory()) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItems || Entry %i is not a valid item"), EntryIndex);
+            bAllValid = false;
+        }
+    }
+    
+    if (bAllOrNothing) {
+        if (!bAllValid) {
+            return;
+        }
         
-        for (uint8 Index = 0; Index < InventorySlots.Num(); ++Index) {
-            USimpleInventorySlot* Slot = InventorySlots[Index];
-            const UStruct* SlotItemStructType = Slot->Item.GetScriptStruct();
-            void* SlotItemStructMemory = Slot->Item.GetMutableMemory();
+        TMap<int32, int32> FreeSpaceByItemID;
+        int32 SimulatedSlots = InventorySlots.Num();
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex) {
+            const FSimpleInventoryItemAccessor& Accessor = Accessors[EntryIndex];
+            const void* Memory = Entries[EntryIndex].Item.GetMemory();
+            const int32 ItemID = Accessor.GetID(Memory);
+            
+            int32* FreeSpace = FreeSpaceByItemID.Find(ItemID);
+            if (!FreeSpace) {
+                FreeSpace = &FreeSpaceByItemID.Add(ItemID, GetFreeStackSpace(ItemID));
+            }
             
-            FProperty* SlotItemIDProp = SlotItemStructType->FindPropertyByName(IDPropName);
-            FIntProperty* SlotItemIDIntProp = CastField<FIntProperty>(SlotItemIDProp);
-            int32 SlotItemID = SlotItemIDIntProp->GetPropertyValue_InContainer(SlotItemStructMemory);
+            const int32 Stacked = FMath::Clamp(Entries[EntryIndex].Count, 0, *FreeSpace);
+            const int32 Remaining = Entries[EntryIndex].Count - Stacked;
+            *FreeSpace -= Stacked;
             
-            if (SlotItemID == ItemID) {
-                Slot->Count -= 1;
-                --RemainingCount;
-                
-                if (Slot->Count == 0) {
-                    InventorySlots.RemoveAt(Index);
+            if (Remaining > 0) {
+                if (SimulatedSlots >= MaxSlotSize) {
+                    UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItems || Entry %i does not fit, nothing added"), EntryIndex);
+                    return;
+                }
+                ++SimulatedSlots;
+                if (Accessor.HasStackInfo() && Accessor.IsStackable(Memory)) {
+                    *FreeSpace += FMath::Max(0, Accessor.GetStackSize(Memory) - Remaining);
                 }
-                break;
             }
         }
     }
     
-    USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-    Change->InventoryName = InventoryName;
-    Change->Type = ESimpleInventoryChangeType::MULTI_REMOVAL;
+    FSimpleInventoryBatchScope Batch(this);
+    Result = bAllValid;
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex) {
+        const FSimpleInventoryItemAccessor& Accessor = Accessors[EntryIndex];
+        if (!Accessor.IsValid() || !Entries[EntryIndex].Item.GetMemory()) {
+            continue;
+        }
+        
+        const FInstancedStruct& Item = Entries[EntryIndex].Item;
+        EntryResults[EntryIndex] = AddResolvedItem(FConstStructView(Item), Accessor, Accessor.GetID(Item.GetMemory()), Entries[EntryIndex].Count) == 0;
+        Result &= EntryResults[EntryIndex];
+    }
+}
+
+/**
+ * Removes amounts of several items by ID in one call, taking from the last slot holding each item first.
+ * All changes are merged into one BATCH change.
+ *
+ * @param Entries        The item IDs and amounts to remove.
+ * @param bAllOrNothing  If true, nothing is removed unless every entry can be fully removed.
+ * @param EntryResults   True for each entry that was fully removed.
+ * @param Result         True if every entry was fully removed.
+ */
+void USimpleInventory::RemoveItemsByCount(const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                                          const bool bAllOrNothing,
+                                          TArray<bool>& EntryResults,
+                                          bool& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::RemoveItemsByCount", STAT_SimpleInventory_RemoveItemsByCount);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::RemoveItemsByCount || Entries: %i"), Entries.Num());
+    
+    EntryResults.Init(false, Entries.Num());
+    Result = false;
     
-    OnInventoryChangeEvent.Broadcast(Change);
-    Result = RemainingCount == 0;
+    if (bAllOrNothing) {
+        TMap<int32, int32> RequestedByItemID;
+        for (const FSimpleInventoryItemCountEntry& Entry : Entries) {
+            RequestedByItemID.FindOrAdd(Entry.ItemID) += FMath::Max(0, Entry.Count);
+        }
+        for (const auto& Requested : RequestedByItemID) {
+            if (GetItemTotal(Requested.Key) < Requested.Value) {
+                UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::RemoveItemsByCount || Not enough of item %i, nothing removed"), Requested.Key);
+                return;
+            }
+        }
+    }
+    
+    FSimpleInventoryBatchScope Batch(this);
+    Result = true;
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex) {
+        const FSimpleInventoryItemCountEntry& Entry = Entries[EntryIndex];
+        EntryResults[EntryIndex] = RemoveItemCount(Entry.ItemID, Entry.Count) == FMath::Max(0, Entry.Count);
+        Result &= EntryResults[EntryIndex];
+    }
 }
 
 /**
@@ -230,14 +475,27 @@ void USimpleInventory::RemoveItems(const TArray<FInstancedStruct>& Items,
  * Broadcasts a change event of type CLEAR.
  */
 void USimpleInventory::Clear() {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::Clear", STAT_SimpleInventory_Clear);
+    FSlotWriteScope WriteScope(this, false);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::Clear"));
     
-    USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-    Change->InventoryName = InventoryName;
-    Change->Type = ESimpleInventoryChangeType::CLEAR;
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::CLEAR;
+    
+    // The running totals also cover a pending copy, which is dropped without copying its slots.
+    TMap<int32, int32> ItemDeltas;
+    for (const auto& Total : ItemTotals) {
+        ItemDeltas.Add(Total.Key, -Total.Value);
+    }
+    Change.SetItemDeltas(ItemDeltas);
     
+    PendingCopy = FSimpleInventorySnapshot();
     InventorySlots.Empty();
-    OnInventoryChangeEvent.Broadcast(Change);
+    SlotViews.Empty();
+    SlotIndicesByItemID.Empty();
+    SlotIndicesByStructType.Empty();
+    NotifyChange(Change);
 }
 
 /**
@@ -248,7 +506,7 @@ void USimpleInventory::Clear() {
 void USimpleInventory::GetLength(int32& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::GetLength"));
     
-    Result = InventorySlots.Num();
+    Result = GetNumSlots();
 }
 
 /**
@@ -270,25 +528,55 @@ void USimpleInventory::GetMaxSize(int32& Result) {
  */
 void USimpleInventory::GetSlot(const int32 Index,
                                USimpleInventorySlot*& Result) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::GetSlot");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::GetSlot || Index: %i"), Index);
     
-    if (InventorySlots.IsValidIndex(Index)) {
-        Result = InventorySlots[Index];
-    }
-    else {
-        Result = nullptr;
-    }
+    Result = GetSlotView(Index);
 }
 
 /**
- * Retrieves a copy of all current inventory slots.
+ * Retrieves views of all current inventory slots.
  *
  * @param Result  Output array containing all current inventory slots.
  */
 void USimpleInventory::GetSlots(TArray<USimpleInventorySlot*>& Result) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::GetSlots");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::GetSlots"));
     
-    Result = InventorySlots;
+    const int32 NumSlots = GetNumSlots();
+    Result.Reset(NumSlots);
+    for (int32 Index = 0; Index < NumSlots; ++Index) {
+        Result.Add(GetSlotView(Index));
+    }
+}
+
+/**
+ * Returns the authoritative slot array, applying a pending copy first.
+ *
+ * @return  The inventory's slots, including empty padding slots.
+ */
+const TArray<FSimpleInventorySlot>& USimpleInventory::GetSlotData() const {
+    ResolvePendingCopy();
+    return InventorySlots;
+}
+
+/**
+ * Returns the number of slots, counting the slots of a pending copy without applying it.
+ *
+ * @return  The number of slots, including empty padding slots.
+ */
+int32 USimpleInventory::GetNumSlots() const {
+    return PendingCopy.IsValid() ? PendingCopy.Num() : InventorySlots.Num();
+}
+
+/**
+ * Returns one slot, reading it from a pending copy's snapshot without applying it.
+ *
+ * @param Index  The index of the slot. Must be valid.
+ * @return       The slot at Index.
+ */
+const FSimpleInventorySlot& USimpleInventory::GetSlotDataAt(const int32 Index) const {
+    return PendingCopy.IsValid() ? PendingCopy[Index] : InventorySlots[Index];
 }
 
 /**
@@ -302,90 +590,1654 @@ void USimpleInventory::GetSlots(TArray<USimpleInventorySlot*>& Result) const {
 void USimpleInventory::HasItem(const int32 ItemID,
                                const int32 Count,
                                bool& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::HasItem", STAT_SimpleInventory_HasItem);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::HasItem || ItemID: %i | Count: %i"), ItemID, Count);
     
-    const FName IDPropName = FName("ID");
-    Result = false;
-    
-    for (USimpleInventorySlot* Slot : InventorySlots) {
-        const UStruct* SlotItemStructType = Slot->Item.GetScriptStruct();
-        void* SlotItemStructMemory = Slot->Item.GetMutableMemory();
-        
-        FProperty* SlotItemIDProp = SlotItemStructType->FindPropertyByName(IDPropName);
-        if (!SlotItemIDProp) {
-            UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventory::HasItem || ID does not exist on specified struct type"));
-            return;
-        }
-        
-        FIntProperty* SlotItemIDIntProp = CastField<FIntProperty>(SlotItemIDProp);
-        int32 SlotItemID = SlotItemIDIntProp->GetPropertyValue_InContainer(SlotItemStructMemory);
-        
-        if (SlotItemID == ItemID) {
-            Result = Slot->Count == Count;
-            break;
-        }
-    }
+    const int32 SlotIndex = FindFirstSlotIndex(ItemID);
+    Result = SlotIndex != INDEX_NONE && GetSlotDataAt(SlotIndex).Count == Count;
 }
 
 /**
- * Copies the inventory data from another inventory instance.
+ * Gets the total amount of an item across all slots from the running totals.
  *
- * @param OtherInventory  The inventory to copy from.
+ * @param ItemID  The ID of the item.
+ * @param Result  The total count, or 0 if the inventory does not hold the item.
  */
-void USimpleInventory::CopyInventory(const USimpleInventory* OtherInventory) {
-    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::CopyInventory"));
-    
-    MaxSlotSize = OtherInventory->MaxSlotSize;
-    InventorySlots = OtherInventory->InventorySlots;
+void USimpleInventory::GetItemCount(const int32 ItemID,
+                                    int32& Result) const {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::GetItemCount || ItemID: %i"), ItemID);
     
-    USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-    Change->InventoryName = InventoryName;
-    Change->Type = ESimpleInventoryChangeType::COPY;
-    OnInventoryChangeEvent.Broadcast(Change);
+    Result = GetItemTotal(ItemID);
 }
 
 /**
- * Forces a broadcast of the inventory change event, useful for syncing or refreshing UIs
- * when no actual item change has occurred.
+ * Checks the running total of an item against a minimum count.
+ *
+ * @param ItemID  The ID of the item.
+ * @param Count   The minimum quantity required.
+ * @param Result  True if the total count of the item is at least Count.
  */
-void USimpleInventory::ForceOnChange() const {
-    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::ForceOnChange"));
+void USimpleInventory::HasAtLeast(const int32 ItemID,
+                                  const int32 Count,
+                                  bool& Result) const {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::HasAtLeast || ItemID: %i | Count: %i"), ItemID, Count);
     
-    USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-    Change->InventoryName = InventoryName;
-    Change->Type = ESimpleInventoryChangeType::FORCE;
-    OnInventoryChangeEvent.Broadcast(Change);
+    Result = GetItemTotal(ItemID) >= Count;
 }
 
 /**
- * Forces the inventory array to resize to the maximum slot size.
- * This ensures the internal inventory slot array matches the configured capacity.
- * After resizing, it broadcasts an inventory change event of type FORCE
- * to notify listeners that the inventory structure has been forcibly updated.
+ * Sorts the slots by ID, struct type name or an item property.
+ * Every slot's key is read up front on the game thread; the sort itself only compares those values.
+ *
+ * @param Key  What to sort by, and in which direction.
  */
-void USimpleInventory::ForceResize() {
-    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::ForceResize"));
+void USimpleInventory::SortInventory(const FSimpleInventorySortKey& Key) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::SortInventory", STAT_SimpleInventory_SortInventory);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::SortInventory || Type: %s | Property: %s | Descending: %d"), *UEnum::GetValueAsString(Key.Type), *Key.PropertyName.ToString(), Key.bDescending);
     
-    InventorySlots.SetNum(MaxSlotSize);
+    // Struct types sort by name; rank them once so each slot only stores an integer.
+    TMap<const UScriptStruct*, int32> StructRanks;
+    if (Key.Type == ESimpleInventorySortKeyType::STRUCT_TYPE) {
+        TArray<const UScriptStruct*> Structs;
+        for (const FSimpleInventorySlot& Slot : InventorySlots) {
+            if (!Slot.IsEmpty()) {
+                Structs.AddUnique(Slot.GetItem().GetScriptStruct());
+            }
+        }
+        Algo::Sort(Structs, [](const UScriptStruct* A, const UScriptStruct* B) {
+            return GetNameSafe(A) < GetNameSafe(B);
+        });
+        for (int32 Rank = 0; Rank < Structs.Num(); ++Rank) {
+            StructRanks.Add(Structs[Rank], Rank);
+        }
+    }
+    
+    TMap<const UScriptStruct*, const FProperty*> PropertiesByStruct;
+    TArray<SimpleInventorySort::FSortValue> Values;
+    Values.SetNum(InventorySlots.Num());
+    for (int32 Index = 0; Index < InventorySlots.Num(); ++Index) {
+        const FSimpleInventorySlot& Slot = InventorySlots[Index];
+        SimpleInventorySort::FSortValue& Value = Values[Index];
+        if (Slot.IsEmpty()) {
+            Value.Group = 2;
+            continue;
+        }
+        
+        switch (Key.Type) {
+            case ESimpleInventorySortKeyType::ID:
+                Value.IntValue = Slot.ItemID;
+                break;
+            case ESimpleInventorySortKeyType::STRUCT_TYPE:
+                Value.IntValue = StructRanks.FindRef(Slot.GetItem().GetScriptStruct());
+                break;
+            case ESimpleInventorySortKeyType::PROPERTY: {
+                const FConstStructView SlotItem = Slot.GetItem();
+                const UScriptStruct* SlotStruct = SlotItem.GetScriptStruct();
+                const FProperty** Property = PropertiesByStruct.Find(SlotStruct);
+                if (!Property) {
+                    Property = &PropertiesByStruct.Add(SlotStruct, SlotStruct ? SlotStruct->FindPropertyByName(Key.PropertyName) : nullptr);
+                }
+                SimpleInventorySort::ReadPropertyValue(*Property, SlotItem.GetMemory(), Value);
+                break;
+            }
+        }
+    }
     
-    USimpleInventoryChange* Change = NewObject<USimpleInventoryChange>();
-    Change->InventoryName = InventoryName;
-    Change->Type = ESimpleInventoryChangeType::FORCE;
-    OnInventoryChangeEvent.Broadcast(Change);
+    const bool bDescending = Key.bDescending;
+    ApplySortOrder([&Values, bDescending](const int32 A, const int32 B) {
+        const SimpleInventorySort::FSortValue& ValueA = Values[A];
+        const SimpleInventorySort::FSortValue& ValueB = Values[B];
+        if (ValueA.Group != ValueB.Group) {
+            return ValueA.Group < ValueB.Group;
+        }
+        if (ValueA.Group != 0) {
+            return false;
+        }
+        return bDescending ? SimpleInventorySort::ValueLess(ValueB, ValueA) : SimpleInventorySort::ValueLess(ValueA, ValueB);
+    });
 }
 
-// Protected Functions
-
-
-
-// Private Functions
+/**
+ * Sorts the slots with a custom comparison, keeping empty slots at the end.
+ *
+ * @param Less  Returns true if the first slot sorts before the second.
+ */
+void USimpleInventory::SortInventoryBy(TFunctionRef<bool(const FSimpleInventorySlot&, const FSimpleInventorySlot&)> Less) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::SortInventoryBy", STAT_SimpleInventory_SortInventory);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::SortInventoryBy"));
+    
+    ApplySortOrder([this, Less](const int32 A, const int32 B) {
+        const FSimpleInventorySlot& SlotA = InventorySlots[A];
+        const FSimpleInventorySlot& SlotB = InventorySlots[B];
+        if (SlotA.IsEmpty() || SlotB.IsEmpty()) {
+            return !SlotA.IsEmpty() && SlotB.IsEmpty();
+        }
+        return Less(SlotA, SlotB);
+    });
+}
 
-void USimpleInventory::AddItemToNewSlot(FInstancedStruct Item,
-                                        const int32 Count) {
-    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::AddItemToNewSlot || Creating new USimpleInventorySlot"));
+/**
+ * Walks the slots once, keeping the last open stack of each item ID in a map. A partial stack pours into the open
+ * stack of its ID; whatever does not fit is kept in a slot of its own and becomes the new open stack.
+ * Non-stackable slots are kept as they are and empty slots are dropped, then added back at the end if the inventory was padded.
+ *
+ * @param Result  The number of slots freed.
+ */
+void USimpleInventory::Consolidate(int32& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::Consolidate", STAT_SimpleInventory_Consolidate);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::Consolidate || Slots: %i"), InventorySlots.Num());
+    
+    struct FOpenStack
+    {
+        int32 Index = INDEX_NONE;
+        int32 StackSize = 0;
+    };
+    
+    const int32 NumSlots = InventorySlots.Num();
+    TArray<FSimpleInventorySlot> Consolidated;
+    Consolidated.Reserve(FMath::Max(NumSlots, MaxSlotSize));
+    TArray<int32> SourceIndices;
+    SourceIndices.Reserve(NumSlots);
+    TArray<bool> CountChanged;
+    CountChanged.Reserve(NumSlots);
+    TBitArray<> WasEmpty(false, NumSlots);
+    TMap<int32, FOpenStack> OpenStacks;
+    
+    for (int32 Index = 0; Index < NumSlots; ++Index) {
+        FSimpleInventorySlot& Slot = InventorySlots[Index];
+        if (Slot.IsEmpty()) {
+            WasEmpty[Index] = true;
+            continue;
+        }
+        
+        const FConstStructView SlotItem = Slot.GetItem();
+        const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(SlotItem.GetScriptStruct());
+        const bool bStackable = Accessor.HasStackInfo() && Accessor.IsStackable(SlotItem.GetMemory());
+        const int32 StackSize = bStackable ? Accessor.GetStackSize(SlotItem.GetMemory()) : 0;
+        const int32 ItemID = Slot.ItemID;
+        bool bPoured = false;
+        
+        if (bStackable) {
+            if (const FOpenStack* OpenStack = OpenStacks.Find(ItemID)) {
+                FSimpleInventorySlot& Target = Consolidated[OpenStack->Index];
+                const int32 ToMove = FMath::Min(Slot.Count, OpenStack->StackSize - Target.Count);
+                Target.Count += ToMove;
+                Slot.Count -= ToMove;
+                CountChanged[OpenStack->Index] = true;
+                bPoured = true;
+                if (Target.Count >= OpenStack->StackSize) {
+                    OpenStacks.Remove(ItemID);
+                }
+            }
+        }
+        
+        if (Slot.Count > 0) {
+            const int32 NewIndex = Consolidated.Add(MoveTemp(Slot));
+            SourceIndices.Add(Index);
+            CountChanged.Add(bPoured);
+            if (bStackable && Consolidated[NewIndex].Count < StackSize) {
+                OpenStacks.Add(ItemID, { NewIndex, StackSize });
+            }
+        }
+    }
+    
+    const int32 NumOccupied = NumSlots - WasEmpty.CountSetBits();
+    Result = NumOccupied - Consolidated.Num();
+    
+    TArray<int32> ChangedSlotIndices;
+    for (int32 Index = 0; Index < Consolidated.Num(); ++Index) {
+        if (SourceIndices[Index] != Index || CountChanged[Index]) {
+            ChangedSlotIndices.Add(Index);
+        }
+    }
+    const bool bPadded = NumOccupied < NumSlots;
+    for (int32 Index = Consolidated.Num(); Index < NumSlots; ++Index) {
+        if (!WasEmpty[Index]) {
+            ChangedSlotIndices.Add(Index);
+        }
+    }
+    
+    // Every slot was moved out above, so the consolidated array is put back even when nothing changed.
+    if (bPadded) {
+        Consolidated.SetNum(NumSlots);
+    }
+    InventorySlots = MoveTemp(Consolidated);
+    if (ChangedSlotIndices.IsEmpty()) {
+        UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::Consolidate || Already consolidated"));
+        return;
+    }
     
-    USimpleInventorySlot *slot = NewObject<USimpleInventorySlot>();
-    slot->Item = Item;
-    slot->Count = Count;
-    InventorySlots.Emplace(slot);
+    // Views follow their slots, so widgets holding one keep showing the same item.
+    if (!SlotViews.IsEmpty()) {
+        TArray<TObjectPtr<USimpleInventorySlot>> ConsolidatedViews;
+        ConsolidatedViews.SetNum(SourceIndices.Num());
+        for (int32 Index = 0; Index < SourceIndices.Num(); ++Index) {
+            if (SlotViews.IsValidIndex(SourceIndices[Index])) {
+                ConsolidatedViews[Index] = SlotViews[SourceIndices[Index]];
+            }
+        }
+        SlotViews = MoveTemp(ConsolidatedViews);
+    }
+    RebuildSlotIndex();
+    
+    UE_LOG(SimpleInventoryLog, Log, TEXT("USimpleInventory::Consolidate || Freed %d slots"), Result);
+    
+    // Totals are unchanged, so the change carries no item deltas.
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::BATCH;
+    Change.SlotIndices = MoveTemp(ChangedSlotIndices);
+    NotifyChange(Change);
+}
+
+/**
+ * Moves items from a single slot into another inventory, as a transfer of one entry.
+ *
+ * @param SlotIndex  The slot to move items out of.
+ * @param Target     The inventory to move them into.
+ * @param Count      How many items to move.
+ * @param Result     True if the items were moved, false if nothing changed.
+ */
+void USimpleInventory::TransferItems(const int32 SlotIndex,
+                                     USimpleInventory* Target,
+                                     const int32 Count,
+                                     bool& Result) {
+    FSimpleInventoryTransferEntry Entry;
+    Entry.SlotIndex = SlotIndex;
+    Entry.Count = Count;
+    TransferItemsBatch({ Entry }, Target, Result);
+}
+
+/**
+ * Moves items from several slots into another inventory. Both inventories are write locked while the items move,
+ * and both changes are recorded before either is broadcast, so listeners of either side never see half a transfer.
+ * The locks are released before broadcasting, since a listener of one inventory may read the other.
+ *
+ * @param Entries  The slots, as indexed before the transfer, and how many items to move out of each.
+ * @param Target   The inventory to move them into.
+ * @param Result   True if every entry was moved, false if nothing changed.
+ */
+void USimpleInventory::TransferItemsBatch(const TArray<FSimpleInventoryTransferEntry>& Entries,
+                                          USimpleInventory* Target,
+                                          bool& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::TransferItems", STAT_SimpleInventory_TransferItems);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::TransferItems || Entries: %i"), Entries.Num());
+    
+    Result = false;
+    if (!IsValid(Target) || Target == this) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::TransferItems || Invalid target inventory"));
+        return;
+    }
+    
+    FSimpleInventoryChange SourceChange;
+    FSimpleInventoryChange TargetChange;
+    {
+        FSlotWriteScope WriteScope(this);
+        FSlotWriteScope TargetWriteScope(Target);
+        if (!ApplyTransfer(Entries, *Target, SourceChange, TargetChange)) {
+            return;
+        }
+        RecordChange(SourceChange);
+        Target->RecordChange(TargetChange);
+    }
+    
+    DispatchChange(SourceChange);
+    Target->DispatchChange(TargetChange);
+    Result = true;
+}
+
+/**
+ * Copies the slot indices listed under a struct type in the struct type index.
+ *
+ * @param StructType  The item struct type.
+ * @param Result      The indices of the matching slots, ascending.
+ */
+void USimpleInventory::GetSlotsOfType(const UScriptStruct* StructType,
+                                      TArray<int32>& Result) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::GetSlotsOfType");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::GetSlotsOfType || StructType: %s"), *GetNameSafe(StructType));
+    
+    const TArray<int32>* SlotIndices = SlotIndicesByStructType.Find(StructType);
+    if (SlotIndices) {
+        Result = *SlotIndices;
+    }
+    else {
+        Result.Reset();
+    }
+}
+
+/**
+ * Compiles a query and finds the slots whose items match it.
+ *
+ * @param Query   The struct type and property conditions to match.
+ * @param Result  The indices of the matching slots, ascending.
+ */
+void USimpleInventory::QueryItems(const FSimpleInventoryQuery& Query,
+                                  TArray<int32>& Result) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::QueryItems");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::QueryItems || Conditions: %i"), Query.Conditions.Num());
+    
+    const FSimpleInventoryCompiledQuery CompiledQuery(Query);
+    QueryItemsCompiled(CompiledQuery, Result);
+}
+
+/**
+ * Runs a compiled query. With a struct type filter only the slots listed under that type in the struct type index
+ * are tested; otherwise, or while a copy is pending, every occupied slot is.
+ *
+ * @param Query   The compiled query.
+ * @param Result  The indices of the matching slots, ascending.
+ */
+void USimpleInventory::QueryItemsCompiled(const FSimpleInventoryCompiledQuery& Query,
+                                          TArray<int32>& Result) const {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::QueryItemsCompiled", STAT_SimpleInventory_QueryItems);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::QueryItemsCompiled"));
+    
+    Result.Reset();
+    const UScriptStruct* StructType = Query.GetStructType();
+    if (StructType) {
+        if (const TArray<int32>* SlotIndices = SlotIndicesByStructType.Find(StructType)) {
+            for (const int32 Index : *SlotIndices) {
+                if (Query.Matches(GetSlotDataAt(Index).GetItem())) {
+                    Result.Add(Index);
+                }
+            }
+        }
+        return;
+    }
+    
+    // Without a struct type every slot is a candidate.
+    const int32 NumSlots = GetNumSlots();
+    for (int32 Index = 0; Index < NumSlots; ++Index) {
+        const FSimpleInventorySlot& Slot = GetSlotDataAt(Index);
+        if (!Slot.IsEmpty() && Query.Matches(Slot.GetItem())) {
+            Result.Add(Index);
+        }
+    }
+}
+
+/**
+ * Copies the inventory data from another inventory instance, copy-on-write. Only the other inventory's snapshot is
+ * taken here, which reuses its cached snapshot or every unchanged chunk of it. Snapshot chunks are never modified, so
+ * later changes to the other inventory do not reach the copy. Reads are served from the snapshot; this inventory
+ * only copies its slots out of it the first time they are changed.
+ *
+ * @param OtherInventory  The inventory to copy from.
+ */
+void USimpleInventory::CopyInventory(const USimpleInventory* OtherInventory) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::CopyInventory", STAT_SimpleInventory_CopyInventory);
+    FSlotWriteScope WriteScope(this, false);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::CopyInventory"));
+    
+    // The net change follows from the running totals of both inventories, so no slots are scanned.
+    TMap<int32, int32> ItemDeltas;
+    for (const auto& Total : ItemTotals) {
+        ItemDeltas.Add(Total.Key, -Total.Value);
+    }
+    for (const auto& Total : OtherInventory->ItemTotals) {
+        ItemDeltas.FindOrAdd(Total.Key) += Total.Value;
+    }
+    
+    MaxSlotSize = OtherInventory->MaxSlotSize;
+    PendingCopy = OtherInventory->GetSnapshot();
+    InventorySlots.Empty();
+    SlotViews.Empty();
+    // The other inventory's indices describe the slots of its snapshot, so lookups keep using them until the copy is applied.
+    SlotIndicesByItemID = OtherInventory->SlotIndicesByItemID;
+    SlotIndicesByStructType = OtherInventory->SlotIndicesByStructType;
+    
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::COPY;
+    Change.SetItemDeltas(ItemDeltas);
+    NotifyChange(Change);
+}
+
+/**
+ * Forces a broadcast of the inventory change event, useful for syncing or refreshing UIs
+ * when no actual item change has occurred.
+ */
+void USimpleInventory::ForceOnChange() const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::ForceOnChange");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::ForceOnChange"));
+    
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::FORCE;
+    BroadcastChange(Change);
+}
+
+/**
+ * Forces the inventory array to resize to the maximum slot size.
+ * This ensures the internal inventory slot array matches the configured capacity.
+ * After resizing, it broadcasts an inventory change event of type FORCE
+ * to notify listeners that the inventory structure has been forcibly updated.
+ */
+void USimpleInventory::ForceResize() {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::ForceResize");
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::ForceResize"));
+    
+    const bool bShrinking = InventorySlots.Num() > MaxSlotSize;
+    TMap<int32, int32> ItemDeltas;
+    if (bShrinking) {
+        AccumulateItemTotals(ItemDeltas, -1);
+    }
+    
+    InventorySlots.SetNum(MaxSlotSize);
+    if (bShrinking) {
+        SlotViews.SetNum(FMath::Min(SlotViews.Num(), MaxSlotSize));
+        RebuildSlotIndex();
+        AccumulateItemTotals(ItemDeltas, 1);
+    }
+    
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::FORCE;
+    Change.SetItemDeltas(ItemDeltas);
+    NotifyChange(Change);
+}
+
+/**
+ * Opens a batch. Changes made until the matching EndBatch are merged into one BATCH change.
+ */
+void USimpleInventory::BeginBatch() {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::BeginBatch");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::BeginBatch || Depth: %i"), BatchDepth);
+    
+    ++BatchDepth;
+}
+
+/**
+ * Closes a batch. When the outermost batch closes, the merged change is broadcast
+ * with the touched slot indices (ascending) and the net change of every item.
+ * Slot indices are reported against the slots as they are after the batch: once slots have moved (a slot was removed,
+ * the slots were replaced or sorted), every slot from the first moved one on is reported. FULL changes are
+ * broadcast as they were after the merged change, and a batch with only FULL changes broadcasts no BATCH.
+ */
+void USimpleInventory::EndBatch() {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::EndBatch");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::EndBatch || Depth: %i"), BatchDepth);
+    
+    if (BatchDepth <= 0) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::EndBatch || EndBatch called without BeginBatch"));
+        return;
+    }
+    
+    if (--BatchDepth > 0) {
+        return;
+    }
+    
+    TArray<FSimpleInventoryChange> FullChanges = MoveTemp(PendingBatchFullChanges);
+    PendingBatchFullChanges.Reset();
+    
+    if (bBatchHasChanges) {
+        const int32 NumSlots = GetNumSlots();
+        const int32 FirstShiftedSlot = FMath::Min(PendingBatchFirstShiftedSlot, NumSlots);
+        
+        FSimpleInventoryChange Change;
+        Change.InventoryName = InventoryName;
+        Change.Type = ESimpleInventoryChangeType::BATCH;
+        for (const int32 SlotIndex : PendingBatchSlotIndices) {
+            if (SlotIndex < FirstShiftedSlot) {
+                Change.SlotIndices.Add(SlotIndex);
+            }
+        }
+        for (int32 SlotIndex = FirstShiftedSlot; SlotIndex < NumSlots; ++SlotIndex) {
+            Change.SlotIndices.Add(SlotIndex);
+        }
+        Change.SlotIndices.Sort();
+        Change.SetItemDeltas(PendingBatchItemDeltas);
+        
+        bBatchHasChanges = false;
+        PendingBatchSlotIndices.Reset();
+        PendingBatchFirstShiftedSlot = MAX_int32;
+        PendingBatchItemDeltas.Reset();
+        
+        BroadcastChange(Change);
+    }
+    
+    for (const FSimpleInventoryChange& FullChange : FullChanges) {
+        BroadcastChange(FullChange);
+    }
+}
+
+/**
+ * Returns whether a batch is currently open.
+ *
+ * @return  True if BeginBatch has been called more times than EndBatch.
+ */
+bool USimpleInventory::IsBatching() const {
+    return BatchDepth > 0;
+}
+
+/**
+ * Returns the generation counter, incremented by every slot change.
+ *
+ * @return  The current generation.
+ */
+uint64 USimpleInventory::GetGeneration() const {
+    return Generation;
+}
+
+/**
+ * Replaces every slot at once and rebuilds the item ID index.
+ *
+ * @param Slots               The new slots.
+ * @param ChangedSlotIndices  The slots that differ from the previous contents.
+ */
+void USimpleInventory::ReplaceSlots(TArray<FSimpleInventorySlot>&& Slots,
+                                    const TArray<int32>& ChangedSlotIndices) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::ReplaceSlots", STAT_SimpleInventory_ReplaceSlots);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::ReplaceSlots || Slots: %i | Changed: %i"), Slots.Num(), ChangedSlotIndices.Num());
+    
+    TMap<int32, int32> ItemDeltas;
+    AccumulateItemTotals(ItemDeltas, -1);
+    
+    InventorySlots = MoveTemp(Slots);
+    SlotViews.SetNum(FMath::Min(SlotViews.Num(), InventorySlots.Num()));
+    RebuildSlotIndex();
+    
+    AccumulateItemTotals(ItemDeltas, 1);
+    
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::BATCH;
+    Change.SlotIndices = ChangedSlotIndices;
+    Change.SetItemDeltas(ItemDeltas);
+    NotifyChange(Change);
+}
+
+/**
+ * Returns the cached snapshot if the generation has not moved since it was taken. Otherwise builds a new one,
+ * reusing every chunk of the cached snapshot that is not marked dirty and still has the same number of slots.
+ *
+ * @return  The snapshot for the current generation.
+ */
+FSimpleInventorySnapshot USimpleInventory::GetSnapshot() const {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::GetSnapshot", STAT_SimpleInventory_GetSnapshot);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::GetSnapshot"));
+    checkSlow(IsInGameThread());
+    
+    if (CachedSnapshot.IsValid() && CachedSnapshot.GetGeneration() == Generation) {
+        return CachedSnapshot;
+    }
+    
+    // A pending copy already is a snapshot of the slots; it only needs this inventory's generation.
+    if (PendingCopy.IsValid()) {
+        TSharedRef<FSimpleInventorySnapshot::FData, ESPMode::ThreadSafe> Data = MakeShared<FSimpleInventorySnapshot::FData, ESPMode::ThreadSafe>(*PendingCopy.Data);
+        Data->Generation = Generation;
+        CachedSnapshot.Data = Data;
+        DirtySnapshotChunks.Reset();
+        FirstDirtySnapshotChunk = MAX_int32;
+        return CachedSnapshot;
+    }
+    
+    constexpr int32 ChunkSize = FSimpleInventorySnapshot::ChunkSize;
+    const int32 NumSlots = InventorySlots.Num();
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumSlots, ChunkSize);
+    const FSimpleInventorySnapshot::FData* Previous = CachedSnapshot.Data.Get();
+    TSharedPtr<const FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe> Definitions;
+    
+    TSharedRef<FSimpleInventorySnapshot::FData, ESPMode::ThreadSafe> Data = MakeShared<FSimpleInventorySnapshot::FData, ESPMode::ThreadSafe>();
+    Data->NumSlots = NumSlots;
+    Data->Generation = Generation;
+    Data->Chunks.Reserve(NumChunks);
+    
+    for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex) {
+        const int32 FirstSlot = ChunkIndex * ChunkSize;
+        const int32 ChunkLength = FMath::Min(ChunkSize, NumSlots - FirstSlot);
+        
+        if (Previous
+            && ChunkIndex < FirstDirtySnapshotChunk
+            && Previous->Chunks.IsValidIndex(ChunkIndex)
+            && Previous->Chunks[ChunkIndex]->Slots.Num() == ChunkLength
+            && !DirtySnapshotChunks.Contains(ChunkIndex)) {
+            Data->Chunks.Add(Previous->Chunks[ChunkIndex]);
+            continue;
+        }
+        
+        TSharedRef<FSimpleInventorySnapshotChunk, ESPMode::ThreadSafe> Chunk = MakeShared<FSimpleInventorySnapshotChunk, ESPMode::ThreadSafe>();
+        Chunk->Slots.Append(InventorySlots.GetData() + FirstSlot, ChunkLength);
+        
+        // Slots using a definition capture the one they resolve to now, and the chunk keeps it alive.
+        for (FSimpleInventorySlot& Slot : Chunk->Slots) {
+            if (!Slot.bUsesDefinition || Slot.Item.IsValid()) {
+                continue;
+            }
+            if (!Definitions.IsValid()) {
+                Definitions = FSimpleInventoryItemRegistry::GetDefinitions();
+            }
+            Slot.CapturedDefinition = Definitions.IsValid() ? Definitions->Find(Slot.ItemID) : FConstStructView();
+            Chunk->Definitions = Definitions;
+        }
+        Data->Chunks.Add(Chunk);
+    }
+    
+    CachedSnapshot.Data = Data;
+    DirtySnapshotChunks.Reset();
+    FirstDirtySnapshotChunk = MAX_int32;
+    return CachedSnapshot;
+}
+
+/**
+ * Checks the first slot holding an item for an exact count, taking the read lock off the game thread.
+ *
+ * @param ItemID  The ID of the item to search for.
+ * @param Count   The exact quantity required.
+ * @return        True if the item exists with the specified count.
+ */
+bool USimpleInventory::HasItemThreadSafe(const int32 ItemID,
+                                         const int32 Count) const {
+    bool bResult = false;
+    ReadThreadSafe([this, ItemID, Count, &bResult]() {
+        const int32 SlotIndex = FindFirstSlotIndex(ItemID);
+        bResult = SlotIndex != INDEX_NONE && GetSlotDataAt(SlotIndex).Count == Count;
+    });
+    return bResult;
+}
+
+/**
+ * Sums an item's count across all slots, taking the read lock off the game thread.
+ *
+ * @param ItemID  The ID of the item.
+ * @return        The total count.
+ */
+int32 USimpleInventory::GetItemCountThreadSafe(const int32 ItemID) const {
+    int32 Total = 0;
+    ReadThreadSafe([this, ItemID, &Total]() {
+        Total = GetItemTotal(ItemID);
+    });
+    return Total;
+}
+
+/**
+ * Gets the number of slots, taking the read lock off the game thread.
+ *
+ * @return  The number of slots.
+ */
+int32 USimpleInventory::GetLengthThreadSafe() const {
+    int32 Length = 0;
+    ReadThreadSafe([this, &Length]() {
+        Length = GetNumSlots();
+    });
+    return Length;
+}
+
+/**
+ * Copies a slot, taking the read lock off the game thread.
+ *
+ * @param Index    The index of the slot.
+ * @param OutSlot  The copied slot.
+ * @return         False if the index is invalid.
+ */
+bool USimpleInventory::GetSlotThreadSafe(const int32 Index,
+                                         FSimpleInventorySlot& OutSlot) const {
+    bool bValid = false;
+    ReadThreadSafe([this, Index, &OutSlot, &bValid]() {
+        bValid = Index >= 0 && Index < GetNumSlots();
+        if (bValid) {
+            OutSlot = GetSlotDataAt(Index);
+        }
+    });
+    return bValid;
+}
+
+/**
+ * Calls Reader with the slots in place, through ReadThreadSafe. A pending copy is only applied by the next change,
+ * so until then its snapshot's chunks are handed out one at a time instead of being flattened per call.
+ *
+ * @param Reader  Called in slot order with each run of slots and the index of its first slot.
+ */
+void USimpleInventory::ReadSlotsThreadSafe(TFunctionRef<void(TConstArrayView<FSimpleInventorySlot> Slots, const int32 FirstIndex)> Reader) const {
+    ReadThreadSafe([this, Reader]() {
+        if (PendingCopy.IsValid()) {
+            PendingCopy.ForEachChunk(Reader);
+        }
+        else {
+            Reader(InventorySlots, 0);
+        }
+    });
+}
+
+/**
+ * Replaces every slot with restored slots, keeping their layout.
+ * Broadcasts a change event of type LOAD.
+ *
+ * @param Slots  The restored slots.
+ */
+void USimpleInventory::RestoreSlots(TArray<FSimpleInventorySlot>&& Slots) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::RestoreSlots", STAT_SimpleInventory_RestoreSlots);
+    FSlotWriteScope WriteScope(this);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::RestoreSlots || Slots: %i"), Slots.Num());
+    
+    TMap<int32, int32> ItemDeltas;
+    AccumulateItemTotals(ItemDeltas, -1);
+    
+    InventorySlots = MoveTemp(Slots);
+    SlotViews.Empty();
+    RebuildSlotIndex();
+    
+    AccumulateItemTotals(ItemDeltas, 1);
+    
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::LOAD;
+    Change.Count = InventorySlots.Num();
+    Change.SetItemDeltas(ItemDeltas);
+    NotifyChange(Change);
+}
+
+/**
+ * Copies the registered definition into every slot that references one of the given items.
+ * Advances the generation so snapshots and saved storage pick up the copies.
+ *
+ * @param ItemIDs  The items whose definitions are about to be removed.
+ */
+void USimpleInventory::DetachDefinitions(const TSet<int32>& ItemIDs) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::DetachDefinitions");
+    FSlotWriteScope WriteScope(this);
+    
+    int32 NumDetached = 0;
+    for (int32 Index = 0; Index < InventorySlots.Num(); ++Index) {
+        FSimpleInventorySlot& Slot = InventorySlots[Index];
+        if (!Slot.bUsesDefinition || !ItemIDs.Contains(Slot.ItemID)) {
+            continue;
+        }
+        
+        const FConstStructView Definition = Slot.GetItem();
+        Slot.Item.InitializeAs(Definition.GetScriptStruct(), Definition.GetMemory());
+        Slot.bUsesDefinition = false;
+        MarkSnapshotSlotChanged(Index);
+        ++NumDetached;
+    }
+    
+    if (NumDetached > 0) {
+        ++Generation;
+        UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::DetachDefinitions || Copied definitions into %d slots"), NumDetached);
+    }
+}
+
+// Protected Functions
+
+
+
+// Private Functions
+
+/**
+ * Adds an already validated item: fills existing stacks of the same ID, then creates a new slot for the rest.
+ * Broadcasts a FULL change if not everything fit.
+ *
+ * @param Item          The item to add.
+ * @param ItemAccessor  The accessor for Item's struct type.
+ * @param ItemID        The ID read from Item.
+ * @param Count         The number of items to add.
+ * @return              The number of items that could not be added.
+ */
+int32 USimpleInventory::AddResolvedItem(const FConstStructView Item,
+                                        const FSimpleInventoryItemAccessor& ItemAccessor,
+                                        const int32 ItemID,
+                                        const int32 Count) {
+    int32 Remaining = Count;
+    
+    // --- Pass 1: Fill existing stacks ---
+    const TArray<int32>* ExistingSlotIndices = SlotIndicesByItemID.Find(ItemID);
+    const int32 NumExistingSlots = ExistingSlotIndices ? ExistingSlotIndices->Num() : 0;
+    for (int32 i = 0; i < NumExistingSlots; ++i) {
+        FSimpleInventorySlot& iSlot = InventorySlots[(*ExistingSlotIndices)[i]];
+        if (iSlot.IsEmpty() || Remaining <= 0) {
+            continue;
+        }
+        
+        const FConstStructView SlotItem = iSlot.GetItem();
+        const UScriptStruct* SlotStruct = SlotItem.GetScriptStruct();
+        const void* SlotMemory = SlotItem.GetMemory();
+        if (!SlotStruct || !SlotMemory) {
+            continue;
+        }
+        
+        const FSimpleInventoryItemAccessor SlotAccessor = SlotStruct == Item.GetScriptStruct() ? ItemAccessor : FSimpleInventoryItemAccessorCache::Get(SlotStruct);
+        if (!SlotAccessor.IsValid() || !SlotAccessor.HasStackInfo()) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItem || Slot missing expected properties"));
+            continue;
+        }
+        
+        if (SlotAccessor.IsStackable(SlotMemory)) {
+            const int32 MaxStackSize = SlotAccessor.GetStackSize(SlotMemory);
+            int32 SpaceLeft = MaxStackSize - iSlot.Count;
+            if (SpaceLeft > 0) {
+                int32 ToAdd = FMath::Min(SpaceLeft, Remaining);
+                iSlot.Count += ToAdd;
+                Remaining -= ToAdd;
+                
+                FSimpleInventoryChange Change;
+                Change.InventoryName = InventoryName;
+                Change.Type = ESimpleInventoryChangeType::ADDITION;
+                Change.Item = Item;
+                Change.ItemID = ItemID;
+                Change.Count = ToAdd;
+                Change.Delta = ToAdd;
+                Change.SlotIndex = (*ExistingSlotIndices)[i];
+                NotifyChange(Change);
+                
+                UE_LOG(SimpleInventoryLog, Log, TEXT("USimpleInventory::AddItem || Added %d items to existing stack"), ToAdd);
+            }
+        }
+    }
+    
+    // --- Pass 2: Create new stacks ---
+    while (Remaining > 0 && InventorySlots.Num() < MaxSlotSize) {
+        const int32 ToAdd = Remaining;
+        
+        AddItemToNewSlot(Item, ItemID, ToAdd);
+        
+        FSimpleInventoryChange Change;
+        Change.InventoryName = InventoryName;
+        Change.Type = ESimpleInventoryChangeType::ADDITION;
+        Change.Item = Item;
+        Change.ItemID = ItemID;
+        Change.Count = ToAdd;
+        Change.Delta = ToAdd;
+        Change.SlotIndex = InventorySlots.Num() - 1;
+        NotifyChange(Change);
+        
+        UE_LOG(SimpleInventoryLog, Log, TEXT("USimpleInventory::AddItem || Added %d items to new slot"), ToAdd);
+        
+        Remaining -= ToAdd;
+    }
+    
+    if (Remaining > 0) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::AddItem || Inventory full, %d items could not be added"), Remaining);
+        
+        FSimpleInventoryChange Change;
+        Change.InventoryName = InventoryName;
+        Change.Type = ESimpleInventoryChangeType::FULL;
+        Change.ItemID = ItemID;
+        NotifyChange(Change);
+    }
+    
+    return Remaining;
+}
+
+/**
+ * Removes up to Count of an item, starting from the last slot that holds it.
+ * Emptied slots are removed. Removing from the back keeps index shifting to a minimum.
+ *
+ * @param ItemID  The item to remove.
+ * @param Count   The amount to remove.
+ * @return        The amount actually removed.
+ */
+int32 USimpleInventory::RemoveItemCount(const int32 ItemID,
+                                        const int32 Count) {
+    int32 Removed = 0;
+    while (Removed < Count) {
+        const TArray<int32>* SlotIndices = SlotIndicesByItemID.Find(ItemID);
+        if (!SlotIndices || SlotIndices->IsEmpty()) {
+            break;
+        }
+        
+        const int32 Index = SlotIndices->Last();
+        FSimpleInventorySlot& Slot = InventorySlots[Index];
+        const int32 ToRemove = FMath::Min(Count - Removed, Slot.Count);
+        Slot.Count -= ToRemove;
+        Removed += ToRemove;
+        
+        FSimpleInventoryChange Change;
+        Change.InventoryName = InventoryName;
+        Change.Type = ESimpleInventoryChangeType::REMOVAL;
+        Change.ItemID = ItemID;
+        Change.Count = FMath::Max(0, Slot.Count);
+        Change.Delta = -ToRemove;
+        Change.SlotIndex = Index;
+        
+        if (Slot.Count <= 0) {
+            const FSimpleInventorySlot RemovedSlot = RemoveSlotAt(Index);
+            Change.Item = RemovedSlot.GetItem();
+            NotifyChange(Change);
+        }
+        else {
+            Change.Item = Slot.GetItem();
+            NotifyChange(Change);
+        }
+    }
+    return Removed;
+}
+
+/**
+ * Sums the remaining stack space across all stackable slots holding an item.
+ *
+ * @param ItemID  The item.
+ * @return        How many more of the item fit into existing stacks.
+ */
+int32 USimpleInventory::GetFreeStackSpace(const int32 ItemID) const {
+    const TArray<int32>* SlotIndices = SlotIndicesByItemID.Find(ItemID);
+    if (!SlotIndices) {
+        return 0;
+    }
+    
+    int32 FreeSpace = 0;
+    for (const int32 Index : *SlotIndices) {
+        const FSimpleInventorySlot& Slot = InventorySlots[Index];
+        const FConstStructView SlotItem = Slot.GetItem();
+        const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(SlotItem.GetScriptStruct());
+        if (Accessor.HasStackInfo() && Accessor.IsStackable(SlotItem.GetMemory())) {
+            FreeSpace += FMath::Max(0, Accessor.GetStackSize(SlotItem.GetMemory()) - Slot.Count);
+        }
+    }
+    return FreeSpace;
+}
+
+/**
+ * Returns the running total of an item across all slots.
+ *
+ * @param ItemID  The item.
+ * @return        The total amount held.
+ */
+int32 USimpleInventory::GetItemTotal(const int32 ItemID) const {
+    return ItemTotals.FindRef(ItemID);
+}
+
+/**
+ * Computes the stable sort order of the slots, moves them into it and reports a single REORDER change.
+ * Nothing is reported if no slot moved.
+ *
+ * @param Less  Compares two slot indices of the current layout. May be called from worker threads.
+ */
+void USimpleInventory::ApplySortOrder(TFunctionRef<bool(const int32, const int32)> Less) {
+    const int32 NumSlots = InventorySlots.Num();
+    TArray<int32> Order;
+    Order.SetNumUninitialized(NumSlots);
+    for (int32 Index = 0; Index < NumSlots; ++Index) {
+        Order[Index] = Index;
+    }
+    FSimpleInventoryParallelSort::StableSort(Order, Less);
+    
+    TArray<int32> MovedSlotIndices;
+    for (int32 Index = 0; Index < NumSlots; ++Index) {
+        if (Order[Index] != Index) {
+            MovedSlotIndices.Add(Index);
+        }
+    }
+    if (MovedSlotIndices.IsEmpty()) {
+        UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::ApplySortOrder || Already sorted"));
+        return;
+    }
+    
+    TArray<FSimpleInventorySlot> SortedSlots;
+    SortedSlots.Reserve(FMath::Max(NumSlots, MaxSlotSize));
+    for (const int32 PreviousIndex : Order) {
+        SortedSlots.Add(MoveTemp(InventorySlots[PreviousIndex]));
+    }
+    InventorySlots = MoveTemp(SortedSlots);
+    
+    // Views follow their slots, so widgets holding one keep showing the same item.
+    if (!SlotViews.IsEmpty()) {
+        TArray<TObjectPtr<USimpleInventorySlot>> SortedViews;
+        SortedViews.SetNum(NumSlots);
+        for (int32 Index = 0; Index < NumSlots; ++Index) {
+            if (SlotViews.IsValidIndex(Order[Index])) {
+                SortedViews[Index] = SlotViews[Order[Index]];
+            }
+        }
+        SlotViews = MoveTemp(SortedViews);
+    }
+    RebuildSlotIndex();
+    
+    FSimpleInventoryChange Change;
+    Change.InventoryName = InventoryName;
+    Change.Type = ESimpleInventoryChangeType::REORDER;
+    Change.SlotIndices = MoveTemp(MovedSlotIndices);
+    Change.Permutation = MoveTemp(Order);
+    NotifyChange(Change);
+}
+
+/**
+ * Validates a transfer, applies it to both inventories and fills in the change each of them reports.
+ * Placement in Target is planned before anything changes, as AddResolvedItem would place the items: stacks of the
+ * same ID first, including stacks opened by earlier entries, then one new slot per entry. Nothing changes unless every entry fits.
+ *
+ * @param Entries       The slots and amounts to move.
+ * @param Target        The inventory to move them into. The caller holds its write lock.
+ * @param SourceChange  Filled with the TRANSFER change this inventory reports.
+ * @param TargetChange  Filled with the TRANSFER change Target reports.
+ * @return              True if the transfer was applied.
+ */
+bool USimpleInventory::ApplyTransfer(const TArray<FSimpleInventoryTransferEntry>& Entries,
+                                     USimpleInventory& Target,
+                                     FSimpleInventoryChange& SourceChange,
+                                     FSimpleInventoryChange& TargetChange) {
+    if (Entries.IsEmpty()) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::TransferItems || No entries"));
+        return false;
+    }
+    
+    // --- Validate: every entry takes a positive amount from an occupied slot holding enough ---
+    TMap<int32, int32> TakenBySlot;
+    for (const FSimpleInventoryTransferEntry& Entry : Entries) {
+        if (!InventorySlots.IsValidIndex(Entry.SlotIndex) || InventorySlots[Entry.SlotIndex].IsEmpty() || Entry.Count <= 0) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::TransferItems || Invalid entry | Index: %i | Count: %i"), Entry.SlotIndex, Entry.Count);
+            return false;
+        }
+        
+        int32& Taken = TakenBySlot.FindOrAdd(Entry.SlotIndex);
+        Taken += Entry.Count;
+        if (Taken > InventorySlots[Entry.SlotIndex].Count) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::TransferItems || Slot %i holds fewer than %i items"), Entry.SlotIndex, Taken);
+            return false;
+        }
+    }
+    
+    // --- Plan: place every entry in Target without changing it ---
+    struct FPlacement
+    {
+        int32 EntryIndex = INDEX_NONE;
+        int32 TargetIndex = INDEX_NONE;
+        int32 Count = 0;
+    };
+    
+    TArray<FPlacement> Placements;
+    TMap<int32, int32> StackSpaceBySlot;
+    TMap<int32, TArray<int32>> NewSlotsByItemID;
+    const int32 FirstNewIndex = Target.InventorySlots.Num();
+    int32 NumNewSlots = 0;
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex) {
+        const FSimpleInventorySlot& Slot = InventorySlots[Entries[EntryIndex].SlotIndex];
+        const FConstStructView SlotItem = Slot.GetItem();
+        const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(SlotItem.GetScriptStruct());
+        const bool bStackable = Accessor.HasStackInfo() && Accessor.IsStackable(SlotItem.GetMemory());
+        int32 Remaining = Entries[EntryIndex].Count;
+        
+        auto FillStacks = [&](const TArray<int32>& TargetIndices) {
+            for (const int32 TargetIndex : TargetIndices) {
+                if (Remaining <= 0) {
+                    return;
+                }
+                
+                int32* StackSpace = StackSpaceBySlot.Find(TargetIndex);
+                if (!StackSpace) {
+                    const FSimpleInventorySlot& TargetSlot = Target.InventorySlots[TargetIndex];
+                    const FConstStructView TargetItem = TargetSlot.GetItem();
+                    const FSimpleInventoryItemAccessor TargetAccessor = FSimpleInventoryItemAccessorCache::Get(TargetItem.GetScriptStruct());
+                    const bool bTargetStackable = TargetAccessor.HasStackInfo() && TargetAccessor.IsStackable(TargetItem.GetMemory());
+                    StackSpace = &StackSpaceBySlot.Add(TargetIndex, bTargetStackable ? FMath::Max(0, TargetAccessor.GetStackSize(TargetItem.GetMemory()) - TargetSlot.Count) : 0);
+                }
+                
+                const int32 ToPlace = FMath::Min(*StackSpace, Remaining);
+                if (ToPlace > 0) {
+                    *StackSpace -= ToPlace;
+                    Remaining -= ToPlace;
+                    Placements.Add({ EntryIndex, TargetIndex, ToPlace });
+                }
+            }
+        };
+        
+        if (bStackable) {
+            if (const TArray<int32>* ExistingSlotIndices = Target.SlotIndicesByItemID.Find(Slot.ItemID)) {
+                FillStacks(*ExistingSlotIndices);
+            }
+            if (const TArray<int32>* PlannedSlotIndices = NewSlotsByItemID.Find(Slot.ItemID)) {
+                FillStacks(*PlannedSlotIndices);
+            }
+        }
+        
+        if (Remaining > 0) {
+            if (FirstNewIndex + NumNewSlots >= Target.MaxSlotSize) {
+                UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventory::TransferItems || Target inventory full, nothing moved"));
+                return false;
+            }
+            
+            const int32 TargetIndex = FirstNewIndex + NumNewSlots++;
+            Placements.Add({ EntryIndex, TargetIndex, Remaining });
+            if (bStackable) {
+                StackSpaceBySlot.Add(TargetIndex, FMath::Max(0, Accessor.GetStackSize(SlotItem.GetMemory()) - Remaining));
+                NewSlotsByItemID.FindOrAdd(Slot.ItemID).Add(TargetIndex);
+            }
+        }
+    }
+    
+    // --- Apply to Target, while every source slot still holds its item ---
+    TArray<FSimpleInventorySlot> NewSlots;
+    NewSlots.SetNum(NumNewSlots);
+    TMap<int32, int32> NewSlotBySource;
+    TMap<int32, int32> ItemDeltas;
+    TSet<int32> TargetSlotIndices;
+    int32 NumMoved = 0;
+    for (const FPlacement& Placement : Placements) {
+        const int32 SourceIndex = Entries[Placement.EntryIndex].SlotIndex;
+        const FSimpleInventorySlot& SourceSlot = InventorySlots[SourceIndex];
+        ItemDeltas.FindOrAdd(SourceSlot.ItemID) += Placement.Count;
+        TargetSlotIndices.Add(Placement.TargetIndex);
+        NumMoved += Placement.Count;
+        
+        if (Placement.TargetIndex < FirstNewIndex) {
+            Target.InventorySlots[Placement.TargetIndex].Count += Placement.Count;
+            continue;
+        }
+        
+        FSimpleInventorySlot& NewSlot = NewSlots[Placement.TargetIndex - FirstNewIndex];
+        if (NewSlot.Count == 0) {
+            NewSlot.ItemID = SourceSlot.ItemID;
+            // A slot the transfer empties hands its item over once it is removed below. Any other slot keeps its item, so it is copied.
+            if (TakenBySlot[SourceIndex] == SourceSlot.Count && !NewSlotBySource.Contains(SourceIndex)) {
+                NewSlotBySource.Add(SourceIndex, Placement.TargetIndex - FirstNewIndex);
+            }
+            else {
+                NewSlot.Item = SourceSlot.Item;
+                NewSlot.bUsesDefinition = SourceSlot.bUsesDefinition;
+            }
+        }
+        NewSlot.Count += Placement.Count;
+    }
+    
+    // --- Apply to this inventory, removing emptied slots from the back so the remaining entries keep their indices ---
+    TArray<int32> SourceSlotIndices;
+    TakenBySlot.GenerateKeyArray(SourceSlotIndices);
+    SourceSlotIndices.Sort(TGreater<int32>());
+    for (const int32 SourceIndex : SourceSlotIndices) {
+        FSimpleInventorySlot& SourceSlot = InventorySlots[SourceIndex];
+        SourceSlot.Count -= TakenBySlot[SourceIndex];
+        if (SourceSlot.Count > 0) {
+            continue;
+        }
+        
+        FSimpleInventorySlot RemovedSlot = RemoveSlotAt(SourceIndex);
+        if (const int32* NewSlotIndex = NewSlotBySource.Find(SourceIndex)) {
+            NewSlots[*NewSlotIndex].Item = MoveTemp(RemovedSlot.Item);
+            NewSlots[*NewSlotIndex].bUsesDefinition = RemovedSlot.bUsesDefinition;
+        }
+    }
+    
+    for (FSimpleInventorySlot& NewSlot : NewSlots) {
+        Target.IndexSlot(Target.InventorySlots.Add(MoveTemp(NewSlot)));
+    }
+    
+    UE_LOG(SimpleInventoryLog, Log, TEXT("USimpleInventory::TransferItems || Moved %d items to %s"), NumMoved, *Target.InventoryName.ToString());
+    
+    // Removal walked the source slots from the back; changes report indices in ascending order.
+    SourceSlotIndices.Sort();
+    
+    // Each side reports its own slots and the other side's, so either change describes the whole transfer.
+    // Totals move through the signed item deltas only; Count is the number of items moved.
+    TargetChange.InventoryName = Target.InventoryName;
+    TargetChange.Type = ESimpleInventoryChangeType::TRANSFER;
+    TargetChange.Count = NumMoved;
+    TargetChange.SlotIndices = TargetSlotIndices.Array();
+    TargetChange.SlotIndices.Sort();
+    TargetChange.SetItemDeltas(ItemDeltas);
+    TargetChange.TransferInventoryName = InventoryName;
+    TargetChange.TransferSlotIndices = SourceSlotIndices;
+    
+    SourceChange.InventoryName = InventoryName;
+    SourceChange.Type = ESimpleInventoryChangeType::TRANSFER;
+    SourceChange.Count = NumMoved;
+    SourceChange.SlotIndices = MoveTemp(SourceSlotIndices);
+    SourceChange.ItemDeltas = TargetChange.ItemDeltas;
+    for (FSimpleInventoryItemDelta& ItemDelta : SourceChange.ItemDeltas) {
+        ItemDelta.Delta = -ItemDelta.Delta;
+    }
+    SourceChange.TransferInventoryName = Target.InventoryName;
+    SourceChange.TransferSlotIndices = TargetChange.SlotIndices;
+    SourceChange.bIsTransferSource = true;
+    return true;
+}
+
+void USimpleInventory::AddItemToNewSlot(const FConstStructView Item,
+                                        const int32 ItemID,
+                                        const int32 Count) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::AddItemToNewSlot || Creating new FSimpleInventorySlot"));
+    
+    FSimpleInventorySlot& Slot = InventorySlots.AddDefaulted_GetRef();
+    // Items identical to their registered definition share it instead of keeping a copy per slot.
+    if (FSimpleInventoryItemRegistry::Matches(ItemID, Item)) {
+        Slot.bUsesDefinition = true;
+    }
+    else {
+        Slot.Item.InitializeAs(Item.GetScriptStruct(), Item.GetMemory());
+    }
+    Slot.ItemID = ItemID;
+    Slot.Count = Count;
+    IndexSlot(InventorySlots.Num() - 1);
+}
+
+/**
+ * Returns the `USimpleInventorySlot` view for a slot, creating it on first use and refreshing its values.
+ *
+ * @param Index  The slot index.
+ * @return       The view, or nullptr if the index is invalid or the slot is empty.
+ */
+USimpleInventorySlot* USimpleInventory::GetSlotView(const int32 Index) const {
+    const int32 NumSlots = GetNumSlots();
+    if (Index < 0 || Index >= NumSlots || GetSlotDataAt(Index).IsEmpty()) {
+        return nullptr;
+    }
+    
+    if (SlotViews.Num() < NumSlots) {
+        SlotViews.SetNum(NumSlots);
+    }
+    
+    TObjectPtr<USimpleInventorySlot>& View = SlotViews[Index];
+    if (!View) {
+        View = NewObject<USimpleInventorySlot>();
+    }
+    const FSimpleInventorySlot& Slot = GetSlotDataAt(Index);
+    const FConstStructView SlotItem = Slot.GetItem();
+    View->Item.InitializeAs(SlotItem.GetScriptStruct(), SlotItem.GetMemory());
+    View->Count = Slot.Count;
+    return View;
+}
+
+/**
+ * Finds the first slot holding an item. A pending copy has no slot indices yet, so its slots are searched.
+ *
+ * @param ItemID  The ID of the item.
+ * @return        The index of the first slot holding the item, or INDEX_NONE.
+ */
+int32 USimpleInventory::FindFirstSlotIndex(const int32 ItemID) const {
+    const TArray<int32>* SlotIndices = SlotIndicesByItemID.Find(ItemID);
+    return SlotIndices && !SlotIndices->IsEmpty() ? (*SlotIndices)[0] : INDEX_NONE;
+}
+
+/**
+ * Calls Reader while no change can happen: off the game thread under the read lock, on it directly.
+ * The game thread is the only writer, so it never needs the lock to read.
+ *
+ * @param Reader  Called once.
+ */
+void USimpleInventory::ReadThreadSafe(TFunctionRef<void()> Reader) const {
+    if (IsInGameThread()) {
+        Reader();
+        return;
+    }
+    
+    FReadScopeLock ReadLock(SlotLock);
+    Reader();
+}
+
+/**
+ * Adds the slot at Index to the item ID and struct type indices. Indices are kept sorted so the first entry is the lowest slot.
+ *
+ * @param Index  The slot index to add.
+ */
+void USimpleInventory::IndexSlot(const int32 Index) {
+    const FSimpleInventorySlot& Slot = InventorySlots[Index];
+    if (Slot.IsEmpty()) {
+        return;
+    }
+    
+    InsertSlotIndex(SlotIndicesByItemID.FindOrAdd(Slot.ItemID), Index);
+    for (const UStruct* Struct = Slot.GetItem().GetScriptStruct(); Struct; Struct = Struct->GetSuperStruct()) {
+        InsertSlotIndex(SlotIndicesByStructType.FindOrAdd(CastChecked<UScriptStruct>(Struct)), Index);
+    }
+}
+
+/**
+ * Removes the slot at Index from the item ID and struct type indices without touching other entries.
+ *
+ * @param Index  The slot index to remove.
+ */
+void USimpleInventory::UnindexSlot(const int32 Index) {
+    const FSimpleInventorySlot& Slot = InventorySlots[Index];
+    if (Slot.IsEmpty()) {
+        return;
+    }
+    
+    if (TArray<int32>* SlotIndices = SlotIndicesByItemID.Find(Slot.ItemID)) {
+        RemoveSlotIndex(*SlotIndices, Index);
+        if (SlotIndices->IsEmpty()) {
+            SlotIndicesByItemID.Remove(Slot.ItemID);
+        }
+    }
+    
+    for (const UStruct* Struct = Slot.GetItem().GetScriptStruct(); Struct; Struct = Struct->GetSuperStruct()) {
+        const UScriptStruct* ScriptStruct = CastChecked<UScriptStruct>(Struct);
+        if (TArray<int32>* SlotIndices = SlotIndicesByStructType.Find(ScriptStruct)) {
+            RemoveSlotIndex(*SlotIndices, Index);
+            if (SlotIndices->IsEmpty()) {
+                SlotIndicesByStructType.Remove(ScriptStruct);
+            }
+        }
+    }
+}
+
+/**
+ * Removes the slot at Index from InventorySlots and shifts every indexed slot after it down by one.
+ *
+ * @param Index  The slot index to remove.
+ * @return       The removed slot, moved out of the array.
+ */
+FSimpleInventorySlot USimpleInventory::RemoveSlotAt(const int32 Index) {
+    UnindexSlot(Index);
+    FSimpleInventorySlot RemovedSlot = MoveTemp(InventorySlots[Index]);
+    InventorySlots.RemoveAt(Index);
+    if (SlotViews.IsValidIndex(Index)) {
+        SlotViews.RemoveAt(Index);
+    }
+    
+    auto ShiftDown = [Index](TArray<int32>& SlotIndices) {
+        for (int32 Position = Algo::UpperBound(SlotIndices, Index); Position < SlotIndices.Num(); ++Position) {
+            --SlotIndices[Position];
+        }
+    };
+    for (auto& Entry : SlotIndicesByItemID) {
+        ShiftDown(Entry.Value);
+    }
+    for (auto& Entry : SlotIndicesByStructType) {
+        ShiftDown(Entry.Value);
+    }
+    MarkSnapshotSlotsShifted(Index);
+    if (BatchDepth > 0) {
+        PendingBatchFirstShiftedSlot = FMath::Min(PendingBatchFirstShiftedSlot, Index);
+    }
+    
+    return RemovedSlot;
+}
+
+/**
+ * Rebuilds the item ID and struct type indices from scratch.
+ * Used when InventorySlots is replaced or truncated wholesale.
+ */
+void USimpleInventory::RebuildSlotIndex() {
+    SlotIndicesByItemID.Reset();
+    SlotIndicesByStructType.Reset();
+    for (int32 Index = 0; Index < InventorySlots.Num(); ++Index) {
+        const FSimpleInventorySlot& Slot = InventorySlots[Index];
+        if (Slot.IsEmpty()) {
+            continue;
+        }
+        
+        SlotIndicesByItemID.FindOrAdd(Slot.ItemID).Add(Index);
+        for (const UStruct* Struct = Slot.GetItem().GetScriptStruct(); Struct; Struct = Struct->GetSuperStruct()) {
+            SlotIndicesByStructType.FindOrAdd(CastChecked<UScriptStruct>(Struct)).Add(Index);
+        }
+    }
+}
+
+/**
+ * Applies a pending copy before its slots are read on the game thread. The write scope applies it under the write lock.
+ */
+void USimpleInventory::ResolvePendingCopy() const {
+    if (PendingCopy.IsValid()) {
+        FSlotWriteScope WriteScope(this);
+    }
+}
+
+/**
+ * Copies the slots of a pending copy out of its snapshot. The slot indices were copied along with the snapshot and
+ * already match. The inventory's contents do not change, so nothing is broadcast and the generation stays the same.
+ * The caller holds the write lock.
+ */
+void USimpleInventory::ApplyPendingCopy() {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventory::ApplyPendingCopy");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventory::ApplyPendingCopy || Slots: %i"), PendingCopy.Num());
+    
+    PendingCopy.CopySlots(InventorySlots);
+    PendingCopy = FSimpleInventorySnapshot();
+    
+    // Live slots resolve definitions through the registry, which keeps their tables alive.
+    for (FSimpleInventorySlot& Slot : InventorySlots) {
+        Slot.CapturedDefinition = FConstStructView();
+    }
+}
+
+/**
+ * Inserts a slot index into a sorted index list.
+ *
+ * @param SlotIndices  The sorted list.
+ * @param Index        The slot index to insert.
+ */
+void USimpleInventory::InsertSlotIndex(TArray<int32>& SlotIndices,
+                                       const int32 Index) {
+    SlotIndices.Insert(Index, Algo::LowerBound(SlotIndices, Index));
+}
+
+/**
+ * Removes a slot index from a sorted index list, if present.
+ *
+ * @param SlotIndices  The sorted list.
+ * @param Index        The slot index to remove.
+ */
+void USimpleInventory::RemoveSlotIndex(TArray<int32>& SlotIndices,
+                                       const int32 Index) {
+    const int32 Position = Algo::BinarySearch(SlotIndices, Index);
+    if (Position != INDEX_NONE) {
+        SlotIndices.RemoveAt(Position);
+    }
+}
+
+/**
+ * Adds a change's delta to the running total of an item. Items whose total drops to zero are removed.
+ *
+ * @param ItemID  The item.
+ * @param Delta   The change in the item's total count.
+ */
+void USimpleInventory::AdjustItemTotal(const int32 ItemID,
+                                       const int32 Delta) {
+    if (Delta == 0) {
+        return;
+    }
+    
+    int32& Total = ItemTotals.FindOrAdd(ItemID);
+    Total += Delta;
+    if (Total <= 0) {
+        ItemTotals.Remove(ItemID);
+    }
+}
+
+/**
+ * Marks the snapshot chunk holding a slot as out of date.
+ * Nothing is tracked until the first snapshot is taken, since the first snapshot copies every chunk anyway.
+ *
+ * @param Index  The changed slot index.
+ */
+void USimpleInventory::MarkSnapshotSlotChanged(const int32 Index) {
+    if (CachedSnapshot.IsValid() && Index >= 0) {
+        DirtySnapshotChunks.Add(Index / FSimpleInventorySnapshot::ChunkSize);
+    }
+}
+
+/**
+ * Marks the snapshot chunk holding a slot, and every chunk after it, as out of date.
+ *
+ * @param FirstIndex  The first slot index that moved or changed.
+ */
+void USimpleInventory::MarkSnapshotSlotsShifted(const int32 FirstIndex) {
+    if (CachedSnapshot.IsValid()) {
+        FirstDirtySnapshotChunk = FMath::Min(FirstDirtySnapshotChunk, FMath::Max(0, FirstIndex) / FSimpleInventorySnapshot::ChunkSize);
+    }
+}
+
+/**
+ * Sums the count of every item in the inventory into Result.
+ *
+ * @param Result  Totals keyed by item ID. Existing entries are added to.
+ * @param Sign    1 to add the totals, -1 to subtract them.
+ */
+void USimpleInventory::AccumulateItemTotals(TMap<int32, int32>& Result,
+                                            const int32 Sign) const {
+    for (const auto& Entry : SlotIndicesByItemID) {
+        int32 Total = 0;
+        for (const int32 Index : Entry.Value) {
+            Total += InventorySlots[Index].Count;
+        }
+        Result.FindOrAdd(Entry.Key) += Sign * Total;
+    }
+}
+
+/**
+ * Records a change, then broadcasts it or merges it into the open batch if there is one.
+ * Every mutating function reports through here.
+ *
+ * @param Change  The change to report.
+ */
+void USimpleInventory::NotifyChange(const FSimpleInventoryChange& Change) {
+    RecordChange(Change);
+    DispatchChange(Change);
+}
+
+/**
+ * Applies the bookkeeping of a change: advances the generation and updates the slot stat, item totals and snapshot chunks.
+ * Split from DispatchChange for transfers, which record both inventories' changes before either is broadcast.
+ *
+ * @param Change  The change to record.
+ */
+void USimpleInventory::RecordChange(const FSimpleInventoryChange& Change) {
+    // FULL only reports that nothing more fit; the slots themselves did not change.
+    if (Change.Type != ESimpleInventoryChangeType::FULL) {
+        ++Generation;
+        
+        // Keep the total slot stat in step with this inventory's slot count.
+        INC_DWORD_STAT_BY(STAT_SimpleInventory_NumSlots, InventorySlots.Num());
+        DEC_DWORD_STAT_BY(STAT_SimpleInventory_NumSlots, ReportedSlotCount);
+        ReportedSlotCount = InventorySlots.Num();
+        
+        // Every change reports the net count change per item, so the totals never need a rescan.
+        AdjustItemTotal(Change.ItemID, Change.Delta);
+        for (const FSimpleInventoryItemDelta& ItemDelta : Change.ItemDeltas) {
+            AdjustItemTotal(ItemDelta.ItemID, ItemDelta.Delta);
+        }
+        
+        // Changes without slot indices (CLEAR, COPY, FORCE, LOAD) replace the slots wholesale.
+        if (Change.SlotIndex == INDEX_NONE && Change.SlotIndices.IsEmpty()) {
+            MarkSnapshotSlotsShifted(0);
+        }
+        else {
+            MarkSnapshotSlotChanged(Change.SlotIndex);
+            for (const int32 SlotIndex : Change.SlotIndices) {
+                MarkSnapshotSlotChanged(SlotIndex);
+            }
+        }
+    }
+}
+
+/**
+ * Broadcasts a recorded change, or merges it into the open batch if there is one.
+ *
+ * @param Change  The change to broadcast.
+ */
+void USimpleInventory::DispatchChange(const FSimpleInventoryChange& Change) {
+    if (BatchDepth == 0) {
+        BroadcastChange(Change);
+        return;
+    }
+    
+    if (Change.Type == ESimpleInventoryChangeType::FULL) {
+        PendingBatchFullChanges.Add(Change);
+        return;
+    }
+    
+    bBatchHasChanges = true;
+    
+    // Changes without slot indices replace the slots wholesale, and a sort's permutation cannot be merged with
+    // other changes, so both make the batch report every slot.
+    if ((Change.SlotIndex == INDEX_NONE && Change.SlotIndices.IsEmpty()) || Change.Type == ESimpleInventoryChangeType::REORDER) {
+        PendingBatchFirstShiftedSlot = 0;
+    }
+    if (Change.SlotIndex != INDEX_NONE) {
+        PendingBatchSlotIndices.Add(Change.SlotIndex);
+    }
+    PendingBatchSlotIndices.Append(Change.SlotIndices);
+    if (Change.Delta != 0) {
+        PendingBatchItemDeltas.FindOrAdd(Change.ItemID) += Change.Delta;
+    }
+    for (const FSimpleInventoryItemDelta& ItemDelta : Change.ItemDeltas) {
+        PendingBatchItemDeltas.FindOrAdd(ItemDelta.ItemID) += ItemDelta.Delta;
+    }
+}
+
+/**
+ * Broadcasts a change to native listeners, then to Blueprint listeners, or queues it while a write scope is open.
+ * The `USimpleInventoryChange` object for Blueprint listeners is only allocated if any are bound.
+ *
+ * @param Change  The change to broadcast.
+ */
+void USimpleInventory::BroadcastChange(const FSimpleInventoryChange& Change) const {
+    // A mutator is still running, so listeners wait until it finishes and the write lock is released.
+    if (SlotWriteDepth > 0) {
+        QueueChange(Change);
+        return;
+    }
+    
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventory::BroadcastChange", STAT_SimpleInventory_BroadcastChange);
+    INC_DWORD_STAT(STAT_SimpleInventory_NumChangeBroadcasts);
+    
+    OnInventoryChangeNative.Broadcast(Change);
+    
+    if (OnInventoryChangeEvent.IsBound()) {
+        OnInventoryChangeEvent.Broadcast(USimpleInventoryChange::Create(Change));
+    }
+}
+
+/**
+ * Holds a change until the outermost FSlotWriteScope ends. The item view points at memory the mutator may still
+ * change or free, so the item is copied, but only if anyone is listening.
+ *
+ * @param Change  The change to queue.
+ */
+void USimpleInventory::QueueChange(const FSimpleInventoryChange& Change) const {
+    FQueuedChange& Queued = QueuedChanges.AddDefaulted_GetRef();
+    Queued.Change = Change;
+    Queued.Change.Item = FConstStructView();
+    if (Change.Item.IsValid() && (OnInventoryChangeNative.IsBound() || OnInventoryChangeEvent.IsBound())) {
+        Queued.Item.InitializeAs(Change.Item.GetScriptStruct(), Change.Item.GetMemory());
+    }
+}
+
+/**
+ * Broadcasts the changes queued while the write lock was held, in the order they were made.
+ * Listeners may change the inventory again; their changes are broadcast when their own write scope ends.
+ */
+void USimpleInventory::BroadcastQueuedChanges() const {
+    TArray<FQueuedChange> Changes = MoveTemp(QueuedChanges);
+    QueuedChanges.Reset();
+    
+    for (FQueuedChange& Queued : Changes) {
+        if (Queued.Item.IsValid()) {
+            Queued.Change.Item = FConstStructView(Queued.Item);
+        }
+        BroadcastChange(Queued.Change);
+    }
+}
+
+// FSlotWriteScope
+
+USimpleInventory::FSlotWriteScope::FSlotWriteScope(const USimpleInventory* InInventory,
+                                                   const bool bApplyPendingCopy)
+    : Inventory(InInventory) {
+    checkSlow(IsInGameThread());
+    if (Inventory->SlotWriteDepth++ == 0) {
+        Inventory->SlotLock.WriteLock();
+    }
+    
+    // Applying a pending copy leaves the inventory's contents as they were, so const readers may trigger it too.
+    if (bApplyPendingCopy && Inventory->PendingCopy.IsValid()) {
+        const_cast<USimpleInventory*>(Inventory)->ApplyPendingCopy();
+    }
+}
+
+USimpleInventory::FSlotWriteScope::~FSlotWriteScope() {
+    if (--Inventory->SlotWriteDepth == 0) {
+        Inventory->SlotLock.WriteUnlock();
+        if (!Inventory->QueuedChanges.IsEmpty()) {
+            Inventory->BroadcastQueuedChanges();
+        }
+    }
+}
+
+// FSimpleInventoryBatchScope
+
+FSimpleInventoryBatchScope::FSimpleInventoryBatchScope(USimpleInventory* InInventory)
+    : Inventory(InInventory) {
+    if (Inventory.IsValid()) {
+        Inventory->BeginBatch();
+    }
+}
+
+FSimpleInventoryBatchScope::~FSimpleInventoryBatchScope() {
+    if (Inventory.IsValid()) {
+        Inventory->EndBatch();
+    }
 }
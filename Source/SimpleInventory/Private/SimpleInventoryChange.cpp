@@ -2,3 +2,66 @@
 
 #include "SimpleInventoryChange.h"
 
+/**
+ * Adds an amount to the net change of an item, creating its entry if needed.
+ *
+ * @param InItemID  The item.
+ * @param InDelta   The amount to add.
+ */
+void FSimpleInventoryChange::AddItemDelta(const int32 InItemID,
+                                          const int32 InDelta) {
+    if (InDelta == 0) {
+        return;
+    }
+    
+    for (FSimpleInventoryItemDelta& ItemDelta : ItemDeltas) {
+        if (ItemDelta.ItemID == InItemID) {
+            ItemDelta.Delta += InDelta;
+            return;
+        }
+    }
+    
+    FSimpleInventoryItemDelta& ItemDelta = ItemDeltas.AddDefaulted_GetRef();
+    ItemDelta.ItemID = InItemID;
+    ItemDelta.Delta = InDelta;
+}
+
+/**
+ * Replaces ItemDeltas with the given map, skipping items whose net change is zero.
+ *
+ * @param InItemDeltas  Net change keyed by item ID.
+ */
+void FSimpleInventoryChange::SetItemDeltas(const TMap<int32, int32>& InItemDeltas) {
+    ItemDeltas.Reset(InItemDeltas.Num());
+    for (const auto& Entry : InItemDeltas) {
+        if (Entry.Value != 0) {
+            FSimpleInventoryItemDelta& ItemDelta = ItemDeltas.AddDefaulted_GetRef();
+            ItemDelta.ItemID = Entry.Key;
+            ItemDelta.Delta = Entry.Value;
+        }
+    }
+}
+
+/**
+ * Allocates a `USimpleInventoryChange` mirroring the given native change.
+ * Only used when a Blueprint delegate is bound, since the native path never allocates.
+ *
+ * @param Change  The native change to copy.
+ * @return        The new change object.
+ */
+USimpleInventoryChange* USimpleInventoryChange::Create(const FSimpleInventoryChange& Change) {
+    USimpleInventoryChange* Result = NewObject<USimpleInventoryChange>();
+    Result->InventoryName = Change.InventoryName;
+    Result->Type = Change.Type;
+    Result->Count = Change.Count;
+    Result->SlotIndices = Change.SlotIndices;
+    Result->ItemDeltas = Change.ItemDeltas;
+    Result->Permutation = Change.Permutation;
+    Result->TransferInventoryName = Change.TransferInventoryName;
+    Result->TransferSlotIndices = Change.TransferSlotIndices;
+    Result->bIsTransferSource = Change.bIsTransferSource;
+    if (Change.Item.IsValid()) {
+        Result->Item.InitializeAs(Change.Item.GetScriptStruct(), Change.Item.GetMemory());
+    }
+    return Result;
+}
@@ -2,29 +2,70 @@
 
 #include "SimpleInventoryComponent.h"
 
+#include "Net/UnrealNetwork.h"
+
 #include "SimpleInventory.h"
+#include "SimpleInventoryChange.h"
 #include "SimpleInventoryLog.h"
+#include "SimpleInventoryStats.h"
 
 // Lifecycle
 
 /**
  * Constructor for the Simple Inventory Component.
- * Disables ticking, as this component does not need per-frame updates.
+ * Disables ticking, as this component does not need per-frame updates, and replicates by default.
  */
 USimpleInventoryComponent::USimpleInventoryComponent() {
     PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(true);
+    ReplicatedSlots.Owner = this;
+}
+
+/**
+ * Registers the replicated slots. They are only relevant to the owning client.
+ *
+ * @param OutLifetimeProps  The replicated properties of this component.
+ */
+void USimpleInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const {
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+    
+    DOREPLIFETIME_CONDITION(USimpleInventoryComponent, ReplicatedSlots, COND_OwnerOnly);
 }
 
 /**
  * Called when the game starts or when the component is spawned.
  * Sets the maximum inventory size and ensures the inventory is properly resized.
+ * On the server, the inventory's changes are mirrored into the replicated slots.
  */
 void USimpleInventoryComponent::BeginPlay() {
     Super::BeginPlay();
     
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::BeginPlay"));
+    if (!Inventory) {
+        Inventory = NewObject<USimpleInventory>(this);
+    }
+    ReplicatedSlots.Owner = this;
+    
     Inventory->MaxSlotSize = MaxSlotSize;
     Inventory->ForceResize();
+    
+    if (GetOwnerRole() == ROLE_Authority) {
+        Inventory->OnInventoryChangeNative.AddUObject(this, &USimpleInventoryComponent::HandleInventoryChange);
+        SyncReplicatedSlots(0);
+    }
+}
+
+/**
+ * Stops mirroring inventory changes.
+ *
+ * @param EndPlayReason  Why play ended.
+ */
+void USimpleInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+    if (Inventory) {
+        Inventory->OnInventoryChangeNative.RemoveAll(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 /**
@@ -37,11 +78,28 @@ void USimpleInventoryComponent::BeginPlay() {
 void USimpleInventoryComponent::AddItem(FInstancedStruct Item,
                                         const int32 Count,
                                         bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::AddItem");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::AddItem || Count: %i"), Count);
     
     Inventory->AddItem(Item, Count, Result);
 }
 
+/**
+ * Adds an item by ID using its registered definition.
+ *
+ * @param ItemID  The ID of a registered item definition.
+ * @param Count   The number of items to add.
+ * @param Result  True if the item was successfully added, false otherwise.
+ */
+void USimpleInventoryComponent::AddItemByID(const int32 ItemID,
+                                            const int32 Count,
+                                            bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::AddItemByID");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::AddItemByID || ItemID: %i | Count: %i"), ItemID, Count);
+    
+    Inventory->AddItemByID(ItemID, Count, Result);
+}
+
 /**
  * Removes a specified number of items at a given index.
  *
@@ -52,6 +110,7 @@ void USimpleInventoryComponent::AddItem(FInstancedStruct Item,
 void USimpleInventoryComponent::RemoveItemAtIndex(const int32 Index,
                                                   const int32 Count,
                                                   bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::RemoveItemAtIndex");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::RemoveItemAtIndex || Index: %i | Count: %i"), Index, Count);
     
     Inventory->RemoveItemAtIndex(Index, Count, Result);
@@ -65,15 +124,53 @@ void USimpleInventoryComponent::RemoveItemAtIndex(const int32 Index,
  */
 void USimpleInventoryComponent::RemoveItems(const TArray<FInstancedStruct>& Items,
                                             bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::RemoveItems");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::RemoveItems"));
     
     Inventory->RemoveItems(Items, Result);
 }
 
+/**
+ * Adds several items to the inventory in one batch.
+ *
+ * @param Entries       The items and amounts to add.
+ * @param bAllOrNothing If true, nothing is added unless every entry fits.
+ * @param EntryResults  True for each entry that was fully added.
+ * @param Result        True if every entry was fully added.
+ */
+void USimpleInventoryComponent::AddItems(const TArray<FSimpleInventoryItemEntry>& Entries,
+                                         const bool bAllOrNothing,
+                                         TArray<bool>& EntryResults,
+                                         bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::AddItems");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::AddItems"));
+    
+    Inventory->AddItems(Entries, bAllOrNothing, EntryResults, Result);
+}
+
+/**
+ * Removes amounts of several items by ID from the inventory in one batch.
+ *
+ * @param Entries       The item IDs and amounts to remove.
+ * @param bAllOrNothing If true, nothing is removed unless every entry can be fully removed.
+ * @param EntryResults  True for each entry that was fully removed.
+ * @param Result        True if every entry was fully removed.
+ */
+void USimpleInventoryComponent::RemoveItemsByCount(const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                                                   const bool bAllOrNothing,
+                                                   TArray<bool>& EntryResults,
+                                                   bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::RemoveItemsByCount");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::RemoveItemsByCount"));
+    
+    Inventory->RemoveItemsByCount(Entries, bAllOrNothing, EntryResults, Result);
+}
+
 /**
  * Clears all items from the inventory.
  */
 void USimpleInventoryComponent::Clear() {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::Clear");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::Clear"));
     
     Inventory->Clear();
@@ -125,12 +222,41 @@ void USimpleInventoryComponent::GetSlots(TArray<USimpleInventorySlot*>& Result)
     Inventory->GetSlots(Result);
 }
 
+/**
+ * Gets the total amount of an item across all slots.
+ *
+ * @param ItemID Item ID to count.
+ * @param Result Outputs the total count.
+ */
+void USimpleInventoryComponent::GetItemCount(const int32 ItemID,
+                                             int32& Result) const {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::GetItemCount || ItemID: %i"), ItemID);
+    
+    Inventory->GetItemCount(ItemID, Result);
+}
+
+/**
+ * Checks if the inventory holds at least Count of an item across all slots.
+ *
+ * @param ItemID Item ID to check.
+ * @param Count  Minimum quantity required.
+ * @param Result True if the total count of the item is at least Count.
+ */
+void USimpleInventoryComponent::HasAtLeast(const int32 ItemID,
+                                           const int32 Count,
+                                           bool& Result) const {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::HasAtLeast || ItemID: %i | Count: %i"), ItemID, Count);
+    
+    Inventory->HasAtLeast(ItemID, Count, Result);
+}
+
 /**
  * Copies the contents of another inventory into this one.
  *
  * @param OtherInventory The inventory to copy from.
  */
 void USimpleInventoryComponent::CopyInventory(const USimpleInventory* OtherInventory) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::CopyInventory");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::CopyInventory"));
     
     Inventory->CopyInventory(OtherInventory);
@@ -140,7 +266,105 @@ void USimpleInventoryComponent::CopyInventory(const USimpleInventory* OtherInven
  * Forces the inventory to fire its change event, useful for UI updates.
  */
 void USimpleInventoryComponent::ForceOnChange() const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventoryComponent::ForceOnChange");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::ForceOnChange"));
     
     Inventory->ForceOnChange();
 }
+
+/**
+ * Records a slot changed by replication, to be reported once the whole update has been applied.
+ *
+ * @param SlotIndex  The slot that was added, changed or removed.
+ */
+void USimpleInventoryComponent::MarkReplicatedSlotChanged(const int32 SlotIndex) {
+    PendingReplicatedSlotIndices.Add(SlotIndex);
+}
+
+/**
+ * Rebuilds the local inventory from the replicated slots, then broadcasts OnSlotReplicated for each changed slot.
+ */
+void USimpleInventoryComponent::ApplyReplicatedSlots() {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventoryComponent::ApplyReplicatedSlots", STAT_SimpleInventory_ApplyReplicatedSlots);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventoryComponent::ApplyReplicatedSlots || Changed: %i"), PendingReplicatedSlotIndices.Num());
+    
+    if (!Inventory) {
+        Inventory = NewObject<USimpleInventory>(this);
+    }
+    
+    TArray<FSimpleInventorySlot> Slots;
+    Slots.SetNum(ReplicatedSlots.Items.Num());
+    for (const FSimpleInventoryReplicatedSlot& Entry : ReplicatedSlots.Items) {
+        if (Entry.SlotIndex >= Slots.Num()) {
+            Slots.SetNum(Entry.SlotIndex + 1);
+        }
+        if (Entry.SlotIndex >= 0) {
+            Entry.GetSlot(Slots[Entry.SlotIndex]);
+        }
+    }
+    
+    TArray<int32> ChangedSlotIndices = PendingReplicatedSlotIndices.Array();
+    ChangedSlotIndices.Sort();
+    PendingReplicatedSlotIndices.Reset();
+    
+    Inventory->ReplaceSlots(MoveTemp(Slots), ChangedSlotIndices);
+    
+    const TArray<FSimpleInventorySlot>& InventorySlots = Inventory->GetSlotData();
+    const FSimpleInventorySlot EmptySlot;
+    for (const int32 SlotIndex : ChangedSlotIndices) {
+        const FSimpleInventorySlot& Slot = InventorySlots.IsValidIndex(SlotIndex) ? InventorySlots[SlotIndex] : EmptySlot;
+        OnSlotReplicatedNative.Broadcast(SlotIndex, Slot);
+        OnSlotReplicated.Broadcast(SlotIndex, Slot.ItemID, Slot.Count);
+    }
+}
+
+// Private Functions
+
+/**
+ * Mirrors an inventory change into the replicated slots.
+ * Only slots at or after the lowest index the change touched are compared, since earlier slots cannot have moved.
+ *
+ * @param Change  The change reported by the inventory.
+ */
+void USimpleInventoryComponent::HandleInventoryChange(const FSimpleInventoryChange& Change) {
+    if (Change.Type == ESimpleInventoryChangeType::FULL) {
+        return;
+    }
+    
+    int32 FirstIndex = Change.SlotIndex;
+    for (const int32 SlotIndex : Change.SlotIndices) {
+        FirstIndex = FirstIndex == INDEX_NONE ? SlotIndex : FMath::Min(FirstIndex, SlotIndex);
+    }
+    SyncReplicatedSlots(FirstIndex == INDEX_NONE ? 0 : FirstIndex);
+}
+
+/**
+ * Compares inventory slots from FirstIndex onwards against the replicated entries and marks only the ones that differ.
+ * Entries are kept in slot order, so a slot removed in the middle re-sends the slots that shifted down.
+ *
+ * @param FirstIndex  The first slot that may have changed.
+ */
+void USimpleInventoryComponent::SyncReplicatedSlots(const int32 FirstIndex) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventoryComponent::SyncReplicatedSlots", STAT_SimpleInventory_SyncReplicatedSlots);
+    const int32 NumSlots = Inventory->GetNumSlots();
+    TArray<FSimpleInventoryReplicatedSlot>& Entries = ReplicatedSlots.Items;
+    
+    for (int32 Index = FMath::Min(FirstIndex, Entries.Num()); Index < NumSlots; ++Index) {
+        const FSimpleInventorySlot& Slot = Inventory->GetSlotDataAt(Index);
+        if (!Entries.IsValidIndex(Index)) {
+            FSimpleInventoryReplicatedSlot& Entry = Entries.AddDefaulted_GetRef();
+            Entry.SlotIndex = Index;
+            Entry.SetSlot(Slot);
+            ReplicatedSlots.MarkItemDirty(Entry);
+        }
+        else if (!Entries[Index].Matches(Slot)) {
+            Entries[Index].SetSlot(Slot);
+            ReplicatedSlots.MarkItemDirty(Entries[Index]);
+        }
+    }
+    
+    if (Entries.Num() > NumSlots) {
+        Entries.SetNum(NumSlots);
+        ReplicatedSlots.MarkArrayDirty();
+    }
+}
@@ -0,0 +1,14 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventoryHandle.h"
+
+// FSimpleInventoryHandle
+
+/**
+ * Formats the handle for logging.
+ *
+ * @return  The index and serial, e.g. `3:1`.
+ */
+FString FSimpleInventoryHandle::ToString() const {
+    return FString::Printf(TEXT("%d:%d"), Index, Serial);
+}
@@ -0,0 +1,89 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventoryItemAccessor.h"
+
+#include "SimpleInventoryLog.h"
+
+#include "Misc/ScopeRWLock.h"
+
+TMap<const UScriptStruct*, FSimpleInventoryItemAccessor> FSimpleInventoryItemAccessorCache::Accessors;
+FRWLock FSimpleInventoryItemAccessorCache::AccessorsLock;
+
+// FSimpleInventoryItemAccessor
+
+/**
+ * Reads `bIsStackable` from the given struct memory.
+ *
+ * @param Memory  Pointer to an instance of the struct this accessor was resolved for.
+ * @return        The value of `bIsStackable`.
+ */
+bool FSimpleInventoryItemAccessor::IsStackable(const void* Memory) const {
+    return IsStackableProperty->GetPropertyValue_InContainer(Memory);
+}
+
+// FSimpleInventoryItemAccessorCache
+
+/**
+ * Returns the accessor for the given struct type, resolving and caching it on first use.
+ * Safe to call from any thread: hits only take the read lock, and a miss is resolved outside the lock.
+ *
+ * @param StructType  The item struct type.
+ * @return            The cached accessor, or an invalid accessor if StructType is null.
+ */
+FSimpleInventoryItemAccessor FSimpleInventoryItemAccessorCache::Get(const UScriptStruct* StructType) {
+    if (!StructType) {
+        return FSimpleInventoryItemAccessor();
+    }
+
+    {
+        FReadScopeLock ReadLock(AccessorsLock);
+        if (const FSimpleInventoryItemAccessor* Accessor = Accessors.Find(StructType)) {
+            return *Accessor;
+        }
+    }
+
+    // Two threads may resolve the same struct at once; both get the same offsets, so the first one added wins.
+    const FSimpleInventoryItemAccessor Resolved = Resolve(StructType);
+    FWriteScopeLock WriteLock(AccessorsLock);
+    return Accessors.FindOrAdd(StructType, Resolved);
+}
+
+/**
+ * Clears all cached accessors so they are re-resolved on next use.
+ */
+void FSimpleInventoryItemAccessorCache::Reset() {
+    FWriteScopeLock WriteLock(AccessorsLock);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryItemAccessorCache::Reset || Dropping %d accessors"), Accessors.Num());
+
+    Accessors.Empty();
+}
+
+/**
+ * Looks up the `ID`, `bIsStackable` and `StackSize` properties on a struct type.
+ *
+ * @param StructType  The item struct type.
+ * @return            The resolved accessor.
+ */
+FSimpleInventoryItemAccessor FSimpleInventoryItemAccessorCache::Resolve(const UScriptStruct* StructType) {
+    static const FName IDPropName = TEXT("ID");
+    static const FName IsStackablePropName = TEXT("bIsStackable");
+    static const FName StackSizePropName = TEXT("StackSize");
+
+    FSimpleInventoryItemAccessor Accessor;
+
+    if (const FIntProperty* IDProp = CastField<FIntProperty>(StructType->FindPropertyByName(IDPropName))) {
+        Accessor.IDOffset = IDProp->GetOffset_ForInternal();
+    }
+    else {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventoryItemAccessorCache::Resolve || %s missing valid 'ID' int property"), *StructType->GetName());
+    }
+
+    if (const FIntProperty* StackSizeProp = CastField<FIntProperty>(StructType->FindPropertyByName(StackSizePropName))) {
+        Accessor.StackSizeOffset = StackSizeProp->GetOffset_ForInternal();
+    }
+    Accessor.IsStackableProperty = CastField<FBoolProperty>(StructType->FindPropertyByName(IsStackablePropName));
+
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryItemAccessorCache::Resolve || Resolved %s"), *StructType->GetName());
+
+    return Accessor;
+}
@@ -0,0 +1,3 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventoryItemEntry.h"
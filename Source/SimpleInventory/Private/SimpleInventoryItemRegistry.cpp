@@ -0,0 +1,178 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventoryItemRegistry.h"
+
+#include "Engine/DataTable.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectIterator.h"
+
+#include "SimpleInventoryLog.h"
+#include "SimpleInventoryItemAccessor.h"
+#include "SimpleInventory.h"
+
+TArray<FSimpleInventoryItemRegistry::FRegisteredTable> FSimpleInventoryItemRegistry::Tables;
+TSharedPtr<const FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe> FSimpleInventoryItemRegistry::Definitions;
+FRWLock FSimpleInventoryItemRegistry::DefinitionsLock;
+
+/**
+ * Registers every row of a DataTable as an item definition and rebuilds the ID lookup.
+ * The lookup is rebuilt again whenever the table changes, since row memory may move.
+ *
+ * @param ItemTable  The table to register.
+ */
+void FSimpleInventoryItemRegistry::Register(UDataTable* ItemTable) {
+    if (!ItemTable || !ItemTable->GetRowStruct()) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventoryItemRegistry::Register || Invalid DataTable"));
+        return;
+    }
+    
+    if (!FSimpleInventoryItemAccessorCache::Get(ItemTable->GetRowStruct()).IsValid()) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventoryItemRegistry::Register || %s rows missing valid 'ID' int property"), *ItemTable->GetName());
+        return;
+    }
+    
+    for (const FRegisteredTable& Registered : Tables) {
+        if (Registered.Table.Get() == ItemTable) {
+            UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryItemRegistry::Register || %s already registered"), *ItemTable->GetName());
+            return;
+        }
+    }
+    
+    FRegisteredTable& Registered = Tables.AddDefaulted_GetRef();
+    Registered.Table.Reset(ItemTable);
+    Registered.ChangedHandle = ItemTable->OnDataTableChanged().AddStatic(&FSimpleInventoryItemRegistry::Rebuild);
+    
+    Rebuild();
+    
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryItemRegistry::Register || Registered %s, %d definitions"), *ItemTable->GetName(), Num());
+}
+
+/**
+ * Removes a DataTable and rebuilds the ID lookup from the remaining tables.
+ * Every live inventory first copies the table's definitions into the slots that reference them.
+ *
+ * @param ItemTable  The table to remove.
+ */
+void FSimpleInventoryItemRegistry::Unregister(UDataTable* ItemTable) {
+    const int32 Index = Tables.IndexOfByPredicate([ItemTable](const FRegisteredTable& Registered) {
+        return Registered.Table.Get() == ItemTable;
+    });
+    if (Index == INDEX_NONE) {
+        return;
+    }
+    
+    // Only IDs currently resolved to this table's rows; a duplicate ID owned by another table stays as it is.
+    TSet<int32> DetachedItemIDs;
+    const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(ItemTable->GetRowStruct());
+    if (Accessor.IsValid()) {
+        for (const auto& Row : ItemTable->GetRowMap()) {
+            const int32 ItemID = Accessor.GetID(Row.Value);
+            if (Find(ItemID).GetMemory() == Row.Value) {
+                DetachedItemIDs.Add(ItemID);
+            }
+        }
+    }
+    if (!DetachedItemIDs.IsEmpty()) {
+        for (TObjectIterator<USimpleInventory> It; It; ++It) {
+            It->DetachDefinitions(DetachedItemIDs);
+        }
+    }
+    
+    ItemTable->OnDataTableChanged().Remove(Tables[Index].ChangedHandle);
+    Tables.RemoveAt(Index);
+    
+    Rebuild();
+}
+
+/**
+ * Returns the definition for an item ID.
+ *
+ * @param ItemID  The item ID.
+ * @return        A view of the table row, or an invalid view if the ID is not registered.
+ */
+FConstStructView FSimpleInventoryItemRegistry::Find(const int32 ItemID) {
+    FReadScopeLock ReadLock(DefinitionsLock);
+    return Definitions.IsValid() ? Definitions->Find(ItemID) : FConstStructView();
+}
+
+/**
+ * Returns the published set of definitions.
+ *
+ * @return  The current definitions, or null if no table was ever registered.
+ */
+TSharedPtr<const FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe> FSimpleInventoryItemRegistry::GetDefinitions() {
+    FReadScopeLock ReadLock(DefinitionsLock);
+    return Definitions;
+}
+
+/**
+ * Compares an item against the registered definition for its ID.
+ *
+ * @param ItemID  The item ID.
+ * @param Item    The item to compare.
+ * @return        True if the item has the same struct type and values as the definition.
+ */
+bool FSimpleInventoryItemRegistry::Matches(const int32 ItemID,
+                                           const FConstStructView Item) {
+    const FConstStructView Definition = Find(ItemID);
+    if (!Definition.IsValid() || !Item.IsValid() || Definition.GetScriptStruct() != Item.GetScriptStruct()) {
+        return false;
+    }
+    
+    if (Definition.GetMemory() == Item.GetMemory()) {
+        return true;
+    }
+    
+    return Item.GetScriptStruct()->CompareScriptStruct(Item.GetMemory(), Definition.GetMemory(), PPF_None);
+}
+
+int32 FSimpleInventoryItemRegistry::Num() {
+    FReadScopeLock ReadLock(DefinitionsLock);
+    return Definitions.IsValid() ? Definitions->Definitions.Num() : 0;
+}
+
+/**
+ * Drops every registered table and definition.
+ */
+void FSimpleInventoryItemRegistry::Reset() {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryItemRegistry::Reset || Dropping %d tables"), Tables.Num());
+    
+    for (const FRegisteredTable& Registered : Tables) {
+        if (UDataTable* Table = Registered.Table.Get()) {
+            Table->OnDataTableChanged().Remove(Registered.ChangedHandle);
+        }
+    }
+    Tables.Empty();
+    
+    FWriteScopeLock WriteLock(DefinitionsLock);
+    Definitions.Reset();
+}
+
+/**
+ * Builds a new set of definitions from the registered tables, in registration order, then publishes it.
+ * Readers holding the previous set keep it, and the tables it references, until they let go.
+ */
+void FSimpleInventoryItemRegistry::Rebuild() {
+    TSharedRef<FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe> Rebuilt = MakeShared<FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe>();
+    
+    for (const FRegisteredTable& Registered : Tables) {
+        UDataTable* Table = Registered.Table.Get();
+        const UScriptStruct* RowStruct = Table ? Table->GetRowStruct() : nullptr;
+        const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(RowStruct);
+        if (!Accessor.IsValid()) {
+            continue;
+        }
+        
+        Rebuilt->Tables.Emplace(Table);
+        for (const auto& Row : Table->GetRowMap()) {
+            const int32 ItemID = Accessor.GetID(Row.Value);
+            if (Rebuilt->Definitions.Contains(ItemID)) {
+                UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventoryItemRegistry::Rebuild || Duplicate item ID %d in %s, row %s"), ItemID, *Table->GetName(), *Row.Key.ToString());
+            }
+            Rebuilt->Definitions.Add(ItemID, FConstStructView(RowStruct, Row.Value));
+        }
+    }
+    
+    FWriteScopeLock WriteLock(DefinitionsLock);
+    Definitions = Rebuilt;
+}
@@ -2,19 +2,65 @@
 
 #include "SimpleInventoryModule.h"
 
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+#include "Kismet2/StructureEditorUtils.h"
+#endif
+
 #include "SimpleInventoryLog.h"
+#include "SimpleInventoryItemAccessor.h"
+#include "SimpleInventoryItemRegistry.h"
+#include "SimpleInventorySnapshot.h"
 
 #define LOCTEXT_NAMESPACE "FSimpleInventoryModule"
 
+#if WITH_EDITOR
+/**
+ * Recompiling a UserDefinedStruct changes its layout in place, keeping the same `UScriptStruct*`,
+ * so cached accessors for it would read stale offsets.
+ */
+class FSimpleInventoryStructChangeListener : public FStructureEditorUtils::INotifyOnStructChanged
+{
+public:
+    virtual void PreChange(const UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo Info) override {}
+
+    virtual void PostChange(const UUserDefinedStruct* Struct, FStructureEditorUtils::EStructureEditorChangeInfo Info) override {
+        FSimpleInventoryItemAccessorCache::Reset();
+    }
+};
+#endif
+
 void FSimpleInventoryModule::StartupModule() {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryModule::StartupModule"));
+    
+    // Item struct layouts can change on hot reload, so cached property offsets must be re-resolved.
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason) {
+        FSimpleInventoryItemAccessorCache::Reset();
+    });
+    ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const TMap<UObject*, UObject*>&) {
+        FSimpleInventoryItemAccessorCache::Reset();
+    });
+#if WITH_EDITOR
+    StructChangeListener = MakeUnique<FSimpleInventoryStructChangeListener>();
+#endif
+    FSimpleInventorySnapshotChunk::StartReportingReferences();
 }
 
 void FSimpleInventoryModule::ShutdownModule() {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryModule::ShutdownModule"));
+    
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+#if WITH_EDITOR
+    StructChangeListener.Reset();
+#endif
+    FSimpleInventorySnapshotChunk::StopReportingReferences();
+    FSimpleInventoryItemAccessorCache::Reset();
+    FSimpleInventoryItemRegistry::Reset();
 }
 
 #undef LOCTEXT_NAMESPACE
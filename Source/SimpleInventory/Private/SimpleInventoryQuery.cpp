@@ -0,0 +1,250 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventoryQuery.h"
+
+#include "SimpleInventoryLog.h"
+
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+namespace SimpleInventoryQuery
+{
+    /**
+     * Applies a comparison operator to two ordered values.
+     *
+     * @param A         The item's value.
+     * @param B         The condition's value.
+     * @param Operator  The comparison to apply.
+     * @return          The result of `A Operator B`.
+     */
+    template <typename T>
+    static bool Compare(const T& A,
+                        const T& B,
+                        const ESimpleInventoryQueryOperator Operator) {
+        switch (Operator) {
+            case ESimpleInventoryQueryOperator::EQUAL:
+                return A == B;
+            case ESimpleInventoryQueryOperator::NOT_EQUAL:
+                return A != B;
+            case ESimpleInventoryQueryOperator::LESS:
+                return A < B;
+            case ESimpleInventoryQueryOperator::LESS_OR_EQUAL:
+                return A <= B;
+            case ESimpleInventoryQueryOperator::GREATER:
+                return A > B;
+            case ESimpleInventoryQueryOperator::GREATER_OR_EQUAL:
+                return A >= B;
+        }
+        return false;
+    }
+
+    static bool IsEqualityOperator(const ESimpleInventoryQueryOperator Operator) {
+        return Operator == ESimpleInventoryQueryOperator::EQUAL || Operator == ESimpleInventoryQueryOperator::NOT_EQUAL;
+    }
+
+    /** True for the unsigned integer property types, whose values can exceed what a signed read returns. */
+    static bool IsUnsigned(const FNumericProperty* Property) {
+        return Property->IsA<FByteProperty>()
+            || Property->IsA<FUInt16Property>()
+            || Property->IsA<FUInt32Property>()
+            || Property->IsA<FUInt64Property>();
+    }
+}
+
+// FSimpleInventoryCompiledQuery
+
+/**
+ * Compiles a query. Conditions are resolved lazily, once per item struct type, when an item of that type is first matched.
+ *
+ * @param InQuery  The query to compile.
+ */
+FSimpleInventoryCompiledQuery::FSimpleInventoryCompiledQuery(const FSimpleInventoryQuery& InQuery)
+    : StructType(InQuery.StructType)
+    , Conditions(InQuery.Conditions) {
+}
+
+/**
+ * Checks an item against the struct type filter and every condition.
+ *
+ * @param Item  The item to test.
+ * @return      True if the item matches.
+ */
+bool FSimpleInventoryCompiledQuery::Matches(const FConstStructView Item) const {
+    const UScriptStruct* Struct = Item.GetScriptStruct();
+    const void* Memory = Item.GetMemory();
+    if (!Struct || !Memory) {
+        return false;
+    }
+
+    const FResolvedType& Resolved = Resolve(Struct);
+    if (!Resolved.bMatchesType) {
+        return false;
+    }
+
+    for (const FResolvedCondition& Condition : Resolved.Conditions) {
+        if (!EvaluateCondition(Condition, Memory)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns the conditions resolved against a struct type, resolving them on first use.
+ *
+ * @param Struct  The item struct type.
+ * @return        The resolved type. bMatchesType is false if Struct is filtered out or a condition cannot apply to it.
+ */
+const FSimpleInventoryCompiledQuery::FResolvedType& FSimpleInventoryCompiledQuery::Resolve(const UScriptStruct* Struct) const {
+    if (ResolvedTypes.IsValidIndex(LastResolvedIndex) && ResolvedTypes[LastResolvedIndex].Struct == Struct) {
+        return ResolvedTypes[LastResolvedIndex];
+    }
+
+    for (int32 Index = 0; Index < ResolvedTypes.Num(); ++Index) {
+        if (ResolvedTypes[Index].Struct == Struct) {
+            LastResolvedIndex = Index;
+            return ResolvedTypes[Index];
+        }
+    }
+
+    LastResolvedIndex = ResolvedTypes.AddDefaulted();
+    FResolvedType& Resolved = ResolvedTypes[LastResolvedIndex];
+    Resolved.Struct = Struct;
+    Resolved.bMatchesType = !StructType || Struct->IsChildOf(StructType);
+    if (!Resolved.bMatchesType) {
+        return Resolved;
+    }
+
+    Resolved.Conditions.Reserve(Conditions.Num());
+    for (const FSimpleInventoryQueryCondition& Condition : Conditions) {
+        if (!ResolveCondition(Struct, Condition, Resolved.Conditions.AddDefaulted_GetRef())) {
+            Resolved.bMatchesType = false;
+            Resolved.Conditions.Reset();
+            break;
+        }
+    }
+
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryCompiledQuery::Resolve || Resolved %s | Matches Type: %d"), *Struct->GetName(), Resolved.bMatchesType);
+
+    return Resolved;
+}
+
+/**
+ * Finds a condition's property on a struct type and parses the condition's value to the property's type.
+ *
+ * @param Struct     The item struct type.
+ * @param Condition  The condition to resolve.
+ * @param Result     The resolved condition.
+ * @return           False if the struct has no such property, the property type is unsupported,
+ *                   the value cannot be parsed, or the operator does not apply to the property type.
+ */
+bool FSimpleInventoryCompiledQuery::ResolveCondition(const UScriptStruct* Struct,
+                                                     const FSimpleInventoryQueryCondition& Condition,
+                                                     FResolvedCondition& Result) const {
+    const FProperty* Property = Struct->FindPropertyByName(Condition.PropertyName);
+    if (!Property) {
+        UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventoryCompiledQuery::ResolveCondition || %s has no property %s"), *Struct->GetName(), *Condition.PropertyName.ToString());
+        return false;
+    }
+
+    Result.Property = Property;
+    Result.Operator = Condition.Operator;
+
+    const UEnum* Enum = nullptr;
+    if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property)) {
+        Result.NumericProperty = EnumProperty->GetUnderlyingProperty();
+        Enum = EnumProperty->GetEnum();
+    }
+    else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property)) {
+        Result.NumericProperty = NumericProperty;
+        Enum = NumericProperty->GetIntPropertyEnum();
+    }
+
+    bool bParsed = true;
+    if (Result.NumericProperty && Result.NumericProperty->IsFloatingPoint()) {
+        Result.Kind = EValueKind::Float;
+        bParsed = LexTryParseString(Result.FloatValue, *Condition.Value);
+    }
+    else if (Result.NumericProperty) {
+        const bool bUnsigned = SimpleInventoryQuery::IsUnsigned(Result.NumericProperty);
+        Result.Kind = bUnsigned ? EValueKind::UnsignedInteger : EValueKind::Integer;
+        const int64 EnumValue = Enum ? Enum->GetValueByNameString(Condition.Value) : INDEX_NONE;
+        if (EnumValue != INDEX_NONE) {
+            Result.IntValue = EnumValue;
+            Result.UnsignedValue = static_cast<uint64>(EnumValue);
+        }
+        else if (bUnsigned) {
+            bParsed = LexTryParseString(Result.UnsignedValue, *Condition.Value);
+        }
+        else {
+            bParsed = LexTryParseString(Result.IntValue, *Condition.Value);
+        }
+    }
+    else if (CastField<FBoolProperty>(Property)) {
+        Result.Kind = EValueKind::Bool;
+        Result.bBoolValue = Condition.Value.ToBool();
+    }
+    else if (CastField<FNameProperty>(Property)) {
+        Result.Kind = EValueKind::Name;
+        Result.NameValue = FName(*Condition.Value);
+    }
+    else if (CastField<FStrProperty>(Property)) {
+        Result.Kind = EValueKind::String;
+        Result.StringValue = Condition.Value;
+    }
+    else if (CastField<FTextProperty>(Property)) {
+        Result.Kind = EValueKind::Text;
+        Result.TextValue = FText::FromString(Condition.Value);
+    }
+    else {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventoryCompiledQuery::ResolveCondition || %s.%s has an unsupported property type"), *Struct->GetName(), *Condition.PropertyName.ToString());
+        return false;
+    }
+
+    if (!bParsed) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventoryCompiledQuery::ResolveCondition || Cannot parse '%s' for %s.%s"), *Condition.Value, *Struct->GetName(), *Condition.PropertyName.ToString());
+        return false;
+    }
+
+    const bool bOrdered = Result.Kind == EValueKind::Integer
+        || Result.Kind == EValueKind::UnsignedInteger
+        || Result.Kind == EValueKind::Float
+        || Result.Kind == EValueKind::String;
+    if (!bOrdered && !SimpleInventoryQuery::IsEqualityOperator(Condition.Operator)) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventoryCompiledQuery::ResolveCondition || %s.%s only supports Equal and Not Equal"), *Struct->GetName(), *Condition.PropertyName.ToString());
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Reads a resolved property from item memory and compares it with the condition's value.
+ *
+ * @param Condition  The resolved condition.
+ * @param Memory     The item's memory, of the struct type the condition was resolved for.
+ * @return           True if the condition holds.
+ */
+bool FSimpleInventoryCompiledQuery::EvaluateCondition(const FResolvedCondition& Condition,
+                                                      const void* Memory) {
+    const void* Value = Condition.Property->ContainerPtrToValuePtr<void>(Memory);
+
+    switch (Condition.Kind) {
+        case EValueKind::Integer:
+            return SimpleInventoryQuery::Compare(Condition.NumericProperty->GetSignedIntPropertyValue(Value), Condition.IntValue, Condition.Operator);
+        case EValueKind::UnsignedInteger:
+            return SimpleInventoryQuery::Compare(Condition.NumericProperty->GetUnsignedIntPropertyValue(Value), Condition.UnsignedValue, Condition.Operator);
+        case EValueKind::Float:
+            return SimpleInventoryQuery::Compare(Condition.NumericProperty->GetFloatingPointPropertyValue(Value), Condition.FloatValue, Condition.Operator);
+        case EValueKind::Bool:
+            return SimpleInventoryQuery::Compare(static_cast<const FBoolProperty*>(Condition.Property)->GetPropertyValue(Value), Condition.bBoolValue, Condition.Operator);
+        case EValueKind::Name:
+            return SimpleInventoryQuery::Compare(static_cast<const FNameProperty*>(Condition.Property)->GetPropertyValue(Value) == Condition.NameValue, true, Condition.Operator);
+        case EValueKind::String:
+            return SimpleInventoryQuery::Compare(static_cast<const FStrProperty*>(Condition.Property)->GetPropertyValue(Value).Compare(Condition.StringValue, ESearchCase::CaseSensitive), 0, Condition.Operator);
+        case EValueKind::Text:
+            return SimpleInventoryQuery::Compare(static_cast<const FTextProperty*>(Condition.Property)->GetPropertyValue(Value).EqualTo(Condition.TextValue, ETextComparisonLevel::Quinary), true, Condition.Operator);
+    }
+    return false;
+}
@@ -0,0 +1,58 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventoryReplicatedSlots.h"
+
+#include "SimpleInventoryComponent.h"
+
+// FSimpleInventoryReplicatedSlot
+
+bool FSimpleInventoryReplicatedSlot::Matches(const FSimpleInventorySlot& Slot) const {
+    return ItemID == Slot.ItemID
+        && Count == Slot.Count
+        && bUsesDefinition == Slot.bUsesDefinition
+        && Item == Slot.Item;
+}
+
+void FSimpleInventoryReplicatedSlot::SetSlot(const FSimpleInventorySlot& Slot) {
+    Item = Slot.Item;
+    ItemID = Slot.ItemID;
+    Count = Slot.Count;
+    bUsesDefinition = Slot.bUsesDefinition;
+}
+
+void FSimpleInventoryReplicatedSlot::GetSlot(FSimpleInventorySlot& Slot) const {
+    Slot.Item = Item;
+    Slot.ItemID = ItemID;
+    Slot.Count = Count;
+    Slot.bUsesDefinition = bUsesDefinition;
+}
+
+void FSimpleInventoryReplicatedSlot::PreReplicatedRemove(const FSimpleInventoryReplicatedSlots& InArraySerializer) {
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedSlotChanged(SlotIndex);
+    }
+}
+
+void FSimpleInventoryReplicatedSlot::PostReplicatedAdd(const FSimpleInventoryReplicatedSlots& InArraySerializer) {
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedSlotChanged(SlotIndex);
+    }
+}
+
+void FSimpleInventoryReplicatedSlot::PostReplicatedChange(const FSimpleInventoryReplicatedSlots& InArraySerializer) {
+    if (InArraySerializer.Owner) {
+        InArraySerializer.Owner->MarkReplicatedSlotChanged(SlotIndex);
+    }
+}
+
+// FSimpleInventoryReplicatedSlots
+
+/**
+ * Called on clients once every entry in a received update has been applied.
+ * Slots are rebuilt here rather than per entry, so the local inventory never sees a half-applied update.
+ */
+void FSimpleInventoryReplicatedSlots::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters) {
+    if (Owner) {
+        Owner->ApplyReplicatedSlots();
+    }
+}
@@ -2,6 +2,72 @@
 
 #include "SimpleInventorySlot.h"
 
+#include "SimpleInventoryItemAccessor.h"
+#include "SimpleInventoryItemRegistry.h"
+#include "SimpleInventoryLog.h"
+
+#include "UObject/LinkerLoad.h"
+#include "UObject/PropertyTag.h"
+
+// FSimpleInventorySlot
+
+/**
+ * Returns the item held by this slot.
+ *
+ * @return  A view of the per-instance Item, the definition for ItemID, or an invalid view if empty.
+ */
+FConstStructView FSimpleInventorySlot::GetItem() const {
+    if (Item.IsValid()) {
+        return FConstStructView(Item);
+    }
+    if (!bUsesDefinition) {
+        return FConstStructView();
+    }
+    return CapturedDefinition.IsValid() ? CapturedDefinition : FSimpleInventoryItemRegistry::Find(ItemID);
+}
+
+/**
+ * Loads a slot that was saved as a `USimpleInventorySlot` object reference, copying its item and count.
+ * A null reference loads as an empty slot.
+ *
+ * @param Tag  The saved property tag.
+ * @param Ar   The archive being loaded from.
+ * @return     True if the tag was an object reference and the slot was converted.
+ */
+bool FSimpleInventorySlot::SerializeFromMismatchedTag(const FPropertyTag& Tag, FArchive& Ar) {
+    if (Tag.Type != NAME_ObjectProperty) {
+        return false;
+    }
+    
+    UObject* Object = nullptr;
+    Ar << Object;
+    
+    USimpleInventorySlot* LegacySlot = Cast<USimpleInventorySlot>(Object);
+    if (!LegacySlot) {
+        return true;
+    }
+    
+    // The old slot may be a subobject that has not been loaded yet.
+    if (LegacySlot->HasAnyFlags(RF_NeedLoad)) {
+        if (FLinkerLoad* Linker = LegacySlot->GetLinker()) {
+            Linker->Preload(LegacySlot);
+        }
+    }
+    
+    Item = LegacySlot->Item;
+    Count = LegacySlot->Count;
+    bUsesDefinition = false;
+    
+    const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(Item.GetScriptStruct());
+    ItemID = Accessor.IsValid() ? Accessor.GetID(Item.GetMemory()) : 0;
+    
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("FSimpleInventorySlot::SerializeFromMismatchedTag || Converted %s | ItemID: %i | Count: %i"), *LegacySlot->GetName(), ItemID, Count);
+    
+    return true;
+}
+
+// USimpleInventorySlot
+
 USimpleInventorySlot::USimpleInventorySlot() {
     Count = 0;
 }
@@ -0,0 +1,101 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventorySnapshot.h"
+
+#include "Misc/ScopeLock.h"
+#include "UObject/GCObject.h"
+
+/**
+ * Reports the items of every live snapshot chunk to the garbage collector. Chunks can be released on any thread
+ * once their last snapshot is dropped, so the set of live chunks is guarded by a lock.
+ */
+class FSimpleInventorySnapshotChunkReferencer : public FGCObject
+{
+public:
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    
+    virtual FString GetReferencerName() const override {
+        return TEXT("FSimpleInventorySnapshotChunkReferencer");
+    }
+};
+
+static FCriticalSection LiveChunksLock;
+static TSet<FSimpleInventorySnapshotChunk*> LiveChunks;
+static TUniquePtr<FSimpleInventorySnapshotChunkReferencer> ChunkReferencer;
+
+/**
+ * Reports the items of every live chunk. Published chunks are never modified, so only the chunk set needs the lock.
+ *
+ * @param Collector  The reference collector.
+ */
+void FSimpleInventorySnapshotChunkReferencer::AddReferencedObjects(FReferenceCollector& Collector) {
+    FScopeLock Lock(&LiveChunksLock);
+    for (FSimpleInventorySnapshotChunk* Chunk : LiveChunks) {
+        for (FSimpleInventorySlot& Slot : Chunk->Slots) {
+            Slot.Item.AddStructReferencedObjects(Collector);
+        }
+    }
+}
+
+// FSimpleInventorySnapshotChunk
+
+FSimpleInventorySnapshotChunk::FSimpleInventorySnapshotChunk() {
+    FScopeLock Lock(&LiveChunksLock);
+    LiveChunks.Add(this);
+}
+
+FSimpleInventorySnapshotChunk::~FSimpleInventorySnapshotChunk() {
+    FScopeLock Lock(&LiveChunksLock);
+    LiveChunks.Remove(this);
+}
+
+/**
+ * Creates the referencer that reports live chunks to the garbage collector.
+ */
+void FSimpleInventorySnapshotChunk::StartReportingReferences() {
+    if (!ChunkReferencer.IsValid()) {
+        ChunkReferencer = MakeUnique<FSimpleInventorySnapshotChunkReferencer>();
+    }
+}
+
+/**
+ * Destroys the referencer. Chunks still alive afterwards no longer keep their items' objects alive.
+ */
+void FSimpleInventorySnapshotChunk::StopReportingReferences() {
+    ChunkReferencer.Reset();
+}
+
+// FSimpleInventorySnapshot
+
+/**
+ * Copies every slot into a flat array, chunk by chunk.
+ *
+ * @param OutSlots  Replaced with the snapshot's slots.
+ */
+void FSimpleInventorySnapshot::CopySlots(TArray<FSimpleInventorySlot>& OutSlots) const {
+    OutSlots.Reset(Num());
+    if (!Data.IsValid()) {
+        return;
+    }
+
+    for (const TSharedRef<const FSimpleInventorySnapshotChunk, ESPMode::ThreadSafe>& Chunk : Data->Chunks) {
+        OutSlots.Append(Chunk->Slots);
+    }
+}
+
+/**
+ * Calls Visitor with each chunk's slots without copying them.
+ *
+ * @param Visitor  Called once per chunk with its slots and the index of its first slot.
+ */
+void FSimpleInventorySnapshot::ForEachChunk(TFunctionRef<void(TConstArrayView<FSimpleInventorySlot> Slots, const int32 FirstIndex)> Visitor) const {
+    if (!Data.IsValid()) {
+        return;
+    }
+
+    int32 FirstIndex = 0;
+    for (const TSharedRef<const FSimpleInventorySnapshotChunk, ESPMode::ThreadSafe>& Chunk : Data->Chunks) {
+        Visitor(Chunk->Slots, FirstIndex);
+        FirstIndex += Chunk->Slots.Num();
+    }
+}
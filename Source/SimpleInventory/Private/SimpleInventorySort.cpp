@@ -0,0 +1,86 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventorySort.h"
+
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+// FSimpleInventoryParallelSort
+
+/**
+ * Sorts Order stably. Small arrays use Algo::StableSort directly. Large arrays are cut into one block per worker,
+ * each block is stable sorted in parallel, then neighbouring runs are merged in parallel rounds that double the
+ * run length until one run remains.
+ *
+ * @param Order  The indices to sort.
+ * @param Less   Returns true if the first index sorts before the second.
+ */
+void FSimpleInventoryParallelSort::StableSort(TArray<int32>& Order,
+                                             TFunctionRef<bool(const int32, const int32)> Less) {
+    const int32 Num = Order.Num();
+    if (Num < ParallelThreshold) {
+        Algo::StableSort(Order, Less);
+        return;
+    }
+
+    const int32 NumWorkers = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+    const int32 BlockSize = FMath::Max(MinBlockSize, FMath::DivideAndRoundUp(Num, NumWorkers));
+    const int32 NumBlocks = FMath::DivideAndRoundUp(Num, BlockSize);
+
+    ParallelFor(NumBlocks, [&Order, Less, BlockSize, Num](const int32 Block) {
+        const int32 Start = Block * BlockSize;
+        TArrayView<int32> Run(Order.GetData() + Start, FMath::Min(BlockSize, Num - Start));
+        Algo::StableSort(Run, Less);
+    });
+
+    TArray<int32> Scratch;
+    Scratch.SetNumUninitialized(Num);
+    TArray<int32>* Source = &Order;
+    TArray<int32>* Target = &Scratch;
+    for (int32 Width = BlockSize; Width < Num; Width *= 2) {
+        const int32 NumMerges = FMath::DivideAndRoundUp(Num, Width * 2);
+        ParallelFor(NumMerges, [Source, Target, Less, Width, Num](const int32 MergeIndex) {
+            const int32 Low = MergeIndex * Width * 2;
+            const int32 Mid = FMath::Min(Low + Width, Num);
+            const int32 High = FMath::Min(Low + Width * 2, Num);
+            Merge(Source->GetData(), Low, Mid, High, Target->GetData(), Less);
+        });
+        Swap(Source, Target);
+    }
+
+    if (Source != &Order) {
+        Order = MoveTemp(*Source);
+    }
+}
+
+/**
+ * Merges the sorted runs [Low, Mid) and [Mid, High) of Source into the same range of Target.
+ * Ties take the left run first, which keeps the merge stable.
+ *
+ * @param Source  The array holding both runs.
+ * @param Low     The start of the left run.
+ * @param Mid     The end of the left run and the start of the right run.
+ * @param High    The end of the right run.
+ * @param Target  The array to write the merged run to.
+ * @param Less    Returns true if the first index sorts before the second.
+ */
+void FSimpleInventoryParallelSort::Merge(const int32* Source,
+                                        const int32 Low,
+                                        const int32 Mid,
+                                        const int32 High,
+                                        int32* Target,
+                                        TFunctionRef<bool(const int32, const int32)> Less) {
+    int32 Left = Low;
+    int32 Right = Mid;
+    int32 Out = Low;
+    while (Left < Mid && Right < High) {
+        Target[Out++] = Less(Source[Right], Source[Left]) ? Source[Right++] : Source[Left++];
+    }
+    while (Left < Mid) {
+        Target[Out++] = Source[Left++];
+    }
+    while (Right < High) {
+        Target[Out++] = Source[Right++];
+    }
+}
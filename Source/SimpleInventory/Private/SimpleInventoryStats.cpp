@@ -0,0 +1,38 @@
+// Copyright Eric Downey - 2025
+
+#include "SimpleInventoryStats.h"
+
+#if SIMPLEINVENTORY_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(SimpleInventoryChannel);
+#endif
+
+DEFINE_STAT(STAT_SimpleInventory_AddItem);
+DEFINE_STAT(STAT_SimpleInventory_AddItemByID);
+DEFINE_STAT(STAT_SimpleInventory_AddItems);
+DEFINE_STAT(STAT_SimpleInventory_RemoveItemAtIndex);
+DEFINE_STAT(STAT_SimpleInventory_RemoveItems);
+DEFINE_STAT(STAT_SimpleInventory_RemoveItemsByCount);
+DEFINE_STAT(STAT_SimpleInventory_Clear);
+DEFINE_STAT(STAT_SimpleInventory_HasItem);
+DEFINE_STAT(STAT_SimpleInventory_CopyInventory);
+DEFINE_STAT(STAT_SimpleInventory_ReplaceSlots);
+DEFINE_STAT(STAT_SimpleInventory_RestoreSlots);
+DEFINE_STAT(STAT_SimpleInventory_GetSnapshot);
+DEFINE_STAT(STAT_SimpleInventory_QueryItems);
+DEFINE_STAT(STAT_SimpleInventory_SortInventory);
+DEFINE_STAT(STAT_SimpleInventory_Consolidate);
+DEFINE_STAT(STAT_SimpleInventory_TransferItems);
+DEFINE_STAT(STAT_SimpleInventory_BroadcastChange);
+
+DEFINE_STAT(STAT_SimpleInventory_SubsystemBroadcastChange);
+DEFINE_STAT(STAT_SimpleInventory_GetStorage);
+DEFINE_STAT(STAT_SimpleInventory_GetStorageDelta);
+DEFINE_STAT(STAT_SimpleInventory_InflateFromStorage);
+DEFINE_STAT(STAT_SimpleInventory_AsyncLoadTick);
+
+DEFINE_STAT(STAT_SimpleInventory_SyncReplicatedSlots);
+DEFINE_STAT(STAT_SimpleInventory_ApplyReplicatedSlots);
+
+DEFINE_STAT(STAT_SimpleInventory_NumInventories);
+DEFINE_STAT(STAT_SimpleInventory_NumSlots);
+DEFINE_STAT(STAT_SimpleInventory_NumChangeBroadcasts);
@@ -2,10 +2,19 @@
 
 #include "SimpleInventorySubsystem.h"
 
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "Tasks/Task.h"
+#include "UObject/GCObject.h"
+#include "UObject/GarbageCollection.h"
+
 #include "SimpleInventory.h"
 #include "SimpleInventoryDefinitions.h"
+#include "SimpleInventoryItemAccessor.h"
+#include "SimpleInventoryItemRegistry.h"
 #include "SimpleInventorySlot.h"
 #include "SimpleInventoryLog.h"
+#include "SimpleInventoryStats.h"
 
 // Lifecycle
 
@@ -20,6 +29,19 @@ void USimpleInventorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::Initialize"));
 }
 
+/**
+ * Stops any async load still restoring inventories.
+ */
+void USimpleInventorySubsystem::Deinitialize() {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::Deinitialize"));
+    
+    if (bIsLoadingAsync) {
+        FinishAsyncLoad(false);
+    }
+    
+    Super::Deinitialize();
+}
+
 // Public Functions
 /**
  * Retrieves a map of all registered inventories keyed by name.
@@ -27,8 +49,11 @@ void USimpleInventorySubsystem::Initialize(FSubsystemCollectionBase& Collection)
  * @param Result The output pointer to the registered inventories
  */
 void USimpleInventorySubsystem::GetAllInventories(TMap<FName, USimpleInventory*>& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::GetAllInventories");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetAllInventories"));
 
+    InflateAllPendingInventories();
+    
     TMap<FName, USimpleInventory*> AllInventories;
     for (const auto& Item : InventoryMap) {
         AllInventories.Add(Item.Key, Item.Value);
@@ -44,9 +69,10 @@ void USimpleInventorySubsystem::GetAllInventories(TMap<FName, USimpleInventory*>
  */
 void USimpleInventorySubsystem::GetInventory(const FName InventoryName,
                                              USimpleInventory*& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::GetInventory");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetInventory || Inventory: %s"), *InventoryName.ToString());
     
-    Find(InventoryName, Result);
+    FindOrInflate(InventoryName, Result);
 }
 
 /**
@@ -59,15 +85,7 @@ void USimpleInventorySubsystem::GetLength(const FName InventoryName,
                                           int32& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetLength || Inventory: %s"), *InventoryName.ToString());
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
-        Inventory->GetLength(Result);
-    }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::GetLength || Invalid Inventory: %s"), *InventoryName.ToString());
-        Result = 0;
-    }
+    GetLength(FindInventoryForCall(InventoryName, TEXT("GetLength")), Result);
 }
 
 /**
@@ -80,15 +98,7 @@ void USimpleInventorySubsystem::GetMaxSize(const FName InventoryName,
                                            int32& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetMaxSize || Inventory: %s"), *InventoryName.ToString());
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
-        Inventory->GetMaxSize(Result);
-    }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::GetMaxSize || Invalid Inventory: %s"), *InventoryName.ToString());
-        Result = 0;
-    }
+    GetMaxSize(FindInventoryForCall(InventoryName, TEXT("GetMaxSize")), Result);
 }
 
 /**
@@ -103,15 +113,7 @@ void USimpleInventorySubsystem::GetSlot(const FName InventoryName,
                                         USimpleInventorySlot*& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetSlot || Inventory: %s Index: %i"), *InventoryName.ToString(), Index);
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
-        Inventory->GetSlot(Index, Result);
-    }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::GetSlot || Invalid Inventory: %s"), *InventoryName.ToString());
-        Result = nullptr;
-    }
+    GetSlot(FindInventoryForCall(InventoryName, TEXT("GetSlot")), Index, Result);
 }
 
 /**
@@ -124,59 +126,241 @@ void USimpleInventorySubsystem::GetSlots(const FName InventoryName,
                                          TArray<USimpleInventorySlot*>& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetSlots || Inventory: %s"), *InventoryName.ToString());
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
-        Inventory->GetSlots(Result);
-    }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::GetSlots || Invalid Inventory: %s"), *InventoryName.ToString());
-        Result = TArray<USimpleInventorySlot*>();
-    }
+    GetSlots(FindInventoryForCall(InventoryName, TEXT("GetSlots")), Result);
 }
 
 /**
  * Serializes the state of all inventories managed by the subsystem.
+ * Inventories whose generation has not changed since they were last serialized reuse their cached storage.
  *
  * @param Result The output structure containing all stored inventory data.
  */
 void USimpleInventorySubsystem::GetStorage(FSimpleInventorySubsystemStorage& Result) const {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventorySubsystem::GetStorage", STAT_SimpleInventory_GetStorage);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetStorage"));
     
     TMap<FName, FSimpleInventoryStorage> Storage;
+    Storage.Reserve(InventoryMap.Num() + PendingInflation.Num());
+    int32 NumRegistered = 0;
     for (auto& Item : InventoryMap) {
-        FSimpleInventoryStorage StoredInventory = FSimpleInventoryStorage();
-        
         USimpleInventory* Inventory = Item.Value.Get();
         
         if (IsValid(Inventory)) {
-            StoredInventory.MaxSlots = Inventory->MaxSlotSize;
-            TArray<USimpleInventorySlot*> Slots;
-            Inventory->GetSlots(Slots);
-            
-            for (USimpleInventorySlot* Slot : Slots) {
-                if (IsValid(Slot)) {
-                    FSimpleInventorySlotStorage StoredSlot = FSimpleInventorySlotStorage();
-                    StoredSlot.Metadata = Slot->Item;
-                    StoredSlot.Count = Slot->Count;
-                    
-                    StoredInventory.StoredSlots.Add(StoredSlot);
-                }
-                else {
-                    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetStorage || Found invalid InventorySlot"));
-                }
-            }
-            
-            Storage.Add(Item.Key, StoredInventory);
+            Storage.Add(Item.Key, GetCachedStorage(Item.Key, Inventory));
+            ++NumRegistered;
         }
         else {
             UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetStorage || Found invalid Inventory"));
         }
     }
     
-    FSimpleInventorySubsystemStorage SubsystemStorage;
-    SubsystemStorage.Value = Storage;
-    Result = SubsystemStorage;
+    // Drop cached storage of inventories that are no longer registered.
+    if (StorageCache.Num() > NumRegistered) {
+        for (auto It = StorageCache.CreateIterator(); It; ++It) {
+            const TObjectPtr<USimpleInventory>* Inventory = InventoryMap.Find(It.Key());
+            if (!Inventory || !IsValid(*Inventory)) {
+                It.RemoveCurrent();
+            }
+        }
+    }
+    
+    // Inventories that were never touched since a lazy load are written back as they were loaded.
+    for (const auto& Item : PendingInflation) {
+        Storage.Add(Item.Key, Item.Value);
+    }
+    
+    Result.Value = MoveTemp(Storage);
+}
+
+/**
+ * Serializes only the inventories whose generation changed since the previous call, and lists removed inventories.
+ *
+ * @param Result  The changed and removed inventories.
+ */
+void USimpleInventorySubsystem::GetStorageDelta(FSimpleInventorySubsystemStorageDelta& Result) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventorySubsystem::GetStorageDelta", STAT_SimpleInventory_GetStorageDelta);
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetStorageDelta"));
+    
+    Result.Changed.Reset();
+    Result.Removed.Reset();
+    
+    for (auto& Item : InventoryMap) {
+        USimpleInventory* Inventory = Item.Value.Get();
+        if (!IsValid(Inventory)) {
+            continue;
+        }
+        
+        const TPair<TWeakObjectPtr<USimpleInventory>, uint64>* Previous = DeltaGenerations.Find(Item.Key);
+        const FCachedInventoryStorage* Cached = StorageCache.Find(Item.Key);
+        if (Previous && Cached && Previous->Key.Get() == Inventory && Previous->Value == Inventory->GetGeneration()
+            && Cached->Storage.MaxSlots == Inventory->MaxSlotSize) {
+            continue;
+        }
+        
+        Result.Changed.Add(Item.Key, GetCachedStorage(Item.Key, Inventory));
+        DeltaGenerations.Add(Item.Key, TPair<TWeakObjectPtr<USimpleInventory>, uint64>(Inventory, Inventory->GetGeneration()));
+    }
+    
+    // Pending inventories are tracked without an inventory; once inflated, the pointer no longer matches.
+    for (const auto& Item : PendingInflation) {
+        const TPair<TWeakObjectPtr<USimpleInventory>, uint64>* Previous = DeltaGenerations.Find(Item.Key);
+        if (Previous && Previous->Key.IsExplicitlyNull()) {
+            continue;
+        }
+        
+        Result.Changed.Add(Item.Key, Item.Value);
+        DeltaGenerations.Add(Item.Key, TPair<TWeakObjectPtr<USimpleInventory>, uint64>(nullptr, 0));
+    }
+    
+    for (auto It = DeltaGenerations.CreateIterator(); It; ++It) {
+        const TObjectPtr<USimpleInventory>* Inventory = InventoryMap.Find(It.Key());
+        if ((!Inventory || !IsValid(*Inventory)) && !PendingInflation.Contains(It.Key())) {
+            Result.Removed.Add(It.Key());
+            StorageCache.Remove(It.Key());
+            It.RemoveCurrent();
+        }
+    }
+    
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetStorageDelta || Changed: %i | Removed: %i"), Result.Changed.Num(), Result.Removed.Num());
+}
+
+/**
+ * Keeps the object references of a storage snapshot alive while a worker task serializes or deserializes it.
+ * Created and destroyed on the game thread.
+ */
+class FSimpleInventoryStorageSnapshot : public FGCObject
+{
+public:
+    FSimpleInventorySubsystemStorage Storage;
+    
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override {
+        Collector.AddPropertyReferencesWithStructARO(FSimpleInventorySubsystemStorage::StaticStruct(), &Storage);
+    }
+    
+    virtual FString GetReferencerName() const override {
+        return TEXT("FSimpleInventoryStorageSnapshot");
+    }
+};
+
+/**
+ * Saves all inventories on a worker task.
+ *
+ * @param OnComplete  Called with the result and the saved bytes.
+ */
+void USimpleInventorySubsystem::SaveStorageAsync(const FOnSimpleInventorySaveCompleteDelegate& OnComplete) {
+    SaveStorageAsyncNative(FOnSimpleInventorySaveCompleteNativeDelegate::CreateLambda([OnComplete](bool bSuccess, const TArray<uint8>& SaveData) {
+        OnComplete.ExecuteIfBound(bSuccess, SaveData);
+    }));
+}
+
+/**
+ * Snapshots the storage on the game thread, then serializes and compresses it on a worker task.
+ *
+ * @param OnComplete  Called on the game thread with the result and the saved bytes.
+ */
+void USimpleInventorySubsystem::SaveStorageAsyncNative(FOnSimpleInventorySaveCompleteNativeDelegate OnComplete) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::SaveStorageAsyncNative");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::SaveStorageAsync"));
+    
+    // Unchanged inventories come from the storage cache, so the snapshot is mostly a copy.
+    TSharedPtr<FSimpleInventoryStorageSnapshot> Snapshot = MakeShared<FSimpleInventoryStorageSnapshot>();
+    GetStorage(Snapshot->Storage);
+    
+    // The worker reads item IDs through the accessor cache. Resolving every struct here leaves it only cache hits,
+    // so it never walks a struct's properties while the game thread may be reinstancing it.
+    TSet<const UScriptStruct*> StructTypes;
+    for (const auto& Inventory : Snapshot->Storage.Value) {
+        for (const FSimpleInventorySlotStorage& StoredSlot : Inventory.Value.StoredSlots) {
+            StructTypes.Add(StoredSlot.Metadata.GetScriptStruct());
+        }
+    }
+    for (const UScriptStruct* StructType : StructTypes) {
+        FSimpleInventoryItemAccessorCache::Get(StructType);
+    }
+    
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot = MoveTemp(Snapshot), OnComplete = MoveTemp(OnComplete)]() mutable {
+        SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::SaveStorageAsync Worker");
+        TArray<uint8> SaveData;
+        const bool bSuccess = Snapshot->Storage.SaveToCompressedBytes(SaveData);
+        
+        // The snapshot moves along so it is released on the game thread.
+        AsyncTask(ENamedThreads::GameThread, [Snapshot = MoveTemp(Snapshot), OnComplete = MoveTemp(OnComplete), SaveData = MoveTemp(SaveData), bSuccess]() {
+            UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::SaveStorageAsync || Complete: %i | Bytes: %i"), bSuccess, SaveData.Num());
+            OnComplete.ExecuteIfBound(bSuccess, SaveData);
+        });
+    });
+}
+
+/**
+ * Loads inventories from saved bytes, deserializing on a worker task.
+ *
+ * @param SaveData    The saved bytes.
+ * @param OnComplete  Called once every inventory is restored, or the load failed.
+ */
+void USimpleInventorySubsystem::LoadStorageAsync(const TArray<uint8>& SaveData,
+                                                 const FOnSimpleInventoryLoadCompleteDelegate& OnComplete) {
+    LoadStorageAsyncNative(SaveData, FOnSimpleInventoryLoadCompleteNativeDelegate::CreateLambda([OnComplete](bool bSuccess) {
+        OnComplete.ExecuteIfBound(bSuccess);
+    }));
+}
+
+/**
+ * Decompresses and deserializes the saved bytes on a worker task, then restores the inventories on the game thread
+ * within AsyncLoadFrameBudgetMs per frame.
+ *
+ * @param SaveData    The saved bytes.
+ * @param OnComplete  Called on the game thread once every inventory is restored, or the load failed.
+ */
+void USimpleInventorySubsystem::LoadStorageAsyncNative(TArray<uint8> SaveData,
+                                                       FOnSimpleInventoryLoadCompleteNativeDelegate OnComplete) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::LoadStorageAsyncNative");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::LoadStorageAsync || Bytes: %i"), SaveData.Num());
+    
+    if (bIsLoadingAsync) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::LoadStorageAsync || A load is already in progress"));
+        OnComplete.ExecuteIfBound(false);
+        return;
+    }
+    
+    bIsLoadingAsync = true;
+    PendingLoadComplete = MoveTemp(OnComplete);
+    
+    // The loaded storage is reported to GC from the moment the worker has filled it until the game thread takes it.
+    TSharedPtr<FSimpleInventoryStorageSnapshot> Loaded = MakeShared<FSimpleInventoryStorageSnapshot>();
+    
+    TWeakObjectPtr<USimpleInventorySubsystem> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Loaded = MoveTemp(Loaded), SaveData = MoveTemp(SaveData)]() mutable {
+        SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::LoadStorageAsync Worker");
+        bool bSuccess = false;
+        {
+            // No GC may run while objects are resolved into the storage and before it is complete enough to be scanned.
+            FGCScopeGuard GCGuard;
+            bSuccess = Loaded->Storage.LoadFromCompressedBytes(SaveData);
+        }
+        
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Loaded = MoveTemp(Loaded), bSuccess]() mutable {
+            USimpleInventorySubsystem* This = WeakThis.Get();
+            if (!This || !This->bIsLoadingAsync) {
+                return;
+            }
+            
+            if (bSuccess) {
+                This->BeginApplyingLoad(MoveTemp(Loaded->Storage));
+            }
+            else {
+                This->FinishAsyncLoad(false);
+            }
+        });
+    });
+}
+
+/**
+ * Checks whether a LoadStorageAsync call is still in progress.
+ *
+ * @return True until the load's completion delegate has been called.
+ */
+bool USimpleInventorySubsystem::IsLoadingAsync() const {
+    return bIsLoadingAsync;
 }
 
 /**
@@ -193,15 +377,86 @@ void USimpleInventorySubsystem::HasItem(const FName InventoryName,
                                         bool& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::HasItem || Inventory: %s | ItemID: %i | Count: %i"), *InventoryName.ToString(), ItemID, Count);
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
-        Inventory->HasItem(ItemID, Count, Result);
-    }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::HasItem || Invalid Inventory: %s"), *InventoryName.ToString());
-        Result = false;
-    }
+    HasItem(FindInventoryForCall(InventoryName, TEXT("HasItem")), ItemID, Count, Result);
+}
+
+/**
+ * Gets the total amount of an item across all slots of an inventory.
+ *
+ * @param InventoryName  The name of the inventory to check.
+ * @param ItemID         The ID of the item.
+ * @param Result         The total count, or 0 if the item or the inventory does not exist.
+ */
+void USimpleInventorySubsystem::GetItemCount(const FName InventoryName,
+                                             const int32 ItemID,
+                                             int32& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetItemCount || Inventory: %s | ItemID: %i"), *InventoryName.ToString(), ItemID);
+    
+    GetItemCount(FindInventoryForCall(InventoryName, TEXT("GetItemCount")), ItemID, Result);
+}
+
+/**
+ * Checks if an inventory holds at least Count of an item across all slots.
+ *
+ * @param InventoryName  The name of the inventory to check.
+ * @param ItemID         The ID of the item.
+ * @param Count          The minimum quantity required.
+ * @param Result         True if the inventory holds at least Count of the item.
+ */
+void USimpleInventorySubsystem::HasAtLeast(const FName InventoryName,
+                                           const int32 ItemID,
+                                           const int32 Count,
+                                           bool& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::HasAtLeast || Inventory: %s | ItemID: %i | Count: %i"), *InventoryName.ToString(), ItemID, Count);
+    
+    HasAtLeast(FindInventoryForCall(InventoryName, TEXT("HasAtLeast")), ItemID, Count, Result);
+}
+
+/**
+ * Gets the slots of an inventory holding an item of a struct type or any struct derived from it.
+ *
+ * @param InventoryName  The name of the inventory to search.
+ * @param StructType     The item struct type.
+ * @param Result         The indices of the matching slots, ascending.
+ */
+void USimpleInventorySubsystem::GetSlotsOfType(const FName InventoryName,
+                                               const UScriptStruct* StructType,
+                                               TArray<int32>& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetSlotsOfType || Inventory: %s | StructType: %s"), *InventoryName.ToString(), *GetNameSafe(StructType));
+    
+    GetSlotsOfType(FindInventoryForCall(InventoryName, TEXT("GetSlotsOfType")), StructType, Result);
+}
+
+/**
+ * Finds the slots of an inventory whose items match a query.
+ *
+ * @param InventoryName  The name of the inventory to search.
+ * @param Query          The struct type and property conditions to match.
+ * @param Result         The indices of the matching slots, ascending.
+ */
+void USimpleInventorySubsystem::QueryItems(const FName InventoryName,
+                                           const FSimpleInventoryQuery& Query,
+                                           TArray<int32>& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::QueryItems");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::QueryItems || Inventory: %s"), *InventoryName.ToString());
+    
+    const FSimpleInventoryCompiledQuery CompiledQuery(Query);
+    QueryItemsCompiled(InventoryName, CompiledQuery, Result);
+}
+
+/**
+ * Finds the slots of an inventory whose items match a compiled query.
+ *
+ * @param InventoryName  The name of the inventory to search.
+ * @param Query          The compiled query.
+ * @param Result         The indices of the matching slots, ascending.
+ */
+void USimpleInventorySubsystem::QueryItemsCompiled(const FName InventoryName,
+                                                   const FSimpleInventoryCompiledQuery& Query,
+                                                   TArray<int32>& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::QueryItemsCompiled || Inventory: %s"), *InventoryName.ToString());
+    
+    QueryItemsCompiled(FindInventoryForCall(InventoryName, TEXT("QueryItemsCompiled")), Query, Result);
 }
 
 /**
@@ -217,6 +472,7 @@ void USimpleInventorySubsystem::HasItem(const FName InventoryName,
  *                     one or more inventory definitions to register.
  */
 void USimpleInventorySubsystem::RegisterInventoryDefinitions(USimpleInventoryDefinitions* Definitions) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::RegisterInventoryDefinitions");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::%s"), *FString(__FUNCTION__));
 
     if (!Definitions) {
@@ -233,14 +489,51 @@ void USimpleInventorySubsystem::RegisterInventoryDefinitions(USimpleInventoryDef
         USimpleInventory* NewInventory = NewObject<USimpleInventory>(this);
         NewInventory->InventoryName = Definition.InventoryName;
         NewInventory->MaxSlotSize = Definition.MaxSlots;
-        NewInventory->OnInventoryChangeEvent.AddDynamic(this, &USimpleInventorySubsystem::HandleOnChangeEvent);
-
-        InventoryMap.Add(Definition.InventoryName, NewInventory);
+        AddInventory(Definition.InventoryName, NewInventory);
 
         UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::%s || Registered Inventory '%s'"), *FString(__FUNCTION__), *Definition.InventoryName.ToString());
     }
 }
 
+/**
+ * Registers every row of a DataTable of `FSimpleInventoryItem` rows as a shared item definition.
+ *
+ * @param ItemTable  The DataTable to register.
+ */
+void USimpleInventorySubsystem::RegisterItemDefinitions(UDataTable* ItemTable) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::RegisterItemDefinitions");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::RegisterItemDefinitions"));
+    
+    FSimpleInventoryItemRegistry::Register(ItemTable);
+}
+
+/**
+ * Removes a DataTable previously passed to RegisterItemDefinitions.
+ *
+ * @param ItemTable  The DataTable to remove.
+ */
+void USimpleInventorySubsystem::UnregisterItemDefinitions(UDataTable* ItemTable) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::UnregisterItemDefinitions");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::UnregisterItemDefinitions"));
+    
+    FSimpleInventoryItemRegistry::Unregister(ItemTable);
+}
+
+/**
+ * Copies the registered definition for an item ID.
+ *
+ * @param ItemID  The item ID.
+ * @param Result  The definition, or an empty struct if the ID is not registered.
+ */
+void USimpleInventorySubsystem::GetItemDefinition(const int32 ItemID,
+                                                  FInstancedStruct& Result) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::GetItemDefinition");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetItemDefinition || ItemID: %i"), ItemID);
+    
+    const FConstStructView Definition = FSimpleInventoryItemRegistry::Find(ItemID);
+    Result.InitializeAs(Definition.GetScriptStruct(), Definition.GetMemory());
+}
+
 /**
  * Registers a new inventory with the given name and maximum slot count.
  * If it already exists, returns the existing inventory.
@@ -252,24 +545,110 @@ void USimpleInventorySubsystem::RegisterInventoryDefinitions(USimpleInventoryDef
 void USimpleInventorySubsystem::RegisterInventory(const FName InventoryName,
                                                   const int32 MaxSlots,
                                                   USimpleInventory*& Result) {
+    FSimpleInventoryHandle Handle;
+    RegisterInventory(InventoryName, MaxSlots, Result, Handle);
+}
+
+/**
+ * Registers a new inventory with the given name and maximum slot count, and returns its handle.
+ * If it already exists, returns the existing inventory and its handle.
+ *
+ * @param InventoryName  The identifier for the inventory.
+ * @param MaxSlots       The maximum number of slots for this inventory.
+ * @param Result         The registered or existing inventory instance.
+ * @param Handle         The inventory's handle.
+ */
+void USimpleInventorySubsystem::RegisterInventory(const FName InventoryName,
+                                                  const int32 MaxSlots,
+                                                  USimpleInventory*& Result,
+                                                  FSimpleInventoryHandle& Handle) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::RegisterInventory");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::RegisterInventory || Inventory: %s | MaxSlots: %i"), *InventoryName.ToString(), MaxSlots);
     
     USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
+    FindOrInflate(InventoryName, Inventory);
     if (!Inventory) {
         USimpleInventory* NewInventory = NewObject<USimpleInventory>(this);
         NewInventory->InventoryName = InventoryName;
         NewInventory->MaxSlotSize = MaxSlots;
-        InventoryMap.Add(InventoryName, NewInventory);
-        NewInventory->OnInventoryChangeEvent.AddDynamic(this, &USimpleInventorySubsystem::HandleOnChangeEvent);
+        Handle = AddInventory(InventoryName, NewInventory);
 
         Result = NewInventory;
     }
     else {
+        FindHandle(InventoryName, Handle);
         Result = Inventory;
     }
 }
 
+/**
+ * Removes an inventory from the subsystem and frees its handle. An inventory still pending a lazy load is dropped
+ * together with its saved storage.
+ *
+ * @param InventoryName  The identifier for the inventory.
+ */
+void USimpleInventorySubsystem::UnregisterInventory(const FName InventoryName) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::UnregisterInventory");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::UnregisterInventory || Inventory: %s"), *InventoryName.ToString());
+    
+    const bool bWasPending = PendingInflation.Remove(InventoryName) > 0;
+    
+    TObjectPtr<USimpleInventory> Inventory;
+    if (InventoryMap.RemoveAndCopyValue(InventoryName, Inventory)) {
+        if (Inventory) {
+            Inventory->OnInventoryChangeNative.RemoveAll(this);
+        }
+    }
+    else if (!bWasPending) {
+        UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventorySubsystem::UnregisterInventory || Inventory '%s' is not registered"), *InventoryName.ToString());
+    }
+    
+    ReleaseHandle(InventoryName);
+}
+
+/**
+ * Returns the handle of a registered inventory. Inventories added to InventoryMap directly get a handle on first request.
+ *
+ * @param InventoryName  The identifier for the inventory.
+ * @param Result         The inventory's handle, or an unset handle if it is not registered.
+ */
+void USimpleInventorySubsystem::FindHandle(const FName InventoryName,
+                                           FSimpleInventoryHandle& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::FindHandle");
+    
+    USimpleInventory* Inventory;
+    FindOrInflate(InventoryName, Inventory);
+    if (!Inventory) {
+        Result = FSimpleInventoryHandle();
+        return;
+    }
+    
+    const FSimpleInventoryHandle* Handle = HandlesByName.Find(InventoryName);
+    if (Handle && ResolveHandle(*Handle) == Inventory) {
+        Result = *Handle;
+        return;
+    }
+    
+    // The map entry was replaced directly; the old handle no longer refers to this name's inventory.
+    ReleaseHandle(InventoryName);
+    Result = IssueHandle(InventoryName, Inventory);
+}
+
+/**
+ * Looks up the inventory at a handle's index and checks the handle's serial against the current registration.
+ *
+ * @param Handle  The handle to resolve.
+ * @return        The inventory, or nullptr if the handle is stale or was never issued.
+ */
+USimpleInventory* USimpleInventorySubsystem::ResolveHandle(const FSimpleInventoryHandle Handle) const {
+    if (!HandleInventories.IsValidIndex(Handle.Index) || HandleSerials[Handle.Index] != Handle.Serial) {
+        return nullptr;
+    }
+    
+    USimpleInventory* Inventory = HandleInventories[Handle.Index];
+    return IsValid(Inventory) ? Inventory : nullptr;
+}
+
 /**
  * Adds an item to the specified inventory.
  *
@@ -284,15 +663,24 @@ void USimpleInventorySubsystem::AddItem(const FName InventoryName,
                                         bool& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::AddItem || Inventory: %s | Count: %i"), *InventoryName.ToString(), Count);
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
-        Inventory->AddItem(Item, Count, Result);
-    }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::AddItem || Invalid Inventory: %s"), *InventoryName.ToString());
-        Result = false;
-    }
+    AddItem(FindInventoryForCall(InventoryName, TEXT("AddItem")), MoveTemp(Item), Count, Result);
+}
+
+/**
+ * Adds an item by ID to the specified inventory, using its registered definition.
+ *
+ * @param InventoryName The identifier for the inventory.
+ * @param ItemID The ID of a registered item definition.
+ * @param Count The number of times to add the item.
+ * @param Result True if the item was added successfully.
+ */
+void USimpleInventorySubsystem::AddItemByID(const FName InventoryName,
+                                            const int32 ItemID,
+                                            const int32 Count,
+                                            bool& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::AddItemByID || Inventory: %s | ItemID: %i | Count: %i"), *InventoryName.ToString(), ItemID, Count);
+    
+    AddItemByID(FindInventoryForCall(InventoryName, TEXT("AddItemByID")), ItemID, Count, Result);
 }
 
 /**
@@ -309,9 +697,7 @@ void USimpleInventorySubsystem::RemoveItemAtIndex(const FName InventoryName,
                                                   bool& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::RemoveItemAtIndex || Inventory: %s | Index: %i | Count: %i"), *InventoryName.ToString(), Index, Count);
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    Inventory->RemoveItemAtIndex(Index, Count, Result);
+    RemoveItemAtIndex(FindInventoryForCall(InventoryName, TEXT("RemoveItemAtIndex")), Index, Count, Result);
 }
 
 /**
@@ -326,26 +712,97 @@ void USimpleInventorySubsystem::RemoveItems(const FName InventoryName,
                                             bool& Result) {
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::RemoveItems || Inventory: %s"), *InventoryName.ToString());
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    Inventory->RemoveItems(Items, Result);
+    RemoveItems(FindInventoryForCall(InventoryName, TEXT("RemoveItems")), Items, Result);
 }
 
 /**
- * Clears all items from a specified inventory.
+ * Adds several items to the specified inventory in one batch.
  *
- * @param InventoryName The identifier for the inventory to clear.
+ * @param InventoryName The identifier for the inventory.
+ * @param Entries The items and amounts to add.
+ * @param bAllOrNothing If true, nothing is added unless every entry fits.
+ * @param EntryResults True for each entry that was fully added.
+ * @param Result True if every entry was fully added.
  */
-void USimpleInventorySubsystem::Clear(const FName InventoryName) {
-    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::Clear || Inventory: %s"), *InventoryName.ToString());
+void USimpleInventorySubsystem::AddItems(const FName InventoryName,
+                                         const TArray<FSimpleInventoryItemEntry>& Entries,
+                                         const bool bAllOrNothing,
+                                         TArray<bool>& EntryResults,
+                                         bool& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::AddItems || Inventory: %s | Entries: %i"), *InventoryName.ToString(), Entries.Num());
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
-        Inventory->Clear();
-    }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::Clear || Invalid Inventory: %s"), *InventoryName.ToString());
+    AddItems(FindInventoryForCall(InventoryName, TEXT("AddItems")), Entries, bAllOrNothing, EntryResults, Result);
+}
+
+/**
+ * Removes amounts of several items by ID from the specified inventory in one batch.
+ *
+ * @param InventoryName The identifier for the inventory.
+ * @param Entries The item IDs and amounts to remove.
+ * @param bAllOrNothing If true, nothing is removed unless every entry can be fully removed.
+ * @param EntryResults True for each entry that was fully removed.
+ * @param Result True if every entry was fully removed.
+ */
+void USimpleInventorySubsystem::RemoveItemsByCount(const FName InventoryName,
+                                                   const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                                                   const bool bAllOrNothing,
+                                                   TArray<bool>& EntryResults,
+                                                   bool& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::RemoveItemsByCount || Inventory: %s | Entries: %i"), *InventoryName.ToString(), Entries.Num());
+    
+    RemoveItemsByCount(FindInventoryForCall(InventoryName, TEXT("RemoveItemsByCount")), Entries, bAllOrNothing, EntryResults, Result);
+}
+
+/**
+ * Moves items from a slot of one inventory into another.
+ *
+ * @param FromInventoryName The identifier for the inventory to move items out of.
+ * @param SlotIndex The slot to move items out of.
+ * @param ToInventoryName The identifier for the inventory to move items into.
+ * @param Count The quantity to move.
+ * @param Result True if the items were moved.
+ */
+void USimpleInventorySubsystem::TransferItems(const FName FromInventoryName,
+                                              const int32 SlotIndex,
+                                              const FName ToInventoryName,
+                                              const int32 Count,
+                                              bool& Result) {
+    FSimpleInventoryTransferEntry Entry;
+    Entry.SlotIndex = SlotIndex;
+    Entry.Count = Count;
+    TransferItemsBatch(FromInventoryName, { Entry }, ToInventoryName, Result);
+}
+
+/**
+ * Moves items from several slots of one inventory into another, all or nothing.
+ *
+ * @param FromInventoryName The identifier for the inventory to move items out of.
+ * @param Entries The slots and quantities to move.
+ * @param ToInventoryName The identifier for the inventory to move items into.
+ * @param Result True if every entry was moved.
+ */
+void USimpleInventorySubsystem::TransferItemsBatch(const FName FromInventoryName,
+                                                   const TArray<FSimpleInventoryTransferEntry>& Entries,
+                                                   const FName ToInventoryName,
+                                                   bool& Result) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::TransferItems || From: %s | To: %s | Entries: %i"), *FromInventoryName.ToString(), *ToInventoryName.ToString(), Entries.Num());
+    
+    USimpleInventory* FromInventory = FindInventoryForCall(FromInventoryName, TEXT("TransferItems"));
+    USimpleInventory* ToInventory = FindInventoryForCall(ToInventoryName, TEXT("TransferItems"));
+    TransferItemsBatch(FromInventory, Entries, ToInventory, Result);
+}
+
+/**
+ * Clears all items from a specified inventory.
+ *
+ * @param InventoryName The identifier for the inventory to clear.
+ */
+void USimpleInventorySubsystem::Clear(const FName InventoryName) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::Clear");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::Clear || Inventory: %s"), *InventoryName.ToString());
+    
+    if (USimpleInventory* Inventory = FindInventoryForCall(InventoryName, TEXT("Clear"))) {
+        Inventory->Clear();
     }
 }
 
@@ -353,8 +810,11 @@ void USimpleInventorySubsystem::Clear(const FName InventoryName) {
  * Clears all inventories managed by this subsystem.
  */
 void USimpleInventorySubsystem::ClearAll() {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::ClearAll");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::ClearAll"));
     
+    InflateAllPendingInventories();
+    
     for (auto& Item : InventoryMap) {
         auto Inventory = Item.Value.Get();
         if (IsValid(Inventory)) {
@@ -371,16 +831,12 @@ void USimpleInventorySubsystem::ClearAll() {
  */
 void USimpleInventorySubsystem::CopyInventory(const FName InventoryName,
                                               const USimpleInventory* OtherInventory) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::CopyInventory");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::CopyInventory || Inventory: %s"), *InventoryName.ToString());
     
-    USimpleInventory* Inventory;
-    Find(InventoryName, Inventory);
-    if (IsValid(Inventory)) {
+    if (USimpleInventory* Inventory = FindInventoryForCall(InventoryName, TEXT("CopyInventory"))) {
         Inventory->CopyInventory(OtherInventory);
     }
-    else {
-        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::CopyInventory || Invalid Inventory: %s"), *InventoryName.ToString());
-    }
 }
 
 /**
@@ -389,8 +845,15 @@ void USimpleInventorySubsystem::CopyInventory(const FName InventoryName,
  * @param InventoryName The identifier for the inventory.
  */
 void USimpleInventorySubsystem::ForceOnChange(const FName InventoryName) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::ForceOnChange");
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::ForceOnChange || Inventory: %s"), *InventoryName.ToString());
     
+    if (IsInventoryPendingInflation(InventoryName)) {
+        // Restoring it broadcasts a LOAD change on first access anyway.
+        UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::ForceOnChange || %s is not restored yet"), *InventoryName.ToString());
+        return;
+    }
+    
     USimpleInventory* Inventory;
     Find(InventoryName, Inventory);
     if (IsValid(Inventory)) {
@@ -401,40 +864,784 @@ void USimpleInventorySubsystem::ForceOnChange(const FName InventoryName) const {
     }
 }
 
+/**
+ * Opens a batch on the specified inventory.
+ *
+ * @param InventoryName The identifier for the inventory.
+ */
+void USimpleInventorySubsystem::BeginBatch(const FName InventoryName) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::BeginBatch");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::BeginBatch || Inventory: %s"), *InventoryName.ToString());
+    
+    if (USimpleInventory* Inventory = FindInventoryForCall(InventoryName, TEXT("BeginBatch"))) {
+        Inventory->BeginBatch();
+    }
+}
+
+/**
+ * Closes a batch on the specified inventory, broadcasting its merged change.
+ *
+ * @param InventoryName The identifier for the inventory.
+ */
+void USimpleInventorySubsystem::EndBatch(const FName InventoryName) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::EndBatch");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::EndBatch || Inventory: %s"), *InventoryName.ToString());
+    
+    if (USimpleInventory* Inventory = FindInventoryForCall(InventoryName, TEXT("EndBatch"))) {
+        Inventory->EndBatch();
+    }
+}
+
 /**
  * Restores Inventories from a saved storage struct.
  * @param Storage - Struct containing saved Inventory data
  */
 void USimpleInventorySubsystem::InflateFromStorage(const FSimpleInventorySubsystemStorage Storage) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventorySubsystem::InflateFromStorage", STAT_SimpleInventory_InflateFromStorage);
     UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::InflateFromStorage"));
     
     for (auto& Item : Storage.Value) {
-        USimpleInventory* NewInventory;
-        Find(Item.Key, NewInventory);
-        
-        if (!NewInventory) {
-            RegisterInventory(Item.Key, Item.Value.MaxSlots, NewInventory);
+        InflateInventory(Item.Key, Item.Value);
+    }
+}
+
+/**
+ * Restores registered inventories from storage immediately and keeps the storage of the others
+ * until a subsystem function first touches them.
+ *
+ * @param Storage - Struct containing saved Inventory data
+ */
+void USimpleInventorySubsystem::InflateFromStorageLazy(const FSimpleInventorySubsystemStorage& Storage) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::InflateFromStorageLazy");
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::InflateFromStorageLazy || Inventories: %i"), Storage.Value.Num());
+    
+    for (auto& Item : Storage.Value) {
+        const TObjectPtr<USimpleInventory>* Inventory = InventoryMap.Find(Item.Key);
+        if (Inventory && IsValid(*Inventory)) {
+            InflateInventory(Item.Key, Item.Value);
         }
-        NewInventory->Clear();
-        
-        NewInventory->MaxSlotSize = Item.Value.MaxSlots;
-        for (FSimpleInventorySlotStorage StoredSlot : Item.Value.StoredSlots) {
-            bool Result = false;
-            NewInventory->AddItem(StoredSlot.Metadata, StoredSlot.Count, Result);
+        else {
+            PendingInflation.Add(Item.Key, Item.Value);
         }
     }
 }
 
+/**
+ * Checks whether an inventory is still waiting to be restored from a lazy load.
+ *
+ * @param InventoryName The identifier for the inventory.
+ * @return True if the inventory only holds its saved storage.
+ */
+bool USimpleInventorySubsystem::IsInventoryPendingInflation(const FName InventoryName) const {
+    return PendingInflation.Contains(InventoryName);
+}
+
+// Handle Functions
+// Each resolves its inventory through ResolveHandleForCall and forwards to the same helper as its FName version.
+
+void USimpleInventorySubsystem::GetInventory(const FSimpleInventoryHandle Handle,
+                                             USimpleInventory*& Result) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::GetInventory");
+    
+    Result = ResolveHandle(Handle);
+}
+
+void USimpleInventorySubsystem::GetLength(const FSimpleInventoryHandle Handle,
+                                          int32& Result) const {
+    GetLength(ResolveHandleForCall(Handle, TEXT("GetLength")), Result);
+}
+
+void USimpleInventorySubsystem::GetMaxSize(const FSimpleInventoryHandle Handle,
+                                           int32& Result) const {
+    GetMaxSize(ResolveHandleForCall(Handle, TEXT("GetMaxSize")), Result);
+}
+
+void USimpleInventorySubsystem::GetSlot(const FSimpleInventoryHandle Handle,
+                                        const int32 Index,
+                                        USimpleInventorySlot*& Result) const {
+    GetSlot(ResolveHandleForCall(Handle, TEXT("GetSlot")), Index, Result);
+}
+
+void USimpleInventorySubsystem::GetSlots(const FSimpleInventoryHandle Handle,
+                                         TArray<USimpleInventorySlot*>& Result) const {
+    GetSlots(ResolveHandleForCall(Handle, TEXT("GetSlots")), Result);
+}
+
+void USimpleInventorySubsystem::HasItem(const FSimpleInventoryHandle Handle,
+                                        const int32 ItemID,
+                                        const int32 Count,
+                                        bool& Result) const {
+    HasItem(ResolveHandleForCall(Handle, TEXT("HasItem")), ItemID, Count, Result);
+}
+
+void USimpleInventorySubsystem::GetItemCount(const FSimpleInventoryHandle Handle,
+                                             const int32 ItemID,
+                                             int32& Result) const {
+    GetItemCount(ResolveHandleForCall(Handle, TEXT("GetItemCount")), ItemID, Result);
+}
+
+void USimpleInventorySubsystem::HasAtLeast(const FSimpleInventoryHandle Handle,
+                                           const int32 ItemID,
+                                           const int32 Count,
+                                           bool& Result) const {
+    HasAtLeast(ResolveHandleForCall(Handle, TEXT("HasAtLeast")), ItemID, Count, Result);
+}
+
+void USimpleInventorySubsystem::GetSlotsOfType(const FSimpleInventoryHandle Handle,
+                                               const UScriptStruct* StructType,
+                                               TArray<int32>& Result) const {
+    GetSlotsOfType(ResolveHandleForCall(Handle, TEXT("GetSlotsOfType")), StructType, Result);
+}
+
+void USimpleInventorySubsystem::QueryItems(const FSimpleInventoryHandle Handle,
+                                           const FSimpleInventoryQuery& Query,
+                                           TArray<int32>& Result) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::QueryItems");
+    
+    const FSimpleInventoryCompiledQuery CompiledQuery(Query);
+    QueryItemsCompiled(Handle, CompiledQuery, Result);
+}
+
+void USimpleInventorySubsystem::QueryItemsCompiled(const FSimpleInventoryHandle Handle,
+                                                   const FSimpleInventoryCompiledQuery& Query,
+                                                   TArray<int32>& Result) const {
+    QueryItemsCompiled(ResolveHandleForCall(Handle, TEXT("QueryItemsCompiled")), Query, Result);
+}
+
+void USimpleInventorySubsystem::AddItem(const FSimpleInventoryHandle Handle,
+                                        FInstancedStruct Item,
+                                        const int32 Count,
+                                        bool& Result) {
+    AddItem(ResolveHandleForCall(Handle, TEXT("AddItem")), MoveTemp(Item), Count, Result);
+}
+
+void USimpleInventorySubsystem::AddItemByID(const FSimpleInventoryHandle Handle,
+                                            const int32 ItemID,
+                                            const int32 Count,
+                                            bool& Result) {
+    AddItemByID(ResolveHandleForCall(Handle, TEXT("AddItemByID")), ItemID, Count, Result);
+}
+
+void USimpleInventorySubsystem::RemoveItemAtIndex(const FSimpleInventoryHandle Handle,
+                                                  const int32 Index,
+                                                  const int32 Count,
+                                                  bool& Result) {
+    RemoveItemAtIndex(ResolveHandleForCall(Handle, TEXT("RemoveItemAtIndex")), Index, Count, Result);
+}
+
+void USimpleInventorySubsystem::RemoveItems(const FSimpleInventoryHandle Handle,
+                                            const TArray<FInstancedStruct>& Items,
+                                            bool& Result) {
+    RemoveItems(ResolveHandleForCall(Handle, TEXT("RemoveItems")), Items, Result);
+}
+
+void USimpleInventorySubsystem::AddItems(const FSimpleInventoryHandle Handle,
+                                         const TArray<FSimpleInventoryItemEntry>& Entries,
+                                         const bool bAllOrNothing,
+                                         TArray<bool>& EntryResults,
+                                         bool& Result) {
+    AddItems(ResolveHandleForCall(Handle, TEXT("AddItems")), Entries, bAllOrNothing, EntryResults, Result);
+}
+
+void USimpleInventorySubsystem::RemoveItemsByCount(const FSimpleInventoryHandle Handle,
+                                                   const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                                                   const bool bAllOrNothing,
+                                                   TArray<bool>& EntryResults,
+                                                   bool& Result) {
+    RemoveItemsByCount(ResolveHandleForCall(Handle, TEXT("RemoveItemsByCount")), Entries, bAllOrNothing, EntryResults, Result);
+}
+
+void USimpleInventorySubsystem::TransferItems(const FSimpleInventoryHandle FromHandle,
+                                              const int32 SlotIndex,
+                                              const FSimpleInventoryHandle ToHandle,
+                                              const int32 Count,
+                                              bool& Result) {
+    FSimpleInventoryTransferEntry Entry;
+    Entry.SlotIndex = SlotIndex;
+    Entry.Count = Count;
+    TransferItemsBatch(FromHandle, { Entry }, ToHandle, Result);
+}
+
+void USimpleInventorySubsystem::TransferItemsBatch(const FSimpleInventoryHandle FromHandle,
+                                                   const TArray<FSimpleInventoryTransferEntry>& Entries,
+                                                   const FSimpleInventoryHandle ToHandle,
+                                                   bool& Result) {
+    USimpleInventory* FromInventory = ResolveHandleForCall(FromHandle, TEXT("TransferItems"));
+    USimpleInventory* ToInventory = ResolveHandleForCall(ToHandle, TEXT("TransferItems"));
+    TransferItemsBatch(FromInventory, Entries, ToInventory, Result);
+}
+
+void USimpleInventorySubsystem::Clear(const FSimpleInventoryHandle Handle) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::Clear");
+    
+    if (USimpleInventory* Inventory = ResolveHandleForCall(Handle, TEXT("Clear"))) {
+        Inventory->Clear();
+    }
+}
+
+void USimpleInventorySubsystem::CopyInventory(const FSimpleInventoryHandle Handle,
+                                              const USimpleInventory* OtherInventory) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::CopyInventory");
+    
+    if (USimpleInventory* Inventory = ResolveHandleForCall(Handle, TEXT("CopyInventory"))) {
+        Inventory->CopyInventory(OtherInventory);
+    }
+}
+
+void USimpleInventorySubsystem::ForceOnChange(const FSimpleInventoryHandle Handle) const {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::ForceOnChange");
+    
+    if (USimpleInventory* Inventory = ResolveHandleForCall(Handle, TEXT("ForceOnChange"))) {
+        Inventory->ForceOnChange();
+    }
+}
+
+void USimpleInventorySubsystem::BeginBatch(const FSimpleInventoryHandle Handle) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::BeginBatch");
+    
+    if (USimpleInventory* Inventory = ResolveHandleForCall(Handle, TEXT("BeginBatch"))) {
+        Inventory->BeginBatch();
+    }
+}
+
+void USimpleInventorySubsystem::EndBatch(const FSimpleInventoryHandle Handle) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::EndBatch");
+    
+    if (USimpleInventory* Inventory = ResolveHandleForCall(Handle, TEXT("EndBatch"))) {
+        Inventory->EndBatch();
+    }
+}
+
 // Protected Functions
 
+/**
+ * Returns the storage for one inventory, rebuilding it only if the inventory changed since it was cached.
+ *
+ * @param InventoryName  The inventory's name.
+ * @param Inventory      The inventory.
+ * @return               The cached storage.
+ */
+const FSimpleInventoryStorage& USimpleInventorySubsystem::GetCachedStorage(const FName InventoryName,
+                                                                           USimpleInventory* Inventory) const {
+    FCachedInventoryStorage& Cached = StorageCache.FindOrAdd(InventoryName);
+    if (Cached.Inventory.Get() == Inventory
+        && Cached.Generation == Inventory->GetGeneration()
+        && Cached.Storage.MaxSlots == Inventory->MaxSlotSize) {
+        return Cached.Storage;
+    }
+    
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetCachedStorage || Rebuilding %s"), *InventoryName.ToString());
+    
+    Cached.Inventory = Inventory;
+    Cached.Generation = Inventory->GetGeneration();
+    Cached.Storage.MaxSlots = Inventory->MaxSlotSize;
+    Cached.Storage.StoredSlots.Reset();
+    
+    const int32 NumSlots = Inventory->GetNumSlots();
+    Cached.Storage.StoredSlots.Reserve(NumSlots);
+    for (int32 Index = 0; Index < NumSlots; ++Index) {
+        const FSimpleInventorySlot& Slot = Inventory->GetSlotDataAt(Index);
+        if (!Slot.IsEmpty()) {
+            FSimpleInventorySlotStorage& StoredSlot = Cached.Storage.StoredSlots.AddDefaulted_GetRef();
+            StoredSlot.Metadata = Slot.Item;
+            StoredSlot.ItemID = Slot.ItemID;
+            StoredSlot.Count = Slot.Count;
+        }
+        else {
+            UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::GetCachedStorage || Found empty InventorySlot"));
+        }
+    }
+    
+    return Cached.Storage;
+}
+
 void USimpleInventorySubsystem::Find(const FName InventoryName,
                                      USimpleInventory*& Result) const {
     auto InventoryPtr = InventoryMap.Find(InventoryName);
     Result = (InventoryPtr && *InventoryPtr) ? *InventoryPtr : nullptr;
 }
 
+/**
+ * Looks up an inventory, first restoring it if it is still pending from InflateFromStorageLazy.
+ *
+ * @param InventoryName  The identifier for the inventory.
+ * @param Result         The inventory, or nullptr if it is not registered.
+ */
+void USimpleInventorySubsystem::FindOrInflate(const FName InventoryName,
+                                              USimpleInventory*& Result) {
+    if (!PendingInflation.IsEmpty()) {
+        InflatePendingInventory(InventoryName);
+    }
+    Find(InventoryName, Result);
+}
+
+/**
+ * Looks up an inventory for a public function, restoring it first if needed, and logs an error if it is not registered.
+ *
+ * @param InventoryName  The identifier for the inventory.
+ * @param FunctionName   The calling function, named in the error.
+ * @return               The inventory, or nullptr if it is not registered.
+ */
+USimpleInventory* USimpleInventorySubsystem::FindInventoryForCall(const FName InventoryName,
+                                                                  const TCHAR* FunctionName) {
+    USimpleInventory* Inventory;
+    FindOrInflate(InventoryName, Inventory);
+    if (!IsValid(Inventory)) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::%s || Invalid Inventory: %s"), FunctionName, *InventoryName.ToString());
+        return nullptr;
+    }
+    return Inventory;
+}
+
+/**
+ * Resolves a handle for a public function and logs an error if it is stale or was never issued.
+ *
+ * @param Handle        The handle to resolve.
+ * @param FunctionName  The calling function, named in the error.
+ * @return              The inventory, or nullptr if the handle does not resolve.
+ */
+USimpleInventory* USimpleInventorySubsystem::ResolveHandleForCall(const FSimpleInventoryHandle Handle,
+                                                                  const TCHAR* FunctionName) const {
+    USimpleInventory* Inventory = ResolveHandle(Handle);
+    if (!Inventory) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::%s || Invalid Handle: %s"), FunctionName, *Handle.ToString());
+    }
+    return Inventory;
+}
+
 // Private Functions
 
-void USimpleInventorySubsystem::HandleOnChangeEvent(USimpleInventoryChange* InventoryChange) {
-    OnInventorySubsystemChangeEvent.Broadcast(InventoryChange);
+// Each FName function and its handle overload resolve the inventory, then forward to one of these helpers.
+// Inventory is nullptr if it could not be resolved; the resolver has already logged why, so the helper only
+// fills in the failure result.
+
+void USimpleInventorySubsystem::GetLength(USimpleInventory* Inventory,
+                                          int32& Result) {
+    if (Inventory) {
+        Inventory->GetLength(Result);
+    }
+    else {
+        Result = 0;
+    }
+}
+
+void USimpleInventorySubsystem::GetMaxSize(USimpleInventory* Inventory,
+                                           int32& Result) {
+    if (Inventory) {
+        Inventory->GetMaxSize(Result);
+    }
+    else {
+        Result = 0;
+    }
+}
+
+void USimpleInventorySubsystem::GetSlot(USimpleInventory* Inventory,
+                                        const int32 Index,
+                                        USimpleInventorySlot*& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::GetSlot");
+    
+    if (Inventory) {
+        Inventory->GetSlot(Index, Result);
+    }
+    else {
+        Result = nullptr;
+    }
+}
+
+void USimpleInventorySubsystem::GetSlots(USimpleInventory* Inventory,
+                                         TArray<USimpleInventorySlot*>& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::GetSlots");
+    
+    if (Inventory) {
+        Inventory->GetSlots(Result);
+    }
+    else {
+        Result = TArray<USimpleInventorySlot*>();
+    }
+}
+
+void USimpleInventorySubsystem::HasItem(USimpleInventory* Inventory,
+                                        const int32 ItemID,
+                                        const int32 Count,
+                                        bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::HasItem");
+    
+    if (Inventory) {
+        Inventory->HasItem(ItemID, Count, Result);
+    }
+    else {
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::GetItemCount(USimpleInventory* Inventory,
+                                             const int32 ItemID,
+                                             int32& Result) {
+    if (Inventory) {
+        Inventory->GetItemCount(ItemID, Result);
+    }
+    else {
+        Result = 0;
+    }
+}
+
+void USimpleInventorySubsystem::HasAtLeast(USimpleInventory* Inventory,
+                                           const int32 ItemID,
+                                           const int32 Count,
+                                           bool& Result) {
+    if (Inventory) {
+        Inventory->HasAtLeast(ItemID, Count, Result);
+    }
+    else {
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::GetSlotsOfType(USimpleInventory* Inventory,
+                                               const UScriptStruct* StructType,
+                                               TArray<int32>& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::GetSlotsOfType");
+    
+    if (Inventory) {
+        Inventory->GetSlotsOfType(StructType, Result);
+    }
+    else {
+        Result.Reset();
+    }
+}
+
+void USimpleInventorySubsystem::QueryItemsCompiled(USimpleInventory* Inventory,
+                                                   const FSimpleInventoryCompiledQuery& Query,
+                                                   TArray<int32>& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::QueryItemsCompiled");
+    
+    if (Inventory) {
+        Inventory->QueryItemsCompiled(Query, Result);
+    }
+    else {
+        Result.Reset();
+    }
+}
+
+void USimpleInventorySubsystem::AddItem(USimpleInventory* Inventory,
+                                        FInstancedStruct Item,
+                                        const int32 Count,
+                                        bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::AddItem");
+    
+    if (Inventory) {
+        Inventory->AddItem(MoveTemp(Item), Count, Result);
+    }
+    else {
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::AddItemByID(USimpleInventory* Inventory,
+                                            const int32 ItemID,
+                                            const int32 Count,
+                                            bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::AddItemByID");
+    
+    if (Inventory) {
+        Inventory->AddItemByID(ItemID, Count, Result);
+    }
+    else {
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::RemoveItemAtIndex(USimpleInventory* Inventory,
+                                                  const int32 Index,
+                                                  const int32 Count,
+                                                  bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::RemoveItemAtIndex");
+    
+    if (Inventory) {
+        Inventory->RemoveItemAtIndex(Index, Count, Result);
+    }
+    else {
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::RemoveItems(USimpleInventory* Inventory,
+                                            const TArray<FInstancedStruct>& Items,
+                                            bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::RemoveItems");
+    
+    if (Inventory) {
+        Inventory->RemoveItems(Items, Result);
+    }
+    else {
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::AddItems(USimpleInventory* Inventory,
+                                         const TArray<FSimpleInventoryItemEntry>& Entries,
+                                         const bool bAllOrNothing,
+                                         TArray<bool>& EntryResults,
+                                         bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::AddItems");
+    
+    if (Inventory) {
+        Inventory->AddItems(Entries, bAllOrNothing, EntryResults, Result);
+    }
+    else {
+        EntryResults.Init(false, Entries.Num());
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::RemoveItemsByCount(USimpleInventory* Inventory,
+                                                   const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                                                   const bool bAllOrNothing,
+                                                   TArray<bool>& EntryResults,
+                                                   bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::RemoveItemsByCount");
+    
+    if (Inventory) {
+        Inventory->RemoveItemsByCount(Entries, bAllOrNothing, EntryResults, Result);
+    }
+    else {
+        EntryResults.Init(false, Entries.Num());
+        Result = false;
+    }
+}
+
+void USimpleInventorySubsystem::TransferItemsBatch(USimpleInventory* FromInventory,
+                                                   const TArray<FSimpleInventoryTransferEntry>& Entries,
+                                                   USimpleInventory* ToInventory,
+                                                   bool& Result) {
+    SIMPLEINVENTORY_TRACE_SCOPE("USimpleInventorySubsystem::TransferItems");
+    
+    if (FromInventory && ToInventory) {
+        FromInventory->TransferItemsBatch(Entries, ToInventory, Result);
+    }
+    else {
+        Result = false;
+    }
+}
+
+/**
+ * Restores one inventory from its storage, registering it if needed.
+ * Slots are rebuilt directly in their saved layout and one LOAD change is broadcast.
+ *
+ * @param InventoryName  The inventory's name.
+ * @param Storage        The inventory's saved state.
+ */
+void USimpleInventorySubsystem::InflateInventory(const FName InventoryName,
+                                                 const FSimpleInventoryStorage& Storage) {
+    PendingInflation.Remove(InventoryName);
+    
+    USimpleInventory* NewInventory;
+    Find(InventoryName, NewInventory);
+    
+    if (!NewInventory) {
+        RegisterInventory(InventoryName, Storage.MaxSlots, NewInventory);
+    }
+    NewInventory->MaxSlotSize = Storage.MaxSlots;
+    
+    TArray<FSimpleInventorySlot> Slots;
+    Slots.Reserve(FMath::Min(Storage.StoredSlots.Num(), FMath::Max(Storage.MaxSlots, 0)));
+    for (const FSimpleInventorySlotStorage& StoredSlot : Storage.StoredSlots) {
+        if (Slots.Num() >= Storage.MaxSlots) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventorySubsystem::InflateInventory || %s holds more slots than its MaxSlots (%i), dropping the rest"), *InventoryName.ToString(), Storage.MaxSlots);
+            break;
+        }
+        if (StoredSlot.Count <= 0) {
+            continue;
+        }
+        
+        FSimpleInventorySlot Slot;
+        Slot.Count = StoredSlot.Count;
+        if (StoredSlot.Metadata.IsValid()) {
+            const FSimpleInventoryItemAccessor ItemAccessor = FSimpleInventoryItemAccessorCache::Get(StoredSlot.Metadata.GetScriptStruct());
+            if (!ItemAccessor.IsValid()) {
+                UE_LOG(SimpleInventoryLog, Error, TEXT("USimpleInventorySubsystem::InflateInventory || Invalid Item struct %s in %s"), *GetNameSafe(StoredSlot.Metadata.GetScriptStruct()), *InventoryName.ToString());
+                continue;
+            }
+            // Read the ID from the payload; saves made before ItemID was stored leave it at zero.
+            Slot.ItemID = ItemAccessor.GetID(StoredSlot.Metadata.GetMemory());
+            if (FSimpleInventoryItemRegistry::Matches(Slot.ItemID, StoredSlot.Metadata)) {
+                Slot.bUsesDefinition = true;
+            }
+            else {
+                Slot.Item = StoredSlot.Metadata;
+            }
+        }
+        else {
+            // The slot keeps referencing its definition even if the table is not registered yet, e.g. when loading
+            // before item tables register; GetItem resolves it once it is. Dropping it would lose it from the next save.
+            if (!FSimpleInventoryItemRegistry::Find(StoredSlot.ItemID).IsValid()) {
+                UE_LOG(SimpleInventoryLog, Warning, TEXT("USimpleInventorySubsystem::InflateInventory || No item definition registered yet for ItemID %i in %s"), StoredSlot.ItemID, *InventoryName.ToString());
+            }
+            Slot.ItemID = StoredSlot.ItemID;
+            Slot.bUsesDefinition = true;
+        }
+        Slots.Add(MoveTemp(Slot));
+    }
+    
+    NewInventory->RestoreSlots(MoveTemp(Slots));
+}
+
+/**
+ * Adds a new inventory to InventoryMap, listens to its changes and issues its handle.
+ *
+ * @param InventoryName  The inventory's name.
+ * @param Inventory      The new inventory.
+ * @return               The inventory's handle.
+ */
+FSimpleInventoryHandle USimpleInventorySubsystem::AddInventory(const FName InventoryName,
+                                                               USimpleInventory* Inventory) {
+    InventoryMap.Add(InventoryName, Inventory);
+    Inventory->OnInventoryChangeNative.AddUObject(this, &USimpleInventorySubsystem::HandleOnChangeEvent);
+    return IssueHandle(InventoryName, Inventory);
+}
+
+/**
+ * Places an inventory in the handle array, reusing a freed index if there is one.
+ *
+ * @param InventoryName  The inventory's name.
+ * @param Inventory      The inventory.
+ * @return               The new handle.
+ */
+FSimpleInventoryHandle USimpleInventorySubsystem::IssueHandle(const FName InventoryName,
+                                                              USimpleInventory* Inventory) {
+    FSimpleInventoryHandle Handle;
+    if (FreeHandleIndices.IsEmpty()) {
+        Handle.Index = HandleInventories.Add(Inventory);
+        HandleSerials.Add(1);
+    }
+    else {
+        Handle.Index = FreeHandleIndices.Pop(EAllowShrinking::No);
+        HandleInventories[Handle.Index] = Inventory;
+    }
+    Handle.Serial = HandleSerials[Handle.Index];
+    HandlesByName.Add(InventoryName, Handle);
+    
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::IssueHandle || Inventory: %s | Handle: %s"), *InventoryName.ToString(), *Handle.ToString());
+    
+    return Handle;
+}
+
+/**
+ * Frees an inventory's handle index. Bumping the serial makes every outstanding copy of the handle stale.
+ *
+ * @param InventoryName  The inventory's name.
+ */
+void USimpleInventorySubsystem::ReleaseHandle(const FName InventoryName) {
+    FSimpleInventoryHandle Handle;
+    if (HandlesByName.RemoveAndCopyValue(InventoryName, Handle)) {
+        HandleInventories[Handle.Index] = nullptr;
+        ++HandleSerials[Handle.Index];
+        FreeHandleIndices.Add(Handle.Index);
+    }
+}
+
+/**
+ * Restores an inventory kept by InflateFromStorageLazy.
+ *
+ * @param InventoryName  The inventory's name.
+ */
+void USimpleInventorySubsystem::InflatePendingInventory(const FName InventoryName) {
+    FSimpleInventoryStorage Storage;
+    if (PendingInflation.RemoveAndCopyValue(InventoryName, Storage)) {
+        UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::InflatePendingInventory || Inventory: %s"), *InventoryName.ToString());
+        InflateInventory(InventoryName, Storage);
+    }
+}
+
+/**
+ * Restores every inventory kept by InflateFromStorageLazy.
+ */
+void USimpleInventorySubsystem::InflateAllPendingInventories() {
+    TArray<FName> InventoryNames;
+    PendingInflation.GenerateKeyArray(InventoryNames);
+    for (const FName InventoryName : InventoryNames) {
+        InflatePendingInventory(InventoryName);
+    }
+}
+
+/**
+ * Takes the storage read by an async load and starts restoring it from the core ticker.
+ *
+ * @param Storage  The loaded storage.
+ */
+void USimpleInventorySubsystem::BeginApplyingLoad(FSimpleInventorySubsystemStorage&& Storage) {
+    PendingLoadStorage = MoveTemp(Storage);
+    PendingLoadStorage.Value.GenerateKeyArray(PendingLoadNames);
+    PendingLoadIndex = 0;
+    
+    if (PendingLoadNames.IsEmpty()) {
+        FinishAsyncLoad(true);
+        return;
+    }
+    
+    // Restore the first batch this frame; the ticker continues with the rest.
+    if (TickPendingLoad(0.0f)) {
+        PendingLoadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &USimpleInventorySubsystem::TickPendingLoad));
+    }
+}
+
+/**
+ * Restores pending inventories until the frame budget is spent. At least one inventory is restored per call.
+ *
+ * @param DeltaTime  Unused.
+ * @return           True while inventories remain.
+ */
+bool USimpleInventorySubsystem::TickPendingLoad(float DeltaTime) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventorySubsystem::TickPendingLoad", STAT_SimpleInventory_AsyncLoadTick);
+    const double Deadline = FPlatformTime::Seconds() + AsyncLoadFrameBudgetMs / 1000.0;
+    do {
+        const FName InventoryName = PendingLoadNames[PendingLoadIndex++];
+        InflateInventory(InventoryName, PendingLoadStorage.Value[InventoryName]);
+    } while (PendingLoadNames.IsValidIndex(PendingLoadIndex) && FPlatformTime::Seconds() < Deadline);
+    
+    if (PendingLoadNames.IsValidIndex(PendingLoadIndex)) {
+        UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::TickPendingLoad || Restored %i of %i"), PendingLoadIndex, PendingLoadNames.Num());
+        return true;
+    }
+    
+    FinishAsyncLoad(true);
+    return false;
+}
+
+/**
+ * Clears the async load state and calls its completion delegate.
+ *
+ * @param bSuccess  Whether every inventory was restored.
+ */
+void USimpleInventorySubsystem::FinishAsyncLoad(const bool bSuccess) {
+    UE_LOG(SimpleInventoryLog, Verbose, TEXT("USimpleInventorySubsystem::FinishAsyncLoad || Success: %i"), bSuccess);
+    
+    if (PendingLoadTickerHandle.IsValid()) {
+        FTSTicker::GetCoreTicker().RemoveTicker(PendingLoadTickerHandle);
+        PendingLoadTickerHandle.Reset();
+    }
+    
+    PendingLoadStorage.Value.Empty();
+    PendingLoadNames.Empty();
+    PendingLoadIndex = 0;
+    bIsLoadingAsync = false;
+    
+    FOnSimpleInventoryLoadCompleteNativeDelegate OnComplete = MoveTemp(PendingLoadComplete);
+    PendingLoadComplete.Unbind();
+    OnComplete.ExecuteIfBound(bSuccess);
+}
+
+void USimpleInventorySubsystem::HandleOnChangeEvent(const FSimpleInventoryChange& InventoryChange) {
+    SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER("USimpleInventorySubsystem::HandleOnChangeEvent", STAT_SimpleInventory_SubsystemBroadcastChange);
+    
+    // Both sides of a transfer between registered inventories report it; the target's change describes both, so only it is forwarded.
+    if (InventoryChange.Type == ESimpleInventoryChangeType::TRANSFER && InventoryChange.bIsTransferSource && InventoryMap.Contains(InventoryChange.TransferInventoryName)) {
+        return;
+    }
+    
+    OnInventorySubsystemChangeNative.Broadcast(InventoryChange);
+    
+    if (OnInventorySubsystemChangeEvent.IsBound()) {
+        OnInventorySubsystemChangeEvent.Broadcast(USimpleInventoryChange::Create(InventoryChange));
+    }
 }
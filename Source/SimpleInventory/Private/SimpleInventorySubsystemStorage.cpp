@@ -1,3 +1,469 @@
 // Copyright Eric Downey - 2025
 
 #include "SimpleInventorySubsystemStorage.h"
+
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+#include "SimpleInventoryLog.h"
+#include "SimpleInventoryItemAccessor.h"
+
+/*
+ * Compact storage layout. Counts and indices are LEB128 varints; signed values are zigzag encoded varints.
+ *
+ *   uint32  Magic
+ *   varint  Version
+ *   varint  NameCount,      FString[NameCount]        Inventory names
+ *   varint  StructCount,    FString[StructCount]      Item struct path names
+ *   varint  PayloadCount,   Payload[PayloadCount]     Unique item payloads
+ *           Payload   = varint StructIndex, int32 ByteSize, tagged struct data
+ *   varint  InventoryCount, Inventory[InventoryCount]
+ *           Inventory = varint NameIndex, zigzag MaxSlots, varint SlotCount, Slot[SlotCount]
+ *           Slot      = zigzag ItemID, zigzag Count, varint PayloadIndex + 1 (0 when the slot has no payload)
+ *
+ * Payloads keep tagged serialization so item structs can gain or lose properties between saves.
+ */
+
+static constexpr uint32 StorageMagic = 0x564E4953; // "SINV"
+
+/** Size of the uncompressed-size header written by SaveToCompressedBytes. */
+static constexpr int32 CompressedHeaderSize = sizeof(int32);
+
+/** Zlib never expands data by more than this factor, so a larger uncompressed size in the header is corrupt. */
+static constexpr int64 MaxCompressionRatio = 1032;
+
+/** Upper bound on the uncompressed size accepted from a header, whatever the compressed size. */
+static constexpr int64 MaxUncompressedSize = 256 * 1024 * 1024;
+
+enum class ESimpleInventoryStorageVersion : uint32
+{
+    Initial = 1,
+    
+    LatestVersion = Initial
+};
+
+static void SerializeVarUInt(FArchive& Ar,
+                             uint32& Value) {
+    if (Ar.IsLoading()) {
+        Value = 0;
+        for (int32 Shift = 0; Shift < 35; Shift += 7) {
+            uint8 Byte = 0;
+            Ar << Byte;
+            Value |= static_cast<uint32>(Byte & 0x7F) << Shift;
+            if (!(Byte & 0x80) || Ar.IsError()) {
+                return;
+            }
+        }
+        Ar.SetError();
+        return;
+    }
+    
+    uint32 Remaining = Value;
+    do {
+        uint8 Byte = static_cast<uint8>(Remaining & 0x7F);
+        Remaining >>= 7;
+        if (Remaining != 0) {
+            Byte |= 0x80;
+        }
+        Ar << Byte;
+    } while (Remaining != 0);
+}
+
+static void SerializeVarInt(FArchive& Ar,
+                            int32& Value) {
+    uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+    SerializeVarUInt(Ar, Encoded);
+    if (Ar.IsLoading()) {
+        Value = static_cast<int32>(Encoded >> 1) ^ -static_cast<int32>(Encoded & 1);
+    }
+}
+
+/** Rejects counts that cannot fit in the rest of the archive, so corrupt data fails instead of allocating. */
+static bool ReadCount(FArchive& Ar,
+                      uint32& Count) {
+    SerializeVarUInt(Ar, Count);
+    const int64 TotalSize = Ar.TotalSize();
+    if (Ar.IsError() || (TotalSize > 0 && Count > TotalSize - Ar.Tell())) {
+        Ar.SetError();
+        return false;
+    }
+    return true;
+}
+
+static void SaveCompact(FArchive& Ar,
+                        const FSimpleInventorySubsystemStorage& Storage) {
+    // Build the struct-type and payload tables. Identical payloads are stored once;
+    // candidates are bucketed by struct type and item ID so each payload is only compared against likely duplicates.
+    TArray<const UScriptStruct*> StructTypes;
+    TMap<const UScriptStruct*, uint32> StructIndices;
+    TArray<const FInstancedStruct*> Payloads;
+    TMap<TPair<const UScriptStruct*, int32>, TArray<uint32>> PayloadBuckets;
+    TArray<uint32> SlotPayloadIndices;
+    
+    for (const auto& Inventory : Storage.Value) {
+        for (const FSimpleInventorySlotStorage& StoredSlot : Inventory.Value.StoredSlots) {
+            const UScriptStruct* StructType = StoredSlot.Metadata.GetScriptStruct();
+            if (!StructType || !StoredSlot.Metadata.GetMemory()) {
+                SlotPayloadIndices.Add(0);
+                continue;
+            }
+            
+            if (!StructIndices.Contains(StructType)) {
+                StructIndices.Add(StructType, StructTypes.Add(StructType));
+            }
+            
+            const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(StructType);
+            const int32 BucketID = Accessor.IsValid() ? Accessor.GetID(StoredSlot.Metadata.GetMemory()) : 0;
+            TArray<uint32>& Bucket = PayloadBuckets.FindOrAdd(TPair<const UScriptStruct*, int32>(StructType, BucketID));
+            
+            uint32 PayloadIndex = INDEX_NONE;
+            for (const uint32 Candidate : Bucket) {
+                if (StructType->CompareScriptStruct(Payloads[Candidate]->GetMemory(), StoredSlot.Metadata.GetMemory(), PPF_None)) {
+                    PayloadIndex = Candidate;
+                    break;
+                }
+            }
+            if (PayloadIndex == INDEX_NONE) {
+                PayloadIndex = Payloads.Add(&StoredSlot.Metadata);
+                Bucket.Add(PayloadIndex);
+            }
+            SlotPayloadIndices.Add(PayloadIndex + 1);
+        }
+    }
+    
+    uint32 Magic = StorageMagic;
+    uint32 Version = static_cast<uint32>(ESimpleInventoryStorageVersion::LatestVersion);
+    Ar << Magic;
+    SerializeVarUInt(Ar, Version);
+    
+    // Name table. Inventory names are written once here and referenced by index below.
+    uint32 NameCount = Storage.Value.Num();
+    SerializeVarUInt(Ar, NameCount);
+    for (const auto& Inventory : Storage.Value) {
+        FString Name = Inventory.Key.ToString();
+        Ar << Name;
+    }
+    
+    uint32 StructCount = StructTypes.Num();
+    SerializeVarUInt(Ar, StructCount);
+    for (const UScriptStruct* StructType : StructTypes) {
+        FString Path = StructType->GetPathName();
+        Ar << Path;
+    }
+    
+    uint32 PayloadCount = Payloads.Num();
+    SerializeVarUInt(Ar, PayloadCount);
+    for (const FInstancedStruct* Payload : Payloads) {
+        UScriptStruct* StructType = const_cast<UScriptStruct*>(Payload->GetScriptStruct());
+        uint32 StructIndex = StructIndices[StructType];
+        SerializeVarUInt(Ar, StructIndex);
+        
+        // Size prefix lets loading skip payloads whose struct no longer exists.
+        const int64 SizePosition = Ar.Tell();
+        int32 ByteSize = 0;
+        Ar << ByteSize;
+        const int64 DataStart = Ar.Tell();
+        // Saving only reads the item; SerializeItem takes mutable memory for both directions.
+        StructType->SerializeItem(Ar, const_cast<uint8*>(Payload->GetMemory()), nullptr);
+        const int64 DataEnd = Ar.Tell();
+        
+        ByteSize = static_cast<int32>(DataEnd - DataStart);
+        Ar.Seek(SizePosition);
+        Ar << ByteSize;
+        Ar.Seek(DataEnd);
+    }
+    
+    uint32 InventoryCount = Storage.Value.Num();
+    SerializeVarUInt(Ar, InventoryCount);
+    uint32 NameIndex = 0;
+    int32 SlotNumber = 0;
+    for (const auto& Inventory : Storage.Value) {
+        SerializeVarUInt(Ar, NameIndex);
+        ++NameIndex;
+        
+        int32 MaxSlots = Inventory.Value.MaxSlots;
+        SerializeVarInt(Ar, MaxSlots);
+        
+        uint32 SlotCount = Inventory.Value.StoredSlots.Num();
+        SerializeVarUInt(Ar, SlotCount);
+        for (const FSimpleInventorySlotStorage& StoredSlot : Inventory.Value.StoredSlots) {
+            int32 ItemID = StoredSlot.ItemID;
+            int32 Count = StoredSlot.Count;
+            uint32 PayloadIndex = SlotPayloadIndices[SlotNumber++];
+            SerializeVarInt(Ar, ItemID);
+            SerializeVarInt(Ar, Count);
+            SerializeVarUInt(Ar, PayloadIndex);
+        }
+    }
+}
+
+static void LoadCompact(FArchive& Ar,
+                        FSimpleInventorySubsystemStorage& Storage) {
+    uint32 Version = 0;
+    SerializeVarUInt(Ar, Version);
+    if (Version == 0 || Version > static_cast<uint32>(ESimpleInventoryStorageVersion::LatestVersion)) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::Serialize || Unsupported storage version %u"), Version);
+        Ar.SetError();
+        return;
+    }
+    
+    uint32 NameCount = 0;
+    if (!ReadCount(Ar, NameCount)) {
+        return;
+    }
+    TArray<FName> Names;
+    Names.Reserve(NameCount);
+    for (uint32 i = 0; i < NameCount; i++) {
+        FString Name;
+        Ar << Name;
+        Names.Add(FName(*Name));
+    }
+    
+    uint32 StructCount = 0;
+    if (!ReadCount(Ar, StructCount)) {
+        return;
+    }
+    TArray<UScriptStruct*> StructTypes;
+    StructTypes.Reserve(StructCount);
+    for (uint32 i = 0; i < StructCount; i++) {
+        FString Path;
+        Ar << Path;
+        UScriptStruct* StructType = FindObject<UScriptStruct>(nullptr, *Path);
+        // Loading packages is only allowed on the game thread; off it, the struct must already be loaded.
+        if (!StructType && IsInGameThread()) {
+            StructType = LoadObject<UScriptStruct>(nullptr, *Path);
+        }
+        if (!StructType) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventorySubsystemStorage::Serialize || Unknown item struct %s, its items will be dropped"), *Path);
+        }
+        StructTypes.Add(StructType);
+    }
+    
+    uint32 PayloadCount = 0;
+    if (!ReadCount(Ar, PayloadCount)) {
+        return;
+    }
+    TArray<FInstancedStruct> Payloads;
+    Payloads.SetNum(PayloadCount);
+    for (FInstancedStruct& Payload : Payloads) {
+        uint32 StructIndex = 0;
+        int32 ByteSize = 0;
+        SerializeVarUInt(Ar, StructIndex);
+        Ar << ByteSize;
+        if (Ar.IsError() || !StructTypes.IsValidIndex(StructIndex) || ByteSize < 0) {
+            Ar.SetError();
+            return;
+        }
+        
+        const int64 DataStart = Ar.Tell();
+        const int64 DataEnd = DataStart + ByteSize;
+        const int64 TotalSize = Ar.TotalSize();
+        if (TotalSize >= 0 && DataEnd > TotalSize) {
+            Ar.SetError();
+            return;
+        }
+        
+        UScriptStruct* StructType = StructTypes[StructIndex];
+        if (!StructType) {
+            Ar.Seek(DataEnd);
+            continue;
+        }
+        
+        Payload.InitializeAs(StructType);
+        StructType->SerializeItem(Ar, Payload.GetMutableMemory(), nullptr);
+        if (Ar.IsError()) {
+            UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::Serialize || Failed to load an item of %s"), *StructType->GetName());
+            return;
+        }
+        
+        // A struct whose layout changed since saving may read less or more than was written.
+        // Realign to the next record either way; an item that read into the next record cannot be trusted.
+        if (Ar.Tell() != DataEnd) {
+            UE_LOG(SimpleInventoryLog, Warning, TEXT("FSimpleInventorySubsystemStorage::Serialize || Item of %s read %lld of its %d bytes"), *StructType->GetName(), Ar.Tell() - DataStart, ByteSize);
+            if (Ar.Tell() > DataEnd) {
+                Payload.Reset();
+            }
+            Ar.Seek(DataEnd);
+        }
+    }
+    
+    uint32 InventoryCount = 0;
+    if (!ReadCount(Ar, InventoryCount)) {
+        return;
+    }
+    Storage.Value.Empty(InventoryCount);
+    for (uint32 i = 0; i < InventoryCount; i++) {
+        uint32 NameIndex = 0;
+        SerializeVarUInt(Ar, NameIndex);
+        if (!Names.IsValidIndex(NameIndex)) {
+            Ar.SetError();
+            return;
+        }
+        
+        FSimpleInventoryStorage& Inventory = Storage.Value.Add(Names[NameIndex]);
+        SerializeVarInt(Ar, Inventory.MaxSlots);
+        
+        uint32 SlotCount = 0;
+        if (!ReadCount(Ar, SlotCount)) {
+            return;
+        }
+        Inventory.StoredSlots.Reserve(SlotCount);
+        for (uint32 SlotNumber = 0; SlotNumber < SlotCount; SlotNumber++) {
+            int32 ItemID = 0;
+            int32 Count = 0;
+            uint32 PayloadIndex = 0;
+            SerializeVarInt(Ar, ItemID);
+            SerializeVarInt(Ar, Count);
+            SerializeVarUInt(Ar, PayloadIndex);
+            if (PayloadIndex > static_cast<uint32>(Payloads.Num())) {
+                Ar.SetError();
+                return;
+            }
+            
+            if (PayloadIndex != 0 && !Payloads[PayloadIndex - 1].IsValid()) {
+                // The payload's struct no longer exists.
+                continue;
+            }
+            
+            FSimpleInventorySlotStorage& StoredSlot = Inventory.StoredSlots.AddDefaulted_GetRef();
+            StoredSlot.ItemID = ItemID;
+            StoredSlot.Count = Count;
+            if (PayloadIndex != 0) {
+                StoredSlot.Metadata = Payloads[PayloadIndex - 1];
+            }
+        }
+    }
+}
+
+/**
+ * Serializes the storage in the compact binary layout described above.
+ * When loading, data that does not start with the layout's magic number is left to tagged property serialization,
+ * so saves written before this format existed still load.
+ *
+ * @param Ar  The archive to serialize with.
+ * @return    True if the compact layout was used.
+ */
+bool FSimpleInventorySubsystemStorage::Serialize(FArchive& Ar) {
+    if (Ar.IsTextFormat() || Ar.IsObjectReferenceCollector() || Ar.IsCountingMemory()) {
+        return false;
+    }
+    
+    if (Ar.IsSaving()) {
+        SaveCompact(Ar, *this);
+        return true;
+    }
+    
+    if (Ar.IsLoading()) {
+        const int64 StartPosition = Ar.Tell();
+        const int64 TotalSize = Ar.TotalSize();
+        if (TotalSize >= 0 && TotalSize - StartPosition < static_cast<int64>(sizeof(uint32))) {
+            return false;
+        }
+        
+        uint32 Magic = 0;
+        Ar << Magic;
+        if (Magic != StorageMagic) {
+            Ar.Seek(StartPosition);
+            return false;
+        }
+        
+        LoadCompact(Ar, *this);
+        return true;
+    }
+    
+    return false;
+}
+
+/**
+ * Writes the compact layout into memory and compresses it with zlib.
+ * The result starts with the uncompressed size as an int32.
+ *
+ * @param OutData  The compressed bytes.
+ * @return         True on success.
+ */
+bool FSimpleInventorySubsystemStorage::SaveToCompressedBytes(TArray<uint8>& OutData) const {
+    TArray<uint8> Uncompressed;
+    FMemoryWriter Writer(Uncompressed);
+    // Object references inside item payloads are written as path names; a plain memory archive cannot store them.
+    FObjectAndNameAsStringProxyArchive Archive(Writer, false);
+    SaveCompact(Archive, *this);
+    if (Archive.IsError()) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::SaveToCompressedBytes || Failed to write storage"));
+        return false;
+    }
+    
+    const int32 UncompressedSize = Uncompressed.Num();
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
+    OutData.SetNumUninitialized(CompressedHeaderSize + CompressedSize);
+    FMemory::Memcpy(OutData.GetData(), &UncompressedSize, CompressedHeaderSize);
+    if (!FCompression::CompressMemory(NAME_Zlib, OutData.GetData() + CompressedHeaderSize, CompressedSize, Uncompressed.GetData(), UncompressedSize)) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::SaveToCompressedBytes || Compression failed"));
+        OutData.Reset();
+        return false;
+    }
+    OutData.SetNum(CompressedHeaderSize + CompressedSize);
+    return true;
+}
+
+/**
+ * Decompresses data written by SaveToCompressedBytes and reads the compact layout from it.
+ *
+ * @param Data  The compressed bytes.
+ * @return      False if the data is corrupt or not in the expected format.
+ */
+bool FSimpleInventorySubsystemStorage::LoadFromCompressedBytes(const TArray<uint8>& Data) {
+    int32 UncompressedSize = 0;
+    if (Data.Num() < CompressedHeaderSize) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::LoadFromCompressedBytes || Data is too small"));
+        return false;
+    }
+    FMemory::Memcpy(&UncompressedSize, Data.GetData(), CompressedHeaderSize);
+    
+    TArray<uint8> Uncompressed;
+    const int64 MaxSize = FMath::Min(static_cast<int64>(Data.Num() - CompressedHeaderSize) * MaxCompressionRatio, MaxUncompressedSize);
+    if (UncompressedSize < static_cast<int32>(sizeof(uint32)) || UncompressedSize > MaxSize) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::LoadFromCompressedBytes || Invalid size %d"), UncompressedSize);
+        return false;
+    }
+    Uncompressed.SetNumUninitialized(UncompressedSize);
+    if (!FCompression::UncompressMemory(NAME_Zlib, Uncompressed.GetData(), UncompressedSize, Data.GetData() + CompressedHeaderSize, Data.Num() - CompressedHeaderSize)) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::LoadFromCompressedBytes || Decompression failed"));
+        return false;
+    }
+    
+    FMemoryReader Reader(Uncompressed);
+    // Do not load packages for unresolved references; this may run off the game thread.
+    FObjectAndNameAsStringProxyArchive Archive(Reader, false);
+    uint32 Magic = 0;
+    Archive << Magic;
+    if (Magic != StorageMagic) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::LoadFromCompressedBytes || Unknown format"));
+        return false;
+    }
+    
+    FSimpleInventorySubsystemStorage Loaded;
+    LoadCompact(Archive, Loaded);
+    if (Archive.IsError()) {
+        UE_LOG(SimpleInventoryLog, Error, TEXT("FSimpleInventorySubsystemStorage::LoadFromCompressedBytes || Corrupt storage data"));
+        return false;
+    }
+    
+    Value = MoveTemp(Loaded.Value);
+    return true;
+}
+
+/**
+ * Replaces changed inventories and drops removed ones.
+ *
+ * @param Delta  The changed and removed inventories.
+ */
+void FSimpleInventorySubsystemStorage::ApplyDelta(const FSimpleInventorySubsystemStorageDelta& Delta) {
+    for (const FName& InventoryName : Delta.Removed) {
+        Value.Remove(InventoryName);
+    }
+    for (const auto& Inventory : Delta.Changed) {
+        Value.Add(Inventory.Key, Inventory.Value);
+    }
+}
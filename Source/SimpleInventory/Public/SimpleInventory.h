@@ -3,12 +3,19 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
 #include "StructUtils/InstancedStruct.h"
 
+#include "SimpleInventorySlot.h"
+#include "SimpleInventoryChange.h"
+#include "SimpleInventoryItemEntry.h"
+#include "SimpleInventoryQuery.h"
+#include "SimpleInventorySort.h"
+#include "SimpleInventorySnapshot.h"
+
 #include "SimpleInventory.generated.h"
 
-class USimpleInventorySlot;
-class USimpleInventoryChange;
+struct FSimpleInventoryItemAccessor;
 
 UCLASS(ClassGroup=(SimpleInventory), BlueprintType, Blueprintable)
 class SIMPLEINVENTORY_API USimpleInventory : public UObject
@@ -17,10 +24,15 @@ class SIMPLEINVENTORY_API USimpleInventory : public UObject
     
 public:
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryChangeDelegate, USimpleInventoryChange*, InventoryChange);
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnInventoryChangeNativeDelegate, const FSimpleInventoryChange&);
     
+    /** Blueprint change event. A `USimpleInventoryChange` is only allocated when this has bindings. */
     UPROPERTY(BlueprintAssignable, Category="Simple Inventory")
     FOnInventoryChangeDelegate OnInventoryChangeEvent;
     
+    /** Native change event. Prefer this from C++; it never allocates. */
+    FOnInventoryChangeNativeDelegate OnInventoryChangeNative;
+    
     UPROPERTY(BlueprintReadWrite, EditAnywhere, SaveGame, Category="Simple Inventory")
     FName InventoryName;
     
@@ -29,6 +41,13 @@ public:
     
     USimpleInventory();
     
+    static void AddReferencedObjects(UObject* InThis,
+                                     FReferenceCollector& Collector);
+    
+    virtual void BeginDestroy() override;
+    
+    virtual void Serialize(FArchive& Ar) override;
+    
     /**
      * Add an item to the inventory.
      * If the item is stackable, it will be merged into an existing stack when possible.
@@ -43,6 +62,19 @@ public:
                  const int32 Count,
                  bool& Result);
     
+    /**
+     * Add an item by ID using its registered definition from `FSimpleInventoryItemRegistry`.
+     * The new slots reference the shared definition and hold no per-instance copy.
+     *
+     * @param ItemID  The ID of a registered item definition.
+     * @param Count   The number of items to add.
+     * @param Result  True if the item(s) were successfully added, false if the ID is not registered or space ran out.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void AddItemByID(const int32 ItemID,
+                     const int32 Count,
+                     bool& Result);
+    
     /**
      * Remove a number of items from a specific slot.
      * If the slot’s count reaches zero, the slot will be removed.
@@ -66,6 +98,36 @@ public:
     void RemoveItems(const TArray<FInstancedStruct>& Items,
                      bool& Result);
     
+    /**
+     * Add several items in one call, broadcasting a single BATCH change.
+     * Each entry is added as AddItem would, without repeating validation or scanning for each entry.
+     *
+     * @param Entries         The items and amounts to add.
+     * @param bAllOrNothing   If true, nothing is added unless every entry fits.
+     * @param EntryResults    True for each entry that was fully added, in the same order as Entries.
+     * @param Result          True if every entry was fully added.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void AddItems(const TArray<FSimpleInventoryItemEntry>& Entries,
+                  const bool bAllOrNothing,
+                  TArray<bool>& EntryResults,
+                  bool& Result);
+    
+    /**
+     * Remove amounts of several items by ID in one call, broadcasting a single BATCH change.
+     * Amounts are taken from the last slots holding each item first, and may span several stacks.
+     *
+     * @param Entries         The item IDs and amounts to remove.
+     * @param bAllOrNothing   If true, nothing is removed unless every entry can be fully removed.
+     * @param EntryResults    True for each entry that was fully removed, in the same order as Entries.
+     * @param Result          True if every entry was fully removed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void RemoveItemsByCount(const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                            const bool bAllOrNothing,
+                            TArray<bool>& EntryResults,
+                            bool& Result);
+    
     /**
      * Clear all items from the inventory.
      */
@@ -90,9 +152,10 @@ public:
     
     /**
      * Get a specific slot by index.
+     * The returned object is a view refreshed on every call; modify the inventory through its functions instead.
      *
      * @param Index   The index of the slot.
-     * @param Result  The inventory slot at the given index, or nullptr if invalid.
+     * @param Result  The inventory slot at the given index, or nullptr if invalid or empty.
      */
     UFUNCTION(BlueprintPure, Category="Simple Inventory")
     void GetSlot(const int32 Index,
@@ -100,12 +163,38 @@ public:
     
     /**
      * Get all slots in the inventory.
+     * Empty slots are returned as nullptr.
      *
      * @param Result  Array of inventory slots.
      */
     UFUNCTION(BlueprintPure, Category="Simple Inventory")
     void GetSlots(TArray<USimpleInventorySlot*>& Result) const;
     
+    /**
+     * Get the authoritative slot storage without creating any `USimpleInventorySlot` views.
+     * After CopyInventory this copies the slots out of the shared snapshot; prefer GetNumSlots and GetSlotDataAt
+     * to read them one at a time.
+     *
+     * @return  The inventory's slots.
+     */
+    const TArray<FSimpleInventorySlot>& GetSlotData() const;
+    
+    /**
+     * Get the number of slots, including empty padding slots.
+     *
+     * @return  The number of slots.
+     */
+    int32 GetNumSlots() const;
+    
+    /**
+     * Get one slot without creating a `USimpleInventorySlot` view. After CopyInventory it is read from the shared
+     * snapshot, so nothing is copied. The reference is only valid until the inventory changes.
+     *
+     * @param Index  The index of the slot. Must be valid.
+     * @return       The slot at Index.
+     */
+    const FSimpleInventorySlot& GetSlotDataAt(const int32 Index) const;
+    
     /**
      * Check if the inventory contains a specific item with an exact count.
      *
@@ -119,7 +208,120 @@ public:
                  bool& Result);
     
     /**
-     * Copy the contents of another inventory into this one.
+     * Get the total amount of an item across all slots. O(1); totals are kept up to date by every change.
+     *
+     * @param ItemID  The ID of the item.
+     * @param Result  The total count, or 0 if the inventory does not hold the item.
+     */
+    UFUNCTION(BlueprintPure, Category="Simple Inventory")
+    void GetItemCount(const int32 ItemID,
+                      int32& Result) const;
+    
+    /**
+     * Check if the inventory holds at least Count of an item across all slots. O(1).
+     *
+     * @param ItemID  The ID of the item.
+     * @param Count   The minimum quantity required.
+     * @param Result  True if the total count of the item is at least Count.
+     */
+    UFUNCTION(BlueprintPure, Category="Simple Inventory")
+    void HasAtLeast(const int32 ItemID,
+                    const int32 Count,
+                    bool& Result) const;
+    
+    /**
+     * Sort the slots by a key. Empty slots move to the end. Broadcasts a single REORDER change carrying the permutation,
+     * or nothing if the slots were already in order. Large inventories are sorted across worker threads.
+     *
+     * @param Key  What to sort by, and in which direction.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void SortInventory(const FSimpleInventorySortKey& Key);
+    
+    /**
+     * Sort the slots with a custom comparison. Empty slots move to the end and are never passed to Less.
+     * Broadcasts a single REORDER change carrying the permutation, or nothing if the slots were already in order.
+     *
+     * @param Less  Returns true if the first slot sorts before the second. Must be safe to call from worker threads
+     *              when the inventory holds at least `FSimpleInventoryParallelSort::ParallelThreshold` slots.
+     */
+    void SortInventoryBy(TFunctionRef<bool(const FSimpleInventorySlot&, const FSimpleInventorySlot&)> Less);
+    
+    /**
+     * Merge partial stacks of the same item ID up to their stack size and compact the slots, in one pass.
+     * Slots keep the order of their first occurrence; empty slots move to the end, and padded inventories stay padded.
+     * Broadcasts a single BATCH change listing every slot that changed, or nothing if the slots were already consolidated.
+     *
+     * @param Result  The number of slots freed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void Consolidate(int32& Result);
+    
+    /**
+     * Move items from one of this inventory's slots into another inventory.
+     * See TransferItemsBatch; this is a transfer of a single entry.
+     *
+     * @param SlotIndex  The slot to move items out of.
+     * @param Target     The inventory to move them into.
+     * @param Count      How many items to move.
+     * @param Result     True if the items were moved, false if nothing changed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void TransferItems(const int32 SlotIndex,
+                       USimpleInventory* Target,
+                       const int32 Count,
+                       bool& Result);
+    
+    /**
+     * Move items from several of this inventory's slots into another inventory, all or nothing.
+     * Items merge into the target's stacks of the same ID first, as AddItem would. A slot that is emptied by the
+     * transfer moves its item into the target instead of copying it. Each inventory broadcasts a single TRANSFER
+     * change, after both have been updated, carrying the slots touched on both sides.
+     *
+     * @param Entries  The slots, as indexed before the transfer, and how many items to move out of each.
+     * @param Target   The inventory to move them into.
+     * @param Result   True if every entry was moved, false if nothing changed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void TransferItemsBatch(const TArray<FSimpleInventoryTransferEntry>& Entries,
+                            USimpleInventory* Target,
+                            bool& Result);
+    
+    /**
+     * Get the slots holding an item of a struct type or any struct derived from it.
+     * Answered from an index kept up to date by every change, so the cost depends on the number of results only.
+     *
+     * @param StructType  The item struct type, e.g. `FMyWeaponItem::StaticStruct()`.
+     * @param Result      The indices of the matching slots, ascending.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void GetSlotsOfType(const UScriptStruct* StructType,
+                        TArray<int32>& Result) const;
+    
+    /**
+     * Find the slots whose items match a query. The query is compiled for this call;
+     * from C++, prefer QueryItemsCompiled with a compiled query kept between calls.
+     *
+     * @param Query   The struct type and property conditions to match.
+     * @param Result  The indices of the matching slots, ascending.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void QueryItems(const FSimpleInventoryQuery& Query,
+                    TArray<int32>& Result) const;
+    
+    /**
+     * Find the slots whose items match a compiled query. No items are copied.
+     *
+     * @param Query   The compiled query. Reusing it across calls skips all property lookups.
+     * @param Result  The indices of the matching slots, ascending. Reset, not freed, so it can be reused as a buffer.
+     */
+    void QueryItemsCompiled(const FSimpleInventoryCompiledQuery& Query,
+                            TArray<int32>& Result) const;
+    
+    /**
+     * Copy the contents of another inventory into this one. O(1) when the other inventory's snapshot is up to date:
+     * the copy shares the other inventory's snapshot and only copies the slots out of it the first time they are
+     * read or changed. Changes to either inventory afterwards never affect the other.
      *
      * @param OtherInventory  The inventory to copy from.
      */
@@ -128,7 +330,7 @@ public:
     
     /**
      * Force the inventory to broadcast a change event.
-     * Useful for refreshing UI without actual changes.
+     * Useful for refreshing UI without actual changes. This is broadcast immediately, even inside a batch.
      */
     UFUNCTION(BlueprintCallable, Category="Simple Inventory")
     void ForceOnChange() const;
@@ -140,12 +342,303 @@ public:
     UFUNCTION(BlueprintCallable, Category="Simple Inventory")
     void ForceResize();
     
+    /**
+     * Start a batch of mutations. Until the matching EndBatch, changes are not broadcast individually;
+     * they are merged into a single BATCH change listing the affected slots and net item deltas.
+     * Batches may be nested; the merged change is broadcast when the outermost batch ends.
+     * The listed slots refer to the slots after the batch. FULL changes are not merged; they follow the BATCH change.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void BeginBatch();
+    
+    /**
+     * End a batch started with BeginBatch, broadcasting the merged change if anything changed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory")
+    void EndBatch();
+    
+    /**
+     * Check whether a batch is open.
+     *
+     * @return  True between BeginBatch and the matching EndBatch.
+     */
+    bool IsBatching() const;
+    
+    /**
+     * Replace every slot at once, e.g. with slots received through replication.
+     * Broadcasts one BATCH change listing ChangedSlotIndices and the net change per item.
+     *
+     * @param Slots               The new slots.
+     * @param ChangedSlotIndices  The slots that differ from the previous contents.
+     */
+    void ReplaceSlots(TArray<FSimpleInventorySlot>&& Slots,
+                      const TArray<int32>& ChangedSlotIndices);
+    
+    /**
+     * Replace every slot with restored slots in their exact layout, without stack merging.
+     * Broadcasts one LOAD change with the net change per item.
+     *
+     * @param Slots  The restored slots.
+     */
+    void RestoreSlots(TArray<FSimpleInventorySlot>&& Slots);
+    
+    /**
+     * Give every slot referencing the registered definition of one of the given items its own copy of it.
+     * Called by `FSimpleInventoryItemRegistry::Unregister` before the definitions go away. The items themselves
+     * do not change, so nothing is broadcast.
+     *
+     * @param ItemIDs  The items whose definitions are about to be removed.
+     */
+    void DetachDefinitions(const TSet<int32>& ItemIDs);
+    
+    /**
+     * Get the generation counter, incremented by every function that changes the slots.
+     * Compare against a previously read value to tell whether the inventory changed since then.
+     *
+     * @return  The current generation.
+     */
+    uint64 GetGeneration() const;
+    
+    /**
+     * Get an immutable snapshot of the slots. Returns the previous snapshot in O(1) if nothing changed since it was taken;
+     * otherwise only the chunks holding changed slots are copied and the rest are shared with the previous snapshot.
+     * Call on the game thread. The snapshot itself can be held and read on any thread.
+     *
+     * @return  The snapshot for the current generation.
+     */
+    FSimpleInventorySnapshot GetSnapshot() const;
+    
+    // Thread-safe reads. Slots are only changed on the game thread, which holds a write lock while it does;
+    // these functions take the read lock when called from any other thread.
+    
+    /**
+     * Check if the first slot holding an item has an exact count, as HasItem does. Safe to call from any thread.
+     *
+     * @param ItemID  The ID of the item to search for.
+     * @param Count   The exact quantity required.
+     * @return        True if the item exists with the specified count.
+     */
+    bool HasItemThreadSafe(const int32 ItemID,
+                           const int32 Count) const;
+    
+    /**
+     * Get the total amount of an item across all slots. Safe to call from any thread.
+     *
+     * @param ItemID  The ID of the item.
+     * @return        The total count, or 0 if the inventory does not hold the item.
+     */
+    int32 GetItemCountThreadSafe(const int32 ItemID) const;
+    
+    /**
+     * Get the number of slots. Safe to call from any thread.
+     *
+     * @return  The number of slots.
+     */
+    int32 GetLengthThreadSafe() const;
+    
+    /**
+     * Copy a slot. Safe to call from any thread.
+     *
+     * @param Index    The index of the slot.
+     * @param OutSlot  The copied slot.
+     * @return         False if the index is invalid.
+     */
+    bool GetSlotThreadSafe(const int32 Index,
+                           FSimpleInventorySlot& OutSlot) const;
+    
+    /**
+     * Run Reader over the slots while no change can happen. Safe to call from any thread.
+     * Keep Reader short; the game thread waits for it before it can change the inventory.
+     * Slots are handed out in place, in consecutive runs: all at once, or one shared chunk at a time
+     * while the inventory still reads from a copied inventory's snapshot.
+     *
+     * @param Reader  Called in slot order with each run of slots and the index of its first slot.
+     *                Must not keep references to them.
+     */
+    void ReadSlotsThreadSafe(TFunctionRef<void(TConstArrayView<FSimpleInventorySlot> Slots, const int32 FirstIndex)> Reader) const;
+    
 protected:
-    UPROPERTY(BlueprintReadWrite, EditAnywhere, SaveGame, Category="Simple Inventory")
-    TArray<USimpleInventorySlot*> InventorySlots;
+    /** The slots. Empty after CopyInventory until the first change; read them through GetSlotDataAt or GetSlotData. */
+    UPROPERTY(BlueprintReadOnly, SaveGame, Category="Simple Inventory")
+    TArray<FSimpleInventorySlot> InventorySlots;
     
 private:
+    /** `USimpleInventorySlot` views handed out by GetSlot / GetSlots, created on demand and reused per slot index. */
+    mutable TArray<TObjectPtr<USimpleInventorySlot>> SlotViews;
+    
+    /** Incremented on every slot change. */
+    uint64 Generation = 0;
+    
+    /** Slot count last added to the slot stat counter. */
+    int32 ReportedSlotCount = 0;
     
-    void AddItemToNewSlot(FInstancedStruct Item,
+    /** Held for writing by the game thread while it changes the slots; held for reading by the thread-safe reads off it. */
+    mutable FRWLock SlotLock;
+    
+    /** Nesting depth of FSlotWriteScope on the game thread. The lock is taken at depth one. */
+    mutable int32 SlotWriteDepth = 0;
+    
+    /** A change made inside a write scope, with its own copy of the item it reports. */
+    struct FQueuedChange
+    {
+        FSimpleInventoryChange Change;
+        
+        FInstancedStruct Item;
+    };
+    
+    /** Changes waiting for the outermost write scope to end, so listeners never run in the middle of a mutation. */
+    mutable TArray<FQueuedChange> QueuedChanges;
+    
+    /**
+     * Holds SlotLock for writing while a mutator runs. Nested scopes share the outermost lock.
+     * Changes made inside are broadcast once the outermost scope has released the lock.
+     * Applies a pending copy first, unless bApplyPendingCopy is false because the slots are about to be replaced.
+     */
+    struct FSlotWriteScope : public FNoncopyable
+    {
+        explicit FSlotWriteScope(const USimpleInventory* InInventory,
+                                 const bool bApplyPendingCopy = true);
+        
+        ~FSlotWriteScope();
+        
+        const USimpleInventory* Inventory;
+    };
+    
+    /** The snapshot last returned by GetSnapshot. Chunks that did not change since are shared with the next one. */
+    mutable FSimpleInventorySnapshot CachedSnapshot;
+    
+    /** Chunks of CachedSnapshot holding slots that changed since it was taken. */
+    mutable TSet<int32> DirtySnapshotChunks;
+    
+    /** Every chunk of CachedSnapshot from this one on is out of date, e.g. because slots shifted down. */
+    mutable int32 FirstDirtySnapshotChunk = MAX_int32;
+    
+    /**
+     * Slots copied by CopyInventory that have not been copied into InventorySlots yet. Shares its chunks with the
+     * source inventory's snapshot. While valid, InventorySlots is empty; the slot indices and ItemTotals already
+     * describe the copied slots.
+     */
+    FSimpleInventorySnapshot PendingCopy;
+    
+    /** Depth of nested BeginBatch calls. */
+    int32 BatchDepth = 0;
+    
+    /** True once a change has been merged into the open batch. */
+    bool bBatchHasChanges = false;
+    
+    /** Slots touched while a batch is open. */
+    TSet<int32> PendingBatchSlotIndices;
+    
+    /**
+     * Lowest slot index at which slots moved while a batch is open, e.g. because a slot was removed.
+     * Earlier entries of PendingBatchSlotIndices from there on may name moved slots, so every slot from here on is reported.
+     */
+    int32 PendingBatchFirstShiftedSlot = MAX_int32;
+    
+    /** FULL changes made while a batch is open. They change no slots, so they are broadcast as they are after the batch. */
+    TArray<FSimpleInventoryChange> PendingBatchFullChanges;
+    
+    /** Net item deltas accumulated while a batch is open. */
+    TMap<int32, int32> PendingBatchItemDeltas;
+    
+    /** Slot indices holding each item ID, kept sorted ascending. Derived from InventorySlots, or copied with PendingCopy. */
+    TMap<int32, TArray<int32>> SlotIndicesByItemID;
+    
+    /**
+     * Slot indices holding each item struct type, kept sorted ascending. A slot is listed under its item's struct
+     * and every parent struct. Derived from InventorySlots, or copied with PendingCopy.
+     */
+    TMap<const UScriptStruct*, TArray<int32>> SlotIndicesByStructType;
+    
+    /** Total count of each item ID across all slots. Updated from the item deltas of every change in NotifyChange. */
+    TMap<int32, int32> ItemTotals;
+    
+    int32 AddResolvedItem(const FConstStructView Item,
+                          const FSimpleInventoryItemAccessor& ItemAccessor,
+                          const int32 ItemID,
+                          const int32 Count);
+    
+    int32 RemoveItemCount(const int32 ItemID,
+                          const int32 Count);
+    
+    int32 GetFreeStackSpace(const int32 ItemID) const;
+    
+    int32 GetItemTotal(const int32 ItemID) const;
+    
+    void ApplySortOrder(TFunctionRef<bool(const int32, const int32)> Less);
+    
+    bool ApplyTransfer(const TArray<FSimpleInventoryTransferEntry>& Entries,
+                       USimpleInventory& Target,
+                       FSimpleInventoryChange& SourceChange,
+                       FSimpleInventoryChange& TargetChange);
+    
+    void AddItemToNewSlot(const FConstStructView Item,
+                          const int32 ItemID,
                           const int32 Count);
+    
+    USimpleInventorySlot* GetSlotView(const int32 Index) const;
+    
+    int32 FindFirstSlotIndex(const int32 ItemID) const;
+    
+    void ReadThreadSafe(TFunctionRef<void()> Reader) const;
+    
+    void IndexSlot(const int32 Index);
+    
+    void UnindexSlot(const int32 Index);
+    
+    FSimpleInventorySlot RemoveSlotAt(const int32 Index);
+    
+    void RebuildSlotIndex();
+    
+    static void InsertSlotIndex(TArray<int32>& SlotIndices,
+                                const int32 Index);
+    
+    static void RemoveSlotIndex(TArray<int32>& SlotIndices,
+                                const int32 Index);
+    
+    void AdjustItemTotal(const int32 ItemID,
+                         const int32 Delta);
+    
+    void MarkSnapshotSlotChanged(const int32 Index);
+    
+    void MarkSnapshotSlotsShifted(const int32 FirstIndex);
+    
+    void AccumulateItemTotals(TMap<int32, int32>& Result,
+                              const int32 Sign) const;
+    
+    void ResolvePendingCopy() const;
+    
+    void ApplyPendingCopy();
+    
+    void NotifyChange(const FSimpleInventoryChange& Change);
+    
+    void RecordChange(const FSimpleInventoryChange& Change);
+    
+    void DispatchChange(const FSimpleInventoryChange& Change);
+    
+    void BroadcastChange(const FSimpleInventoryChange& Change) const;
+    
+    void QueueChange(const FSimpleInventoryChange& Change) const;
+    
+    void BroadcastQueuedChanges() const;
+};
+
+/**
+ * Opens a batch on an inventory for the lifetime of the scope.
+ *
+ *     {
+ *         FSimpleInventoryBatchScope Batch(Inventory);
+ *         Inventory->AddItem(...);
+ *         Inventory->RemoveItemAtIndex(...);
+ *     } // One BATCH change is broadcast here.
+ */
+class SIMPLEINVENTORY_API FSimpleInventoryBatchScope : public FNoncopyable
+{
+public:
+    explicit FSimpleInventoryBatchScope(USimpleInventory* InInventory);
+    
+    ~FSimpleInventoryBatchScope();
+    
+private:
+    TWeakObjectPtr<USimpleInventory> Inventory;
 };
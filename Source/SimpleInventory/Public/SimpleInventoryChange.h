@@ -5,11 +5,102 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
 
 #include "SimpleInventoryChangeType.h"
 
 #include "SimpleInventoryChange.generated.h"
 
+/**
+ * Net change in the amount of a single item.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryItemDelta
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    int32 ItemID = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    int32 Delta = 0;
+};
+
+/**
+ * Describes a single change to an inventory. Broadcast by const reference through the native change delegates,
+ * so no allocation is made per change.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryChange
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    FName InventoryName;
+    
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    ESimpleInventoryChangeType Type = ESimpleInventoryChangeType::ADDITION;
+    
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    int32 ItemID = 0;
+    
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    int32 Count = 0;
+    
+    /** Net change in the amount of ItemID. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    int32 Delta = 0;
+    
+    /** The slot the change applied to, or INDEX_NONE. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    int32 SlotIndex = INDEX_NONE;
+    
+    /** Every slot touched by a MULTI_REMOVAL, BATCH, REORDER or TRANSFER change, as indexed when each step was applied. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    TArray<int32> SlotIndices;
+    
+    /** Net change per item for MULTI_REMOVAL, CLEAR, COPY, BATCH, LOAD and TRANSFER changes. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    TArray<FSimpleInventoryItemDelta> ItemDeltas;
+    
+    /** For REORDER changes, the previous index of the slot now at each index. Empty otherwise. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    TArray<int32> Permutation;
+    
+    /** For TRANSFER changes, the inventory on the other side of the transfer. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    FName TransferInventoryName;
+    
+    /** For TRANSFER changes, the slots touched in the other inventory. Together with SlotIndices this describes both sides. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    TArray<int32> TransferSlotIndices;
+    
+    /** For TRANSFER changes, true if the items left this inventory and false if they arrived in it. */
+    UPROPERTY(BlueprintReadOnly, Category="Simple Inventory Change")
+    bool bIsTransferSource = false;
+    
+    /**
+     * Add an amount to the net change of an item in ItemDeltas.
+     *
+     * @param InItemID  The item.
+     * @param InDelta   The amount to add.
+     */
+    void AddItemDelta(const int32 InItemID,
+                      const int32 InDelta);
+    
+    /**
+     * Replace ItemDeltas with the non-zero entries of a map of item ID to delta.
+     *
+     * @param InItemDeltas  Net change keyed by item ID.
+     */
+    void SetItemDeltas(const TMap<int32, int32>& InItemDeltas);
+    
+    /** The item involved in the change, if any. Only valid for the duration of the broadcast. */
+    FConstStructView Item;
+};
+
 UCLASS(ClassGroup=(SimpleInventory), Blueprintable, BlueprintType)
 class SIMPLEINVENTORY_API USimpleInventoryChange : public UObject
 {
@@ -27,4 +118,30 @@ public:
     
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Change")
     int32 Count = 0;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Change")
+    TArray<int32> SlotIndices;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Change")
+    TArray<FSimpleInventoryItemDelta> ItemDeltas;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Change")
+    TArray<int32> Permutation;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Change")
+    FName TransferInventoryName;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Change")
+    TArray<int32> TransferSlotIndices;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Change")
+    bool bIsTransferSource = false;
+    
+    /**
+     * Create a change object for the Blueprint change delegates from a native change.
+     *
+     * @param Change  The native change to copy.
+     * @return        A new change object owning a copy of the item.
+     */
+    static USimpleInventoryChange* Create(const FSimpleInventoryChange& Change);
 };
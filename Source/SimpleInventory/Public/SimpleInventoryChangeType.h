@@ -16,5 +16,9 @@ enum class ESimpleInventoryChangeType : uint8
     CLEAR UMETA(DisplayName = "Clear"),
     COPY UMETA(DisplayName = "Copy"),
     FORCE UMETA(DisplayName = "Force"),
-    FULL UMETA(DisplayName = "Full")
+    FULL UMETA(DisplayName = "Full"),
+    BATCH UMETA(DisplayName = "Batch"),
+    LOAD UMETA(DisplayName = "Load"),
+    REORDER UMETA(DisplayName = "Reorder"),
+    TRANSFER UMETA(DisplayName = "Transfer")
 };
@@ -6,10 +6,14 @@
 #include "StructUtils/InstancedStruct.h"
 #include "Components/ActorComponent.h"
 
+#include "SimpleInventoryItemEntry.h"
+#include "SimpleInventoryReplicatedSlots.h"
+
 #include "SimpleInventoryComponent.generated.h"
 
 class USimpleInventorySlot;
 class USimpleInventory;
+struct FSimpleInventoryChange;
 
 UCLASS(ClassGroup=(SimpleInventory), meta=(BlueprintSpawnableComponent))
 class SIMPLEINVENTORY_API USimpleInventoryComponent : public UActorComponent
@@ -17,6 +21,16 @@ class SIMPLEINVENTORY_API USimpleInventoryComponent : public UActorComponent
     GENERATED_BODY()
     
 public:
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnSimpleInventorySlotReplicatedDelegate, int32, SlotIndex, int32, ItemID, int32, Count);
+    DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSimpleInventorySlotReplicatedNativeDelegate, const int32, const FSimpleInventorySlot&);
+    
+    /** Client only. Broadcast for each slot changed by replication, after the local inventory has been updated. Count is 0 for removed slots. */
+    UPROPERTY(BlueprintAssignable, Category="Simple Inventory Component")
+    FOnSimpleInventorySlotReplicatedDelegate OnSlotReplicated;
+    
+    /** Native version of OnSlotReplicated. Removed slots are passed as an empty slot. */
+    FOnSimpleInventorySlotReplicatedNativeDelegate OnSlotReplicatedNative;
+    
     UPROPERTY(BlueprintReadWrite, EditAnywhere, SaveGame, Category="Simple Inventory Component")
     USimpleInventory* Inventory;
     
@@ -25,6 +39,8 @@ public:
     
     USimpleInventoryComponent();
     
+    void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+    
     /**
      * Add an item to this inventory.
      *
@@ -36,6 +52,17 @@ public:
                  const int32 Count,
                  bool& Result);
     
+    /**
+     * Add an item by ID to this inventory, using its registered item definition.
+     *
+     * @param ItemID  The ID of a registered item definition.
+     * @param Count   The number of items to add.
+     * @param Result  True if the item(s) were successfully added.
+     */
+    void AddItemByID(const int32 ItemID,
+                     const int32 Count,
+                     bool& Result);
+    
     /**
      * Remove a number of items from a specific slot.
      *
@@ -56,6 +83,32 @@ public:
     void RemoveItems(const TArray<FInstancedStruct>& Items,
                      bool& Result);
     
+    /**
+     * Add several items to this inventory, broadcasting a single BATCH change.
+     *
+     * @param Entries        The items and amounts to add.
+     * @param bAllOrNothing  If true, nothing is added unless every entry fits.
+     * @param EntryResults   True for each entry that was fully added.
+     * @param Result         True if every entry was fully added.
+     */
+    void AddItems(const TArray<FSimpleInventoryItemEntry>& Entries,
+                  const bool bAllOrNothing,
+                  TArray<bool>& EntryResults,
+                  bool& Result);
+    
+    /**
+     * Remove amounts of several items by ID from this inventory, broadcasting a single BATCH change.
+     *
+     * @param Entries        The item IDs and amounts to remove.
+     * @param bAllOrNothing  If true, nothing is removed unless every entry can be fully removed.
+     * @param EntryResults   True for each entry that was fully removed.
+     * @param Result         True if every entry was fully removed.
+     */
+    void RemoveItemsByCount(const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                            const bool bAllOrNothing,
+                            TArray<bool>& EntryResults,
+                            bool& Result);
+    
     /**
      * Clear all items from this inventory.
      */
@@ -91,6 +144,26 @@ public:
      */
     void GetSlots(TArray<USimpleInventorySlot*>& Result) const;
     
+    /**
+     * Get the total amount of an item across all slots.
+     *
+     * @param ItemID  The ID of the item.
+     * @param Result  Outputs the total count, or 0 if the item is not held.
+     */
+    void GetItemCount(const int32 ItemID,
+                      int32& Result) const;
+    
+    /**
+     * Check if this inventory holds at least Count of an item across all slots.
+     *
+     * @param ItemID  The ID of the item.
+     * @param Count   The minimum quantity required.
+     * @param Result  True if the total count of the item is at least Count.
+     */
+    void HasAtLeast(const int32 ItemID,
+                    const int32 Count,
+                    bool& Result) const;
+    
     /**
      * Copy the contents of another inventory into this one.
      *
@@ -104,6 +177,32 @@ public:
      */
     void ForceOnChange() const;
     
+    /**
+     * Record that a replicated slot changed. Called by `FSimpleInventoryReplicatedSlot` on clients.
+     *
+     * @param SlotIndex  The slot that was added, changed or removed.
+     */
+    void MarkReplicatedSlotChanged(const int32 SlotIndex);
+    
+    /**
+     * Rebuild the local inventory from the replicated slots and broadcast OnSlotReplicated for each changed slot.
+     * Called by `FSimpleInventoryReplicatedSlots` on clients after each received update.
+     */
+    void ApplyReplicatedSlots();
+    
 protected:
+    /** Server-authoritative copy of the inventory slots, replicated to the owning client only. */
+    UPROPERTY(Replicated)
+    FSimpleInventoryReplicatedSlots ReplicatedSlots;
+    
     void BeginPlay() override;
+    
+    void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    
+private:
+    TSet<int32> PendingReplicatedSlotIndices;
+    
+    void HandleInventoryChange(const FSimpleInventoryChange& Change);
+    
+    void SyncReplicatedSlots(const int32 FirstIndex);
 };
@@ -0,0 +1,48 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+
+#include "SimpleInventoryHandle.generated.h"
+
+/**
+ * Refers to an inventory registered with `USimpleInventorySubsystem`. Resolving a handle is an array lookup,
+ * unlike an inventory name, which is hashed on every call.
+ *
+ * Index is the inventory's position in the subsystem's dense inventory array, and Serial is the registration it
+ * was issued for. Once the inventory is unregistered the serial no longer matches, so a stale handle resolves to
+ * nothing even after its index is reused.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryHandle
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY()
+    int32 Index = INDEX_NONE;
+
+    UPROPERTY()
+    int32 Serial = 0;
+
+    /** True if the handle was issued by a subsystem. It may still be stale; the subsystem checks that when resolving it. */
+    bool IsSet() const {
+        return Index != INDEX_NONE;
+    }
+
+    FString ToString() const;
+
+    bool operator==(const FSimpleInventoryHandle& Other) const {
+        return Index == Other.Index && Serial == Other.Serial;
+    }
+
+    bool operator!=(const FSimpleInventoryHandle& Other) const {
+        return !(*this == Other);
+    }
+
+    friend uint32 GetTypeHash(const FSimpleInventoryHandle& Handle) {
+        return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Serial));
+    }
+};
@@ -0,0 +1,75 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FBoolProperty;
+class UScriptStruct;
+
+/**
+ * Resolved property offsets for the fields `USimpleInventory` reads from item structs (`ID`, `bIsStackable`, `StackSize`).
+ * Reading through an accessor replaces a `FindPropertyByName` per slot with a direct offset read.
+ */
+struct SIMPLEINVENTORY_API FSimpleInventoryItemAccessor
+{
+    /** Byte offset of the `ID` int property, or INDEX_NONE if the struct has none. */
+    int32 IDOffset = INDEX_NONE;
+
+    /** Byte offset of the `StackSize` int property, or INDEX_NONE if the struct has none. */
+    int32 StackSizeOffset = INDEX_NONE;
+
+    /** The `bIsStackable` property. Kept as a property so bitfield bools are read correctly. */
+    const FBoolProperty* IsStackableProperty = nullptr;
+
+    /** True if the struct has a readable `ID`. */
+    bool IsValid() const {
+        return IDOffset != INDEX_NONE;
+    }
+
+    /** True if the struct has both `bIsStackable` and `StackSize`. */
+    bool HasStackInfo() const {
+        return IsStackableProperty != nullptr && StackSizeOffset != INDEX_NONE;
+    }
+
+    int32 GetID(const void* Memory) const {
+        return *reinterpret_cast<const int32*>(static_cast<const uint8*>(Memory) + IDOffset);
+    }
+
+    int32 GetStackSize(const void* Memory) const {
+        return *reinterpret_cast<const int32*>(static_cast<const uint8*>(Memory) + StackSizeOffset);
+    }
+
+    bool IsStackable(const void* Memory) const;
+};
+
+/**
+ * Registry of `FSimpleInventoryItemAccessor` keyed by item struct type.
+ * Accessors are resolved the first time a struct type is seen and reused until the cache is reset,
+ * which happens automatically after a hot reload, when objects are reinstanced and when a UserDefinedStruct is recompiled.
+ * The cache is guarded by a read/write lock, so it can be read from worker threads.
+ */
+class SIMPLEINVENTORY_API FSimpleInventoryItemAccessorCache
+{
+public:
+    /**
+     * Get the accessor for a struct type, resolving it on first use.
+     *
+     * @param StructType  The item struct type.
+     * @return            The resolved accessor. Invalid if StructType is null or has no `ID` property.
+     */
+    static FSimpleInventoryItemAccessor Get(const UScriptStruct* StructType);
+
+    /**
+     * Drop every cached accessor. Called when struct layouts may have changed (hot reload / live coding,
+     * reinstancing, UserDefinedStruct compiles).
+     */
+    static void Reset();
+
+private:
+    static FSimpleInventoryItemAccessor Resolve(const UScriptStruct* StructType);
+
+    static TMap<const UScriptStruct*, FSimpleInventoryItemAccessor> Accessors;
+    static FRWLock AccessorsLock;
+};
@@ -0,0 +1,57 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "StructUtils/InstancedStruct.h"
+
+#include "SimpleInventoryItemEntry.generated.h"
+
+/**
+ * An item and an amount, used by `USimpleInventory::AddItems`.
+ */
+USTRUCT(Blueprintable, BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryItemEntry
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Item Entry")
+    FInstancedStruct Item;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Item Entry")
+    int32 Count = 0;
+};
+
+/**
+ * An item ID and an amount, used by `USimpleInventory::RemoveItemsByCount`.
+ */
+USTRUCT(Blueprintable, BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryItemCountEntry
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Item Entry")
+    int32 ItemID = 0;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Item Entry")
+    int32 Count = 0;
+};
+
+/**
+ * A slot and an amount to move out of it, used by `USimpleInventory::TransferItemsBatch`.
+ */
+USTRUCT(Blueprintable, BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryTransferEntry
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Item Entry")
+    int32 SlotIndex = INDEX_NONE;
+    
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Item Entry")
+    int32 Count = 0;
+};
@@ -0,0 +1,105 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "StructUtils/StructView.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UDataTable;
+
+/**
+ * One published set of item definitions. Never modified once published; the registry publishes a new set
+ * whenever its tables change. Holding a set keeps the tables its definitions point into alive.
+ */
+struct FSimpleInventoryItemDefinitions
+{
+    TMap<int32, FConstStructView> Definitions;
+    
+    TArray<TStrongObjectPtr<UDataTable>> Tables;
+    
+    /** The definition for an item ID, or an invalid view if the ID is not in this set. */
+    FConstStructView Find(const int32 ItemID) const {
+        const FConstStructView* Definition = Definitions.Find(ItemID);
+        return Definition ? *Definition : FConstStructView();
+    }
+};
+
+/**
+ * Shared, read-only item definitions keyed by item `ID`, built from DataTables of `FSimpleInventoryItem` rows.
+ * Slots whose item matches its registered definition reference the table row instead of holding their own copy,
+ * so static items cost no heap allocation or `FText` copy per slot.
+ * Registered tables are kept alive until they are unregistered or the registry is reset, and after that for as long
+ * as a snapshot still references their definitions.
+ *
+ * Tables are registered and unregistered on the game thread. Find and GetDefinitions may be called from any thread:
+ * the definitions are published as immutable sets, swapped under a read/write lock.
+ */
+class SIMPLEINVENTORY_API FSimpleInventoryItemRegistry
+{
+public:
+    /**
+     * Register every row of a DataTable as an item definition.
+     * Rows must be `FSimpleInventoryItem` or a struct with an `ID` int property. Later tables override earlier IDs.
+     *
+     * @param ItemTable  The table to register.
+     */
+    static void Register(UDataTable* ItemTable);
+    
+    /**
+     * Remove a previously registered DataTable. Inventory slots referencing its definitions get their own copy first,
+     * so they keep their item. Snapshots taken earlier keep reporting the definitions they captured.
+     *
+     * @param ItemTable  The table to remove.
+     */
+    static void Unregister(UDataTable* ItemTable);
+    
+    /**
+     * Get the definition for an item ID.
+     *
+     * @param ItemID  The item ID.
+     * @return        A view of the table row, or an invalid view if the ID is not registered.
+     */
+    static FConstStructView Find(const int32 ItemID);
+    
+    /**
+     * Get the current set of definitions. The set stays valid and unchanged for as long as it is held.
+     *
+     * @return  The published definitions, or null if no table was ever registered.
+     */
+    static TSharedPtr<const FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe> GetDefinitions();
+    
+    /**
+     * Check whether an item is identical to the registered definition for its ID, and so needs no per-slot copy.
+     *
+     * @param ItemID  The item ID.
+     * @param Item    The item to compare.
+     * @return        True if a definition exists with the same struct type and values.
+     */
+    static bool Matches(const int32 ItemID,
+                        const FConstStructView Item);
+    
+    /** The number of registered definitions. */
+    static int32 Num();
+    
+    /**
+     * Drop every registered table and definition.
+     */
+    static void Reset();
+    
+private:
+    struct FRegisteredTable
+    {
+        TStrongObjectPtr<UDataTable> Table;
+        FDelegateHandle ChangedHandle;
+    };
+    
+    static void Rebuild();
+    
+    static TArray<FRegisteredTable> Tables;
+    
+    static TSharedPtr<const FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe> Definitions;
+    static FRWLock DefinitionsLock;
+};
@@ -4,6 +4,10 @@
 
 #include "Modules/ModuleManager.h"
 
+#if WITH_EDITOR
+class FSimpleInventoryStructChangeListener;
+#endif
+
 class FSimpleInventoryModule : public IModuleInterface
 {
 public:
@@ -11,4 +15,12 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+
+#if WITH_EDITOR
+	TUniquePtr<FSimpleInventoryStructChangeListener> StructChangeListener;
+#endif
 };
@@ -0,0 +1,150 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "StructUtils/StructView.h"
+
+#include "SimpleInventoryQuery.generated.h"
+
+class FNumericProperty;
+class FProperty;
+class UScriptStruct;
+
+UENUM(BlueprintType)
+enum class ESimpleInventoryQueryOperator : uint8
+{
+    EQUAL UMETA(DisplayName = "Equal"),
+    NOT_EQUAL UMETA(DisplayName = "Not Equal"),
+    LESS UMETA(DisplayName = "Less"),
+    LESS_OR_EQUAL UMETA(DisplayName = "Less Or Equal"),
+    GREATER UMETA(DisplayName = "Greater"),
+    GREATER_OR_EQUAL UMETA(DisplayName = "Greater Or Equal")
+};
+
+/**
+ * Compares one property of an item against a value.
+ * Supported property types: integers, floats, enums, bool, FName, FString and FText.
+ * Bool, FName and FText only support EQUAL and NOT_EQUAL.
+ */
+USTRUCT(Blueprintable, BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryQueryCondition
+{
+    GENERATED_BODY()
+
+public:
+    /** The name of the item property to compare, e.g. `Rarity`. */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Query")
+    FName PropertyName;
+
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Query")
+    ESimpleInventoryQueryOperator Operator = ESimpleInventoryQueryOperator::EQUAL;
+
+    /** The value to compare against, as text. Parsed once per item struct type; enum values may use their name. */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Query")
+    FString Value;
+};
+
+/**
+ * A filter over inventory slots: an item struct type and property conditions, all of which must match.
+ * Run it with `USimpleInventory::QueryItems`, or compile it once into an `FSimpleInventoryCompiledQuery`.
+ */
+USTRUCT(Blueprintable, BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventoryQuery
+{
+    GENERATED_BODY()
+
+public:
+    /** Only items of this struct type or a child of it match. Leave empty to match any item type. */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Query")
+    TObjectPtr<const UScriptStruct> StructType;
+
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Query")
+    TArray<FSimpleInventoryQueryCondition> Conditions;
+};
+
+/**
+ * An `FSimpleInventoryQuery` ready to run. The first time an item struct type is seen, every condition is resolved
+ * to a property and its value is parsed to that property's type; after that, matching an item only reads memory
+ * at the resolved offsets. Keep a compiled query around and reuse it to skip all reflection lookups.
+ *
+ * Not thread-safe: resolving a new struct type updates the cache. Recompile after a hot reload.
+ */
+class SIMPLEINVENTORY_API FSimpleInventoryCompiledQuery
+{
+public:
+    FSimpleInventoryCompiledQuery() = default;
+
+    explicit FSimpleInventoryCompiledQuery(const FSimpleInventoryQuery& InQuery);
+
+    /**
+     * Check an item against the query.
+     *
+     * @param Item  The item to test.
+     * @return      True if the item is of the query's struct type and matches every condition.
+     */
+    bool Matches(const FConstStructView Item) const;
+
+    /** The struct type filter, or nullptr if any type matches. */
+    const UScriptStruct* GetStructType() const {
+        return StructType;
+    }
+
+private:
+    enum class EValueKind : uint8
+    {
+        Integer,
+        UnsignedInteger,
+        Float,
+        Bool,
+        Name,
+        String,
+        Text
+    };
+
+    /** A condition resolved against one struct type. */
+    struct FResolvedCondition
+    {
+        /** The property on the item struct; locates the value inside the item. */
+        const FProperty* Property = nullptr;
+        /** Reads Integer, UnsignedInteger and Float values. For enums, this is the enum's underlying integer property. */
+        const FNumericProperty* NumericProperty = nullptr;
+        EValueKind Kind = EValueKind::Integer;
+        ESimpleInventoryQueryOperator Operator = ESimpleInventoryQueryOperator::EQUAL;
+        int64 IntValue = 0;
+        uint64 UnsignedValue = 0;
+        double FloatValue = 0.0;
+        bool bBoolValue = false;
+        FName NameValue;
+        FString StringValue;
+        FText TextValue;
+    };
+
+    /** Every condition resolved against one struct type. bMatchesType is false if the type can never match. */
+    struct FResolvedType
+    {
+        const UScriptStruct* Struct = nullptr;
+        bool bMatchesType = false;
+        TArray<FResolvedCondition> Conditions;
+    };
+
+    const FResolvedType& Resolve(const UScriptStruct* Struct) const;
+
+    bool ResolveCondition(const UScriptStruct* Struct,
+                          const FSimpleInventoryQueryCondition& Condition,
+                          FResolvedCondition& Result) const;
+
+    static bool EvaluateCondition(const FResolvedCondition& Condition,
+                                  const void* Memory);
+
+    const UScriptStruct* StructType = nullptr;
+
+    TArray<FSimpleInventoryQueryCondition> Conditions;
+
+    /** Resolved conditions per item struct type seen so far. Inventories rarely hold more than a few types. */
+    mutable TArray<FResolvedType> ResolvedTypes;
+
+    /** Index into ResolvedTypes of the last type matched, checked first since slots of one type tend to cluster. */
+    mutable int32 LastResolvedIndex = INDEX_NONE;
+};
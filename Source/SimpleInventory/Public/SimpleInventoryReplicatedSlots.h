@@ -0,0 +1,89 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/InstancedStruct.h"
+#include "Net/Serialization/FastArraySerializer.h"
+
+#include "SimpleInventorySlot.h"
+
+#include "SimpleInventoryReplicatedSlots.generated.h"
+
+class USimpleInventoryComponent;
+struct FSimpleInventoryReplicatedSlots;
+
+/**
+ * Replicated copy of one `FSimpleInventorySlot`.
+ * Entries are kept in slot order on the server, so SlotIndex only changes for entries whose slot content moved.
+ */
+USTRUCT()
+struct SIMPLEINVENTORY_API FSimpleInventoryReplicatedSlot : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+    
+public:
+    /** Per-instance item state. Empty when the slot uses the registered definition for ItemID. */
+    UPROPERTY()
+    FInstancedStruct Item;
+    
+    UPROPERTY()
+    int32 SlotIndex = INDEX_NONE;
+    
+    UPROPERTY()
+    int32 ItemID = 0;
+    
+    UPROPERTY()
+    int32 Count = 0;
+    
+    UPROPERTY()
+    bool bUsesDefinition = false;
+    
+    /** True if this entry already holds the same content as Slot. */
+    bool Matches(const FSimpleInventorySlot& Slot) const;
+    
+    /** Copy the content of Slot into this entry. */
+    void SetSlot(const FSimpleInventorySlot& Slot);
+    
+    /** Copy the content of this entry into Slot. */
+    void GetSlot(FSimpleInventorySlot& Slot) const;
+    
+    void PreReplicatedRemove(const FSimpleInventoryReplicatedSlots& InArraySerializer);
+    
+    void PostReplicatedAdd(const FSimpleInventoryReplicatedSlots& InArraySerializer);
+    
+    void PostReplicatedChange(const FSimpleInventoryReplicatedSlots& InArraySerializer);
+};
+
+/**
+ * Fast array of replicated slots owned by a `USimpleInventoryComponent`.
+ * Only entries marked dirty on the server are sent, so a change to one stack sends one entry instead of every slot.
+ */
+USTRUCT()
+struct SIMPLEINVENTORY_API FSimpleInventoryReplicatedSlots : public FFastArraySerializer
+{
+    GENERATED_BODY()
+    
+public:
+    UPROPERTY()
+    TArray<FSimpleInventoryReplicatedSlot> Items;
+    
+    /** The component that owns this array. Receives the client-side callbacks. */
+    UPROPERTY(NotReplicated)
+    TObjectPtr<USimpleInventoryComponent> Owner;
+    
+    void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+    
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms) {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FSimpleInventoryReplicatedSlot, FSimpleInventoryReplicatedSlots>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FSimpleInventoryReplicatedSlots> : public TStructOpsTypeTraitsBase2<FSimpleInventoryReplicatedSlots>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
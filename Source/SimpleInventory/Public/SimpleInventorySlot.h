@@ -4,13 +4,73 @@
 
 #include "CoreMinimal.h"
 #include "StructUtils/InstancedStruct.h"
+#include "StructUtils/StructView.h"
 
 #include "SimpleInventoryItem.h"
 
 #include "SimpleInventorySlot.generated.h"
 
+/**
+ * A single inventory slot: an item and the amount "stacked" in it.
+ * This is the authoritative slot storage inside `USimpleInventory`.
+ * Items identical to their definition in `FSimpleInventoryItemRegistry` are referenced by ID; only items with
+ * unique per-instance state keep their own copy in `Item`.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventorySlot
+{
+    GENERATED_BODY()
+
+public:
+    /** Per-instance item state. Empty when the slot uses the registered definition for ItemID; use GetItem to read either. */
+    UPROPERTY(BlueprintReadOnly, SaveGame, Category="Simple Inventory Slot")
+    FInstancedStruct Item;
+    
+    UPROPERTY(BlueprintReadOnly, SaveGame, Category="Simple Inventory Slot")
+    int32 Count = 0;
+    
+    /** The `ID` read from Item when the slot was filled. Only meaningful if the slot is not empty. */
+    UPROPERTY(BlueprintReadOnly, SaveGame, Category="Simple Inventory Slot")
+    int32 ItemID = 0;
+    
+    /** True if the slot references the registered definition for ItemID instead of holding its own Item. */
+    UPROPERTY(BlueprintReadOnly, SaveGame, Category="Simple Inventory Slot")
+    bool bUsesDefinition = false;
+    
+    /**
+     * Only set on slots inside a snapshot: the definition ItemID resolved to when the snapshot was taken,
+     * so unregistering or replacing a table later does not change what the snapshot reports.
+     */
+    FConstStructView CapturedDefinition;
+    
+    /** True if the slot holds no item (e.g. padding added by `USimpleInventory::ForceResize`). */
+    bool IsEmpty() const {
+        return !Item.IsValid() && !bUsesDefinition;
+    }
+    
+    /** The item in this slot: the per-instance Item if present, otherwise the captured or registered definition. */
+    FConstStructView GetItem() const;
+    
+    /**
+     * Converts a slot saved as a `USimpleInventorySlot` object, from before slots were stored as structs.
+     * Called by the property system when the saved tag does not match this struct.
+     */
+    bool SerializeFromMismatchedTag(const FPropertyTag& Tag, FArchive& Ar);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSimpleInventorySlot> : public TStructOpsTypeTraitsBase2<FSimpleInventorySlot>
+{
+    enum
+    {
+        WithSerializeFromMismatchedTag = true,
+    };
+};
+
 /**
  * Object to hold `FSimpleInventoryItem` and the amount "stacked" as a single slot.
+ * Kept as a compatibility view over `FSimpleInventorySlot`: the values are refreshed each time the slot is
+ * requested from its inventory, and writes to it are not applied back to the inventory.
  */
 UCLASS(ClassGroup=(SimpleInventory), BlueprintType, Blueprintable)
 class SIMPLEINVENTORY_API USimpleInventorySlot : public UObject
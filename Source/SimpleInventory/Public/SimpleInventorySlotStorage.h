@@ -14,9 +14,14 @@ struct SIMPLEINVENTORY_API FSimpleInventorySlotStorage
 	GENERATED_BODY()
 	
 public:
+    /** The item's per-instance state. Left empty for items that use their registered definition. */
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Slot Storage")
     FInstancedStruct Metadata;
     
+    /** The item ID, used to look up the registered definition when Metadata is empty. */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Slot Storage")
+    int32 ItemID = 0;
+    
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Slot Storage")
     int32 Count = 0;
 };
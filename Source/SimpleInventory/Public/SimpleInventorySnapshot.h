@@ -0,0 +1,103 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+
+#include "SimpleInventoryItemRegistry.h"
+#include "SimpleInventorySlot.h"
+
+/**
+ * A run of consecutive slots inside a snapshot. Never modified once published, so snapshots of the same
+ * inventory share every chunk whose slots did not change between them.
+ *
+ * Every chunk registers itself while it is alive, and the items of all registered chunks are reported to the
+ * garbage collector, so UObjects referenced by a held snapshot stay alive for as long as the snapshot is held.
+ */
+struct SIMPLEINVENTORY_API FSimpleInventorySnapshotChunk
+{
+    FSimpleInventorySnapshotChunk();
+    ~FSimpleInventorySnapshotChunk();
+    UE_NONCOPYABLE(FSimpleInventorySnapshotChunk);
+    
+    TArray<FSimpleInventorySlot> Slots;
+    
+    /** The definitions the slots' captured definitions point into, kept alive with the chunk. */
+    TSharedPtr<const FSimpleInventoryItemDefinitions, ESPMode::ThreadSafe> Definitions;
+    
+    /** Start reporting the items of live chunks to the garbage collector. Called when the module starts up. */
+    static void StartReportingReferences();
+    
+    /** Stop reporting the items of live chunks. Called when the module shuts down. */
+    static void StopReportingReferences();
+};
+
+/**
+ * Immutable view of an inventory's slots at one generation, returned by `USimpleInventory::GetSnapshot`.
+ * Copying a snapshot is O(1), and it stays valid and unchanged however the inventory changes afterwards,
+ * so it can be read from any thread for as long as it is held. UObjects referenced by its items are kept alive
+ * by its chunks for as long as any snapshot holds them.
+ */
+struct SIMPLEINVENTORY_API FSimpleInventorySnapshot
+{
+    /** Number of slots per shared chunk. */
+    static constexpr int32 ChunkSize = 64;
+
+    /** True if this snapshot was taken from an inventory. A default constructed snapshot is empty and invalid. */
+    bool IsValid() const {
+        return Data.IsValid();
+    }
+
+    /** The number of slots, including empty padding slots. */
+    int32 Num() const {
+        return Data.IsValid() ? Data->NumSlots : 0;
+    }
+
+    bool IsEmpty() const {
+        return Num() == 0;
+    }
+
+    bool IsValidIndex(const int32 Index) const {
+        return Index >= 0 && Index < Num();
+    }
+
+    /** The inventory generation this snapshot was taken at. */
+    uint64 GetGeneration() const {
+        return Data.IsValid() ? Data->Generation : 0;
+    }
+
+    /** The slot at Index. Index must be valid. */
+    const FSimpleInventorySlot& operator[](const int32 Index) const {
+        check(IsValidIndex(Index));
+        return Data->Chunks[Index / ChunkSize]->Slots[Index % ChunkSize];
+    }
+
+    /**
+     * Copy every slot into a flat array.
+     *
+     * @param OutSlots  Replaced with the snapshot's slots.
+     */
+    void CopySlots(TArray<FSimpleInventorySlot>& OutSlots) const;
+
+    /**
+     * Call Visitor with each chunk's slots in place, in slot order.
+     *
+     * @param Visitor  Called once per chunk with its slots and the index of its first slot.
+     */
+    void ForEachChunk(TFunctionRef<void(TConstArrayView<FSimpleInventorySlot> Slots, const int32 FirstIndex)> Visitor) const;
+
+private:
+    friend class USimpleInventory;
+
+    struct FData
+    {
+        TArray<TSharedRef<const FSimpleInventorySnapshotChunk, ESPMode::ThreadSafe>> Chunks;
+        int32 NumSlots = 0;
+        uint64 Generation = 0;
+    };
+
+    TSharedPtr<const FData, ESPMode::ThreadSafe> Data;
+};
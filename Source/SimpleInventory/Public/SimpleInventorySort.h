@@ -0,0 +1,71 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+
+#include "SimpleInventorySort.generated.h"
+
+UENUM(BlueprintType)
+enum class ESimpleInventorySortKeyType : uint8
+{
+    ID UMETA(DisplayName = "ID"),
+    STRUCT_TYPE UMETA(DisplayName = "Struct Type"),
+    PROPERTY UMETA(DisplayName = "Property")
+};
+
+/**
+ * What `USimpleInventory::SortInventory` orders slots by. Sorting is stable, so sorting by one key and then by
+ * another orders by the second key, then the first.
+ */
+USTRUCT(Blueprintable, BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventorySortKey
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Sort")
+    ESimpleInventorySortKeyType Type = ESimpleInventorySortKeyType::ID;
+
+    /**
+     * The item property to sort by when Type is PROPERTY. Supports integers, floats, enums, bool, FName, FString and FText.
+     * Items without the property sort after items with it.
+     */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Sort")
+    FName PropertyName;
+
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Sort")
+    bool bDescending = false;
+};
+
+/**
+ * Stable sort of an index array, split across worker threads for large arrays.
+ */
+class SIMPLEINVENTORY_API FSimpleInventoryParallelSort
+{
+public:
+    /** Arrays with fewer entries than this are sorted on the calling thread. */
+    static constexpr int32 ParallelThreshold = 4096;
+
+    /** Smallest run sorted by a single worker before the runs are merged. */
+    static constexpr int32 MinBlockSize = 1024;
+
+    /**
+     * Stable sort of Order. Above ParallelThreshold, blocks are sorted in parallel and then merged pairwise
+     * in parallel rounds, so Less must be safe to call from several threads at once.
+     *
+     * @param Order  The indices to sort.
+     * @param Less   Returns true if the first index sorts before the second.
+     */
+    static void StableSort(TArray<int32>& Order,
+                           TFunctionRef<bool(const int32, const int32)> Less);
+
+private:
+    static void Merge(const int32* Source,
+                      const int32 Low,
+                      const int32 Mid,
+                      const int32 High,
+                      int32* Target,
+                      TFunctionRef<bool(const int32, const int32)> Less);
+};
@@ -0,0 +1,76 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Profiling for SimpleInventory.
+ *
+ * CPU scopes are emitted on the `SimpleInventory` trace channel; enable it in Unreal Insights or with
+ * `-trace=cpu,SimpleInventory`. Cycle stats and counters are in `stat SimpleInventory`; functions with a cycle stat
+ * appear in Insights under the stat's name instead of on the channel while stats are compiled in.
+ * Scopes compile out when tracing is disabled, and stats compile out when STATS is 0.
+ */
+
+#ifndef SIMPLEINVENTORY_TRACE_ENABLED
+#define SIMPLEINVENTORY_TRACE_ENABLED (CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+#if SIMPLEINVENTORY_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(SimpleInventoryChannel, SIMPLEINVENTORY_API);
+
+/** CPU scope on the SimpleInventory trace channel. */
+#define SIMPLEINVENTORY_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, SimpleInventoryChannel)
+#else
+#define SIMPLEINVENTORY_TRACE_SCOPE(Name)
+#endif
+
+/**
+ * Times a scope with a cycle stat. The stat already emits its own CPU scope, so the trace scope is only used when
+ * stats are compiled out; either way the scope shows up once in Insights.
+ */
+#if STATS
+#define SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER(Name, Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define SIMPLEINVENTORY_SCOPE_CYCLE_COUNTER(Name, Stat) SIMPLEINVENTORY_TRACE_SCOPE(Name)
+#endif
+
+DECLARE_STATS_GROUP(TEXT("SimpleInventory"), STATGROUP_SimpleInventory, STATCAT_Advanced);
+
+// USimpleInventory
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AddItem"), STAT_SimpleInventory_AddItem, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AddItemByID"), STAT_SimpleInventory_AddItemByID, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AddItems"), STAT_SimpleInventory_AddItems, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RemoveItemAtIndex"), STAT_SimpleInventory_RemoveItemAtIndex, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RemoveItems"), STAT_SimpleInventory_RemoveItems, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RemoveItemsByCount"), STAT_SimpleInventory_RemoveItemsByCount, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Clear"), STAT_SimpleInventory_Clear, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HasItem"), STAT_SimpleInventory_HasItem, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CopyInventory"), STAT_SimpleInventory_CopyInventory, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ReplaceSlots"), STAT_SimpleInventory_ReplaceSlots, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RestoreSlots"), STAT_SimpleInventory_RestoreSlots, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetSnapshot"), STAT_SimpleInventory_GetSnapshot, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("QueryItems"), STAT_SimpleInventory_QueryItems, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SortInventory"), STAT_SimpleInventory_SortInventory, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Consolidate"), STAT_SimpleInventory_Consolidate, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("TransferItems"), STAT_SimpleInventory_TransferItems, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Broadcast Change"), STAT_SimpleInventory_BroadcastChange, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+
+// USimpleInventorySubsystem
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem Broadcast Change"), STAT_SimpleInventory_SubsystemBroadcastChange, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetStorage"), STAT_SimpleInventory_GetStorage, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GetStorageDelta"), STAT_SimpleInventory_GetStorageDelta, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("InflateFromStorage"), STAT_SimpleInventory_InflateFromStorage, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Async Load Tick"), STAT_SimpleInventory_AsyncLoadTick, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+
+// USimpleInventoryComponent
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sync Replicated Slots"), STAT_SimpleInventory_SyncReplicatedSlots, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Replicated Slots"), STAT_SimpleInventory_ApplyReplicatedSlots, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+
+// Counters
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Inventories"), STAT_SimpleInventory_NumInventories, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Slots"), STAT_SimpleInventory_NumSlots, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Change Broadcasts"), STAT_SimpleInventory_NumChangeBroadcasts, STATGROUP_SimpleInventory, SIMPLEINVENTORY_API);
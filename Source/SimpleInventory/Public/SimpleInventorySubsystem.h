@@ -4,16 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Containers/Ticker.h"
 
 #include "SimpleInventoryStorage.h"
 #include "SimpleInventorySlotStorage.h"
 #include "SimpleInventorySubsystemStorage.h"
+#include "SimpleInventoryChange.h"
+#include "SimpleInventoryHandle.h"
+#include "SimpleInventoryItemEntry.h"
+#include "SimpleInventoryQuery.h"
 
 #include "SimpleInventorySubsystem.generated.h"
 
 class USimpleInventory;
 class USimpleInventoryDefinitions;
-class USimpleInventoryChange;
+class UDataTable;
 
 UCLASS(ClassGroup=(SimpleInventory), Blueprintable, BlueprintType)
 class SIMPLEINVENTORY_API USimpleInventorySubsystem : public UGameInstanceSubsystem
@@ -22,15 +27,30 @@ class SIMPLEINVENTORY_API USimpleInventorySubsystem : public UGameInstanceSubsys
     
 public:
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSimpleInventorySubsystemChangeDelegate, USimpleInventoryChange*, InventoryChange);
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnSimpleInventorySubsystemChangeNativeDelegate, const FSimpleInventoryChange&);
+    DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnSimpleInventorySaveCompleteDelegate, bool, bSuccess, const TArray<uint8>&, SaveData);
+    DECLARE_DELEGATE_TwoParams(FOnSimpleInventorySaveCompleteNativeDelegate, bool, const TArray<uint8>&);
+    DECLARE_DYNAMIC_DELEGATE_OneParam(FOnSimpleInventoryLoadCompleteDelegate, bool, bSuccess);
+    DECLARE_DELEGATE_OneParam(FOnSimpleInventoryLoadCompleteNativeDelegate, bool);
     
+    /** Blueprint change event for every registered inventory. A `USimpleInventoryChange` is only allocated when this has bindings. */
     UPROPERTY(BlueprintAssignable, Category="Simple Inventory Subsystem")
     FOnSimpleInventorySubsystemChangeDelegate OnInventorySubsystemChangeEvent;
     
+    /** Native change event for every registered inventory. Prefer this from C++; it never allocates. */
+    FOnSimpleInventorySubsystemChangeNativeDelegate OnInventorySubsystemChangeNative;
+    
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Subsystem")
     TMap<FName, TObjectPtr<USimpleInventory>> InventoryMap;
     
+    /** Game thread time, in milliseconds, LoadStorageAsync may spend restoring inventories each frame. At least one inventory is restored per frame. */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Subsystem")
+    float AsyncLoadFrameBudgetMs = 2.0f;
+    
     void Initialize(FSubsystemCollectionBase& Collection) override;
     
+    void Deinitialize() override;
+    
     /**
      * Get all registered inventories managed by this subsystem.
      *
@@ -99,6 +119,62 @@ public:
     UFUNCTION(BlueprintPure, Category="Simple Inventory Subsystem")
     void GetStorage(FSimpleInventorySubsystemStorage& Result) const;
     
+    /**
+     * Get the storage of only the inventories that changed since the previous call, plus any that were removed.
+     * The first call returns every inventory. Apply the result to the last saved storage with
+     * `FSimpleInventorySubsystemStorage::ApplyDelta`.
+     *
+     * @param Result  The changed and removed inventories.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void GetStorageDelta(FSimpleInventorySubsystemStorageDelta& Result);
+    
+    /**
+     * Save all inventories without blocking the game thread.
+     * The storage is snapshotted immediately; serialization and compression run on a worker task, and OnComplete
+     * is called on the game thread with the compressed bytes.
+     *
+     * @param OnComplete  Called with the result and the saved bytes.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void SaveStorageAsync(const FOnSimpleInventorySaveCompleteDelegate& OnComplete);
+    
+    /**
+     * Native version of SaveStorageAsync.
+     *
+     * @param OnComplete  Called on the game thread with the result and the saved bytes.
+     */
+    void SaveStorageAsyncNative(FOnSimpleInventorySaveCompleteNativeDelegate OnComplete);
+    
+    /**
+     * Restore inventories from bytes written by SaveStorageAsync without blocking the game thread.
+     * Decompression and deserialization run on a worker task; inventories are then restored on the game thread,
+     * spending at most AsyncLoadFrameBudgetMs per frame. Only one load may be in progress at a time.
+     *
+     * @param SaveData    The saved bytes.
+     * @param OnComplete  Called on the game thread once every inventory is restored, or the load failed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void LoadStorageAsync(const TArray<uint8>& SaveData,
+                          const FOnSimpleInventoryLoadCompleteDelegate& OnComplete);
+    
+    /**
+     * Native version of LoadStorageAsync.
+     *
+     * @param SaveData    The saved bytes.
+     * @param OnComplete  Called on the game thread once every inventory is restored, or the load failed.
+     */
+    void LoadStorageAsyncNative(TArray<uint8> SaveData,
+                                FOnSimpleInventoryLoadCompleteNativeDelegate OnComplete);
+    
+    /**
+     * Check whether a LoadStorageAsync call is still in progress.
+     *
+     * @return  True until the load's completion delegate has been called.
+     */
+    UFUNCTION(BlueprintPure, Category="Simple Inventory Subsystem")
+    bool IsLoadingAsync() const;
+    
     /**
      * Check if an inventory contains an item with an exact count.
      *
@@ -113,6 +189,67 @@ public:
                  const int32 Count,
                  bool& Result);
     
+    /**
+     * Get the total amount of an item across all slots of an inventory.
+     *
+     * @param InventoryName  The name of the inventory to check.
+     * @param ItemID         The ID of the item.
+     * @param Result         The total count, or 0 if the item or the inventory does not exist.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void GetItemCount(const FName InventoryName,
+                      const int32 ItemID,
+                      int32& Result);
+    
+    /**
+     * Check if an inventory holds at least Count of an item across all slots.
+     *
+     * @param InventoryName  The name of the inventory to check.
+     * @param ItemID         The ID of the item.
+     * @param Count          The minimum quantity required.
+     * @param Result         True if the inventory holds at least Count of the item.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void HasAtLeast(const FName InventoryName,
+                    const int32 ItemID,
+                    const int32 Count,
+                    bool& Result);
+    
+    /**
+     * Get the slots of an inventory holding an item of a struct type or any struct derived from it.
+     *
+     * @param InventoryName  The name of the inventory to search.
+     * @param StructType     The item struct type.
+     * @param Result         The indices of the matching slots, ascending. Empty if the inventory does not exist.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void GetSlotsOfType(const FName InventoryName,
+                        const UScriptStruct* StructType,
+                        TArray<int32>& Result);
+    
+    /**
+     * Find the slots of an inventory whose items match a query.
+     *
+     * @param InventoryName  The name of the inventory to search.
+     * @param Query          The struct type and property conditions to match.
+     * @param Result         The indices of the matching slots, ascending. Empty if the inventory does not exist.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void QueryItems(const FName InventoryName,
+                    const FSimpleInventoryQuery& Query,
+                    TArray<int32>& Result);
+    
+    /**
+     * Find the slots of an inventory whose items match a compiled query.
+     *
+     * @param InventoryName  The name of the inventory to search.
+     * @param Query          The compiled query, reusable across calls and inventories.
+     * @param Result         The indices of the matching slots, ascending. Empty if the inventory does not exist.
+     */
+    void QueryItemsCompiled(const FName InventoryName,
+                            const FSimpleInventoryCompiledQuery& Query,
+                            TArray<int32>& Result);
+    
     /**
      * Register multiple inventories from a Data Asset.
      *
@@ -120,6 +257,33 @@ public:
      */
     UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
     void RegisterInventoryDefinitions(USimpleInventoryDefinitions* Definitions);
+    
+    /**
+     * Register the rows of a DataTable as shared item definitions, keyed by item ID.
+     * Slots holding an item identical to its definition reference it instead of keeping a copy.
+     *
+     * @param ItemTable  DataTable of `FSimpleInventoryItem` rows (or rows derived from it).
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void RegisterItemDefinitions(UDataTable* ItemTable);
+    
+    /**
+     * Remove a DataTable previously registered with RegisterItemDefinitions.
+     *
+     * @param ItemTable  The DataTable to remove.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void UnregisterItemDefinitions(UDataTable* ItemTable);
+    
+    /**
+     * Get a copy of the registered definition for an item ID.
+     *
+     * @param ItemID  The item ID.
+     * @param Result  The definition, or an empty struct if the ID is not registered.
+     */
+    UFUNCTION(BlueprintPure, Category="Simple Inventory Subsystem")
+    void GetItemDefinition(const int32 ItemID,
+                           FInstancedStruct& Result) const;
 
     /**
      * Register a single inventory with the given name and slot capacity.
@@ -134,6 +298,45 @@ public:
                            const int32 MaxSlots,
                            USimpleInventory*& Result);
     
+    /**
+     * Register a single inventory and get a handle to it. The handle overloads below resolve it without hashing the name.
+     * If an inventory with the same name already exists, the existing one and its handle are returned.
+     *
+     * @param InventoryName  The name of the new inventory.
+     * @param MaxSlots       The maximum number of slots.
+     * @param Result         The registered or existing inventory.
+     * @param Handle         The inventory's handle.
+     */
+    void RegisterInventory(const FName InventoryName,
+                           const int32 MaxSlots,
+                           USimpleInventory*& Result,
+                           FSimpleInventoryHandle& Handle);
+    
+    /**
+     * Remove an inventory from the subsystem. Handles to it stop resolving, and its slot in the handle array is reused.
+     *
+     * @param InventoryName  The name of the inventory to remove.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void UnregisterInventory(const FName InventoryName);
+    
+    /**
+     * Get the handle of a registered inventory, e.g. one registered from definitions or restored from storage.
+     *
+     * @param InventoryName  The name of the inventory.
+     * @param Result         The inventory's handle, or an unset handle if no such inventory is registered.
+     */
+    void FindHandle(const FName InventoryName,
+                    FSimpleInventoryHandle& Result);
+    
+    /**
+     * Get the inventory a handle refers to. O(1).
+     *
+     * @param Handle  The handle to resolve.
+     * @return        The inventory, or nullptr if the handle is stale or was never issued.
+     */
+    USimpleInventory* ResolveHandle(const FSimpleInventoryHandle Handle) const;
+    
     /**
      * Add an item to the specified inventory.
      *
@@ -148,6 +351,20 @@ public:
                  const int32 Count,
                  bool& Result);
     
+    /**
+     * Add an item by ID to the specified inventory, using its registered item definition.
+     *
+     * @param InventoryName  The name of the inventory to modify.
+     * @param ItemID         The ID of a registered item definition.
+     * @param Count          The number of items to add.
+     * @param Result         True if the item(s) were successfully added.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void AddItemByID(const FName InventoryName,
+                     const int32 ItemID,
+                     const int32 Count,
+                     bool& Result);
+    
     /**
      * Remove a quantity of an item at a specific index.
      *
@@ -174,6 +391,70 @@ public:
                      const TArray<FInstancedStruct>& Items,
                      bool& Result);
     
+    /**
+     * Add several items to a given inventory, broadcasting a single BATCH change.
+     *
+     * @param InventoryName  The name of the inventory to modify.
+     * @param Entries        The items and amounts to add.
+     * @param bAllOrNothing  If true, nothing is added unless every entry fits.
+     * @param EntryResults   True for each entry that was fully added.
+     * @param Result         True if every entry was fully added.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void AddItems(const FName InventoryName,
+                  const TArray<FSimpleInventoryItemEntry>& Entries,
+                  const bool bAllOrNothing,
+                  TArray<bool>& EntryResults,
+                  bool& Result);
+    
+    /**
+     * Remove amounts of several items by ID from a given inventory, broadcasting a single BATCH change.
+     *
+     * @param InventoryName  The name of the inventory to modify.
+     * @param Entries        The item IDs and amounts to remove.
+     * @param bAllOrNothing  If true, nothing is removed unless every entry can be fully removed.
+     * @param EntryResults   True for each entry that was fully removed.
+     * @param Result         True if every entry was fully removed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void RemoveItemsByCount(const FName InventoryName,
+                            const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                            const bool bAllOrNothing,
+                            TArray<bool>& EntryResults,
+                            bool& Result);
+    
+    /**
+     * Move items from a slot of one inventory into another, without copying the item if the slot is emptied.
+     * Subsystem listeners receive one TRANSFER change describing both sides.
+     *
+     * @param FromInventoryName  The name of the inventory to move items out of.
+     * @param SlotIndex          The slot to move items out of.
+     * @param ToInventoryName    The name of the inventory to move items into.
+     * @param Count              How many items to move.
+     * @param Result             True if the items were moved, false if nothing changed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void TransferItems(const FName FromInventoryName,
+                       const int32 SlotIndex,
+                       const FName ToInventoryName,
+                       const int32 Count,
+                       bool& Result);
+    
+    /**
+     * Move items from several slots of one inventory into another, all or nothing.
+     * Subsystem listeners receive one TRANSFER change describing both sides.
+     *
+     * @param FromInventoryName  The name of the inventory to move items out of.
+     * @param Entries            The slots, as indexed before the transfer, and how many items to move out of each.
+     * @param ToInventoryName    The name of the inventory to move items into.
+     * @param Result             True if every entry was moved, false if nothing changed.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void TransferItemsBatch(const FName FromInventoryName,
+                            const TArray<FSimpleInventoryTransferEntry>& Entries,
+                            const FName ToInventoryName,
+                            bool& Result);
+    
     /**
      * Clear all items from a given inventory.
      *
@@ -207,19 +488,311 @@ public:
     UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
     void ForceOnChange(const FName InventoryName) const;
     
+    /**
+     * Start a batch on an inventory. Its changes are merged into a single BATCH change,
+     * broadcast (and rebroadcast by this subsystem) once when the matching EndBatch is called.
+     *
+     * @param InventoryName  The name of the inventory to batch.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void BeginBatch(const FName InventoryName);
+    
+    /**
+     * End a batch started with BeginBatch.
+     *
+     * @param InventoryName  The name of the batched inventory.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void EndBatch(const FName InventoryName);
+    
     /**
      * Restore inventories from a serialized storage struct.
+     * Slots are rebuilt in their saved layout and each inventory broadcasts a single LOAD change.
      *
      * @param Storage  Struct containing saved inventory data.
      */
     UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
     void InflateFromStorage(const FSimpleInventorySubsystemStorage Storage);
     
+    /**
+     * Restore inventories from a serialized storage struct on demand.
+     * Inventories that are not registered yet only keep their saved storage and are restored the first time a
+     * subsystem function (GetInventory, GetSlots, HasItem, AddItem, ...) touches them. Until then, GetStorage
+     * writes their saved storage back unchanged. Registered inventories are restored immediately.
+     * Reading InventoryMap directly does not restore pending inventories.
+     *
+     * @param Storage  Struct containing saved inventory data.
+     */
+    UFUNCTION(BlueprintCallable, Category="Simple Inventory Subsystem")
+    void InflateFromStorageLazy(const FSimpleInventorySubsystemStorage& Storage);
+    
+    /**
+     * Check whether an inventory loaded with InflateFromStorageLazy has not been restored yet.
+     *
+     * @param InventoryName  The name of the inventory to check.
+     * @return               True if the inventory only holds its saved storage.
+     */
+    UFUNCTION(BlueprintPure, Category="Simple Inventory Subsystem")
+    bool IsInventoryPendingInflation(const FName InventoryName) const;
+    
+    // Handle overloads. Each behaves like the FName version of the same function, but resolves the inventory
+    // through ResolveHandle instead of a map lookup. A stale handle is logged and treated like an unknown name.
+    
+    void GetInventory(const FSimpleInventoryHandle Handle,
+                      USimpleInventory*& Result) const;
+    
+    void GetLength(const FSimpleInventoryHandle Handle,
+                   int32& Result) const;
+    
+    void GetMaxSize(const FSimpleInventoryHandle Handle,
+                    int32& Result) const;
+    
+    void GetSlot(const FSimpleInventoryHandle Handle,
+                 const int32 Index,
+                 USimpleInventorySlot*& Result) const;
+    
+    void GetSlots(const FSimpleInventoryHandle Handle,
+                  TArray<USimpleInventorySlot*>& Result) const;
+    
+    void HasItem(const FSimpleInventoryHandle Handle,
+                 const int32 ItemID,
+                 const int32 Count,
+                 bool& Result) const;
+    
+    void GetItemCount(const FSimpleInventoryHandle Handle,
+                      const int32 ItemID,
+                      int32& Result) const;
+    
+    void HasAtLeast(const FSimpleInventoryHandle Handle,
+                    const int32 ItemID,
+                    const int32 Count,
+                    bool& Result) const;
+    
+    void GetSlotsOfType(const FSimpleInventoryHandle Handle,
+                        const UScriptStruct* StructType,
+                        TArray<int32>& Result) const;
+    
+    void QueryItems(const FSimpleInventoryHandle Handle,
+                    const FSimpleInventoryQuery& Query,
+                    TArray<int32>& Result) const;
+    
+    void QueryItemsCompiled(const FSimpleInventoryHandle Handle,
+                            const FSimpleInventoryCompiledQuery& Query,
+                            TArray<int32>& Result) const;
+    
+    void AddItem(const FSimpleInventoryHandle Handle,
+                 FInstancedStruct Item,
+                 const int32 Count,
+                 bool& Result);
+    
+    void AddItemByID(const FSimpleInventoryHandle Handle,
+                     const int32 ItemID,
+                     const int32 Count,
+                     bool& Result);
+    
+    void RemoveItemAtIndex(const FSimpleInventoryHandle Handle,
+                           const int32 Index,
+                           const int32 Count,
+                           bool& Result);
+    
+    void RemoveItems(const FSimpleInventoryHandle Handle,
+                     const TArray<FInstancedStruct>& Items,
+                     bool& Result);
+    
+    void AddItems(const FSimpleInventoryHandle Handle,
+                  const TArray<FSimpleInventoryItemEntry>& Entries,
+                  const bool bAllOrNothing,
+                  TArray<bool>& EntryResults,
+                  bool& Result);
+    
+    void RemoveItemsByCount(const FSimpleInventoryHandle Handle,
+                            const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                            const bool bAllOrNothing,
+                            TArray<bool>& EntryResults,
+                            bool& Result);
+    
+    void TransferItems(const FSimpleInventoryHandle FromHandle,
+                       const int32 SlotIndex,
+                       const FSimpleInventoryHandle ToHandle,
+                       const int32 Count,
+                       bool& Result);
+    
+    void TransferItemsBatch(const FSimpleInventoryHandle FromHandle,
+                            const TArray<FSimpleInventoryTransferEntry>& Entries,
+                            const FSimpleInventoryHandle ToHandle,
+                            bool& Result);
+    
+    void Clear(const FSimpleInventoryHandle Handle);
+    
+    void CopyInventory(const FSimpleInventoryHandle Handle,
+                       const USimpleInventory* OtherInventory);
+    
+    void ForceOnChange(const FSimpleInventoryHandle Handle) const;
+    
+    void BeginBatch(const FSimpleInventoryHandle Handle);
+    
+    void EndBatch(const FSimpleInventoryHandle Handle);
+    
 private:
+    /** Storage built for one inventory, reused while the inventory's generation and size are unchanged. */
+    struct FCachedInventoryStorage
+    {
+        TWeakObjectPtr<USimpleInventory> Inventory;
+        uint64 Generation = 0;
+        FSimpleInventoryStorage Storage;
+    };
+    
+    /** Per-inventory storage from the last GetStorage / GetStorageDelta, keyed by inventory name. */
+    mutable TMap<FName, FCachedInventoryStorage> StorageCache;
+    
+    /** Inventory generations as of the last GetStorageDelta, keyed by inventory name. */
+    TMap<FName, TPair<TWeakObjectPtr<USimpleInventory>, uint64>> DeltaGenerations;
+    
+    /** Saved storage of inventories loaded with InflateFromStorageLazy and not touched since, keyed by inventory name. */
+    UPROPERTY()
+    TMap<FName, FSimpleInventoryStorage> PendingInflation;
+    
+    /** Storage read by the running LoadStorageAsync, restored a few inventories per frame. */
+    UPROPERTY()
+    FSimpleInventorySubsystemStorage PendingLoadStorage;
+    
+    /** Inventories in PendingLoadStorage, in restore order. */
+    TArray<FName> PendingLoadNames;
+    
+    /** Index of the next inventory in PendingLoadNames to restore. */
+    int32 PendingLoadIndex = 0;
+    
+    /**
+     * Registered inventories by handle index. Entries of unregistered inventories are null until reused.
+     * Kept beside InventoryMap so handles resolve without hashing; RegisterInventory and UnregisterInventory keep both in sync.
+     */
+    UPROPERTY()
+    TArray<TObjectPtr<USimpleInventory>> HandleInventories;
+    
+    /** The serial of the current registration at each handle index. Incremented when the index is freed. */
+    TArray<int32> HandleSerials;
+    
+    /** Handle indices freed by UnregisterInventory, reused before the arrays grow. */
+    TArray<int32> FreeHandleIndices;
+    
+    /** The handle of each registered inventory, keyed by inventory name. */
+    TMap<FName, FSimpleInventoryHandle> HandlesByName;
+    
+    bool bIsLoadingAsync = false;
+    
+    FOnSimpleInventoryLoadCompleteNativeDelegate PendingLoadComplete;
+    
+    FTSTicker::FDelegateHandle PendingLoadTickerHandle;
+    
     UFUNCTION()
     void Find(const FName InventoryName,
               USimpleInventory*& Result) const;
     
-    UFUNCTION()
-    void HandleOnChangeEvent(USimpleInventoryChange* InventoryChange);
+    void FindOrInflate(const FName InventoryName,
+                       USimpleInventory*& Result);
+    
+    USimpleInventory* FindInventoryForCall(const FName InventoryName,
+                                           const TCHAR* FunctionName);
+    
+    USimpleInventory* ResolveHandleForCall(const FSimpleInventoryHandle Handle,
+                                           const TCHAR* FunctionName) const;
+    
+    // Shared bodies of the FName and handle overloads, called with the resolved inventory or nullptr.
+    
+    static void GetLength(USimpleInventory* Inventory,
+                          int32& Result);
+    
+    static void GetMaxSize(USimpleInventory* Inventory,
+                           int32& Result);
+    
+    static void GetSlot(USimpleInventory* Inventory,
+                        const int32 Index,
+                        USimpleInventorySlot*& Result);
+    
+    static void GetSlots(USimpleInventory* Inventory,
+                         TArray<USimpleInventorySlot*>& Result);
+    
+    static void HasItem(USimpleInventory* Inventory,
+                        const int32 ItemID,
+                        const int32 Count,
+                        bool& Result);
+    
+    static void GetItemCount(USimpleInventory* Inventory,
+                             const int32 ItemID,
+                             int32& Result);
+    
+    static void HasAtLeast(USimpleInventory* Inventory,
+                           const int32 ItemID,
+                           const int32 Count,
+                           bool& Result);
+    
+    static void GetSlotsOfType(USimpleInventory* Inventory,
+                               const UScriptStruct* StructType,
+                               TArray<int32>& Result);
+    
+    static void QueryItemsCompiled(USimpleInventory* Inventory,
+                                   const FSimpleInventoryCompiledQuery& Query,
+                                   TArray<int32>& Result);
+    
+    static void AddItem(USimpleInventory* Inventory,
+                        FInstancedStruct Item,
+                        const int32 Count,
+                        bool& Result);
+    
+    static void AddItemByID(USimpleInventory* Inventory,
+                            const int32 ItemID,
+                            const int32 Count,
+                            bool& Result);
+    
+    static void RemoveItemAtIndex(USimpleInventory* Inventory,
+                                  const int32 Index,
+                                  const int32 Count,
+                                  bool& Result);
+    
+    static void RemoveItems(USimpleInventory* Inventory,
+                            const TArray<FInstancedStruct>& Items,
+                            bool& Result);
+    
+    static void AddItems(USimpleInventory* Inventory,
+                         const TArray<FSimpleInventoryItemEntry>& Entries,
+                         const bool bAllOrNothing,
+                         TArray<bool>& EntryResults,
+                         bool& Result);
+    
+    static void RemoveItemsByCount(USimpleInventory* Inventory,
+                                   const TArray<FSimpleInventoryItemCountEntry>& Entries,
+                                   const bool bAllOrNothing,
+                                   TArray<bool>& EntryResults,
+                                   bool& Result);
+    
+    static void TransferItemsBatch(USimpleInventory* FromInventory,
+                                   const TArray<FSimpleInventoryTransferEntry>& Entries,
+                                   USimpleInventory* ToInventory,
+                                   bool& Result);
+    
+    FSimpleInventoryHandle AddInventory(const FName InventoryName,
+                                        USimpleInventory* Inventory);
+    
+    FSimpleInventoryHandle IssueHandle(const FName InventoryName,
+                                       USimpleInventory* Inventory);
+    
+    void ReleaseHandle(const FName InventoryName);
+    
+    const FSimpleInventoryStorage& GetCachedStorage(const FName InventoryName,
+                                                    USimpleInventory* Inventory) const;
+    
+    void InflateInventory(const FName InventoryName,
+                          const FSimpleInventoryStorage& Storage);
+    
+    void InflatePendingInventory(const FName InventoryName);
+    
+    void InflateAllPendingInventories();
+    
+    void BeginApplyingLoad(FSimpleInventorySubsystemStorage&& Storage);
+    
+    bool TickPendingLoad(float DeltaTime);
+    
+    void FinishAsyncLoad(const bool bSuccess);
+    
+    void HandleOnChangeEvent(const FSimpleInventoryChange& InventoryChange);
 };
@@ -9,6 +9,13 @@
 
 #include "SimpleInventorySubsystemStorage.generated.h"
 
+struct FSimpleInventorySubsystemStorageDelta;
+
+/**
+ * Saved state of every inventory in a `USimpleInventorySubsystem`, keyed by inventory name.
+ * Binary archives use a compact, versioned layout (see `Serialize`); text archives and saves written before it
+ * existed use regular tagged property serialization.
+ */
 USTRUCT(Blueprintable, BlueprintType)
 struct SIMPLEINVENTORY_API FSimpleInventorySubsystemStorage
 {
@@ -17,4 +24,71 @@ struct SIMPLEINVENTORY_API FSimpleInventorySubsystemStorage
 public:
     UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Subsystem Storage")
     TMap<FName, FSimpleInventoryStorage> Value;
+    
+    /**
+     * Write or read the compact binary layout: a name table, a struct-type table and a table of unique item payloads,
+     * followed by each inventory's slots as varints referencing those tables.
+     *
+     * @param Ar  The archive to serialize with.
+     * @return    False to fall back to tagged property serialization (text archives, or loading data in the old format).
+     */
+    bool Serialize(FArchive& Ar);
+    
+    /**
+     * Write the storage in the compact layout and compress it. Safe to call from any thread while nothing else
+     * modifies this storage.
+     *
+     * @param OutData  The compressed bytes.
+     * @return         True on success.
+     */
+    bool SaveToCompressedBytes(TArray<uint8>& OutData) const;
+    
+    /**
+     * Replace this storage with data written by SaveToCompressedBytes. Safe to call from any thread; object
+     * references inside item payloads are only resolved if the objects are already loaded.
+     *
+     * @param Data  The compressed bytes.
+     * @return      False if the data is corrupt or not in the expected format.
+     */
+    bool LoadFromCompressedBytes(const TArray<uint8>& Data);
+    
+    /**
+     * Bring this storage up to date with a delta pulled from `USimpleInventorySubsystem::GetStorageDelta`.
+     *
+     * @param Delta  The changed and removed inventories.
+     */
+    void ApplyDelta(const FSimpleInventorySubsystemStorageDelta& Delta);
+};
+
+/**
+ * The inventories that changed since the previous `USimpleInventorySubsystem::GetStorageDelta` call.
+ * Apply it to the previously saved storage with `FSimpleInventorySubsystemStorage::ApplyDelta`.
+ */
+USTRUCT(Blueprintable, BlueprintType)
+struct SIMPLEINVENTORY_API FSimpleInventorySubsystemStorageDelta
+{
+    GENERATED_BODY()
+    
+public:
+    /** Full storage of each inventory that changed or was added. */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Subsystem Storage")
+    TMap<FName, FSimpleInventoryStorage> Changed;
+    
+    /** Inventories that are no longer registered. */
+    UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="Simple Inventory Subsystem Storage")
+    TArray<FName> Removed;
+    
+    /** True if nothing changed. */
+    bool IsEmpty() const {
+        return Changed.IsEmpty() && Removed.IsEmpty();
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FSimpleInventorySubsystemStorage> : public TStructOpsTypeTraitsBase2<FSimpleInventorySubsystemStorage>
+{
+    enum
+    {
+        WithSerializer = true,
+    };
 };
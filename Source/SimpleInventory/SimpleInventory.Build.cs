@@ -12,6 +12,7 @@ public class SimpleInventory : ModuleRules
 			new string[]
 			{
 				"Core",
+				"NetCore",
 			});
 			
 		
@@ -23,5 +24,10 @@ public class SimpleInventory : ModuleRules
 				"Slate",
 				"SlateCore",
 			});
+		
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
 	}
 }
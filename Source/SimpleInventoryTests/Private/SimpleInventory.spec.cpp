@@ -3,10 +3,21 @@
 #include "UObject/ObjectMacros.h"
 #include "UObject/Object.h"
 #include "Engine/Engine.h"
+#include "Engine/DataTable.h"
+#include "HAL/PlatformTime.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Tasks/Task.h"
+#include "UObject/UnrealType.h"
 
 #include "SimpleInventoryItem.h"
 #include "SimpleInventory.h"
+#include "SimpleInventoryItemEntry.h"
+#include "SimpleInventoryItemRegistry.h"
+#include "SimpleInventoryQuery.h"
 #include "SimpleInventorySlot.h"
+#include "SimpleInventorySnapshot.h"
 
 static FInstancedStruct MakeTestItem(int32 ID, bool bIsStackable = true, int32 StackSize = 10)
 {
@@ -17,9 +28,35 @@ static FInstancedStruct MakeTestItem(int32 ID, bool bIsStackable = true, int32 S
     return FInstancedStruct::Make(ItemMetadata);
 }
 
+static FSimpleInventoryItemEntry MakeTestEntry(const FInstancedStruct& Item, int32 Count)
+{
+    FSimpleInventoryItemEntry Entry;
+    Entry.Item = Item;
+    Entry.Count = Count;
+    return Entry;
+}
+
+static FSimpleInventoryQueryCondition MakeTestCondition(const FName PropertyName, const ESimpleInventoryQueryOperator Operator, const FString& Value)
+{
+    FSimpleInventoryQueryCondition Condition;
+    Condition.PropertyName = PropertyName;
+    Condition.Operator = Operator;
+    Condition.Value = Value;
+    return Condition;
+}
+
+static FSimpleInventoryItemCountEntry MakeTestCountEntry(int32 ItemID, int32 Count)
+{
+    FSimpleInventoryItemCountEntry Entry;
+    Entry.ItemID = ItemID;
+    Entry.Count = Count;
+    return Entry;
+}
+
 DEFINE_SPEC(SimpleInventorySpec, "SimpleInventory.Inventory", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
 
 USimpleInventory* TestInventory = nullptr;
+UDataTable* TestItemTable = nullptr;
 
 void SimpleInventorySpec::Define() {
     BeforeEach([this]() {
@@ -146,8 +183,245 @@ void SimpleInventorySpec::Define() {
 
             TestFalse("Removal should fail", bResult);
         });
+        
+        It("should report the removed slots as they were indexed before the call", [this]() {
+            bool bResult = false;
+            for (int32 ItemID = 1; ItemID <= 4; ++ItemID) {
+                TestInventory->AddItem(MakeTestItem(ItemID, false), 1, bResult);
+            }
+            
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            TestInventory->RemoveItems({ MakeTestItem(3), MakeTestItem(1) }, bResult);
+            TestTrue("Removal should succeed", bResult);
+            
+            const TArray<FSimpleInventorySlot>& Slots = TestInventory->GetSlotData();
+            TestTrue("Only items 2 and 4 should remain", Slots.Num() == 2 && Slots[0].ItemID == 2 && Slots[1].ItemID == 4);
+            TestTrue("The change should name both removed slots", Changes.Num() == 1 && Changes[0].SlotIndices == TArray<int32>({ 0, 2 }));
+        });
     });
 
+    Describe("AddItems", [this]() {
+        It("should add every entry and broadcast one change", [this]() {
+            int32 NumChanges = 0;
+            TestInventory->OnInventoryChangeNative.AddLambda([&NumChanges](const FSimpleInventoryChange&) {
+                ++NumChanges;
+            });
+            
+            TArray<FSimpleInventoryItemEntry> Entries;
+            Entries.Add(MakeTestEntry(MakeTestItem(1, true, 5), 7));
+            Entries.Add(MakeTestEntry(MakeTestItem(2, false), 1));
+            Entries.Add(MakeTestEntry(MakeTestItem(1, true, 5), 2));
+            
+            TArray<bool> EntryResults;
+            bool bResult = false;
+            TestInventory->AddItems(Entries, false, EntryResults, bResult);
+            
+            TestTrue("All entries should be added", bResult);
+            TestEqual("One result per entry", EntryResults.Num(), 3);
+            TestEqual("One change should be broadcast", NumChanges, 1);
+            
+            TArray<USimpleInventorySlot*> Slots;
+            TestInventory->GetSlots(Slots);
+            TestEqual("Should have 3 slots", Slots.Num(), 3);
+            TestEqual("First stack is full", Slots[0]->Count, 5);
+            TestEqual("Overflow stack holds the rest", Slots[1]->Count, 4);
+        });
+        
+        It("should add nothing when all-or-nothing and an entry does not fit", [this]() {
+            TArray<FSimpleInventoryItemEntry> Entries;
+            for (int32 i = 0; i < 5; i++) {
+                Entries.Add(MakeTestEntry(MakeTestItem(i, false), 1));
+            }
+            Entries.Add(MakeTestEntry(MakeTestItem(99, false), 1));
+            
+            TArray<bool> EntryResults;
+            bool bResult = true;
+            TestInventory->AddItems(Entries, true, EntryResults, bResult);
+            
+            TestFalse("Add should fail", bResult);
+            int32 Len;
+            TestInventory->GetLength(Len);
+            TestEqual("Inventory should be untouched", Len, 0);
+        });
+        
+        It("should report each entry when not all-or-nothing", [this]() {
+            TArray<FSimpleInventoryItemEntry> Entries;
+            Entries.Add(MakeTestEntry(MakeTestItem(1), 1));
+            Entries.Add(MakeTestEntry(FInstancedStruct(), 1));
+            
+            TArray<bool> EntryResults;
+            bool bResult = true;
+            TestInventory->AddItems(Entries, false, EntryResults, bResult);
+            
+            TestFalse("Overall result should fail", bResult);
+            TestTrue("Valid entry should be added", EntryResults[0]);
+            TestFalse("Invalid entry should fail", EntryResults[1]);
+        });
+    });
+    
+    Describe("RemoveItemsByCount", [this]() {
+        It("should remove across stacks starting from the last", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, true, 5), 12, bResult);
+            TestInventory->AddItem(MakeTestItem(2, false), 1, bResult);
+            
+            TArray<FSimpleInventoryItemCountEntry> Entries;
+            Entries.Add(MakeTestCountEntry(1, 8));
+            Entries.Add(MakeTestCountEntry(2, 1));
+            
+            TArray<bool> EntryResults;
+            TestInventory->RemoveItemsByCount(Entries, false, EntryResults, bResult);
+            TestTrue("Removal should succeed", bResult);
+            
+            TArray<USimpleInventorySlot*> Slots;
+            TestInventory->GetSlots(Slots);
+            TestEqual("Only one slot should remain", Slots.Num(), 1);
+            TestEqual("Remaining count", Slots[0]->Count, 4);
+        });
+        
+        It("should remove nothing when all-or-nothing and an entry is short", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            
+            TArray<FSimpleInventoryItemCountEntry> Entries;
+            Entries.Add(MakeTestCountEntry(1, 2));
+            Entries.Add(MakeTestCountEntry(1, 2));
+            
+            TArray<bool> EntryResults;
+            TestInventory->RemoveItemsByCount(Entries, true, EntryResults, bResult);
+            TestFalse("Removal should fail", bResult);
+            
+            USimpleInventorySlot* Slot = nullptr;
+            TestInventory->GetSlot(0, Slot);
+            TestEqual("Count should be untouched", Slot->Count, 3);
+        });
+    });
+    
+    Describe("Item definitions", [this]() {
+        BeforeEach([this]() {
+            TestItemTable = NewObject<UDataTable>();
+            TestItemTable->RowStruct = FSimpleInventoryItem::StaticStruct();
+            FSimpleInventoryItem Row;
+            Row.ID = 1;
+            Row.bIsStackable = true;
+            Row.StackSize = 10;
+            TestItemTable->AddRow(TEXT("Item1"), Row);
+            FSimpleInventoryItemRegistry::Register(TestItemTable);
+        });
+        
+        AfterEach([this]() {
+            FSimpleInventoryItemRegistry::Unregister(TestItemTable);
+        });
+        
+        It("should reference the definition instead of copying identical items", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestTrue("Item added", bResult);
+            
+            const FSimpleInventorySlot& Slot = TestInventory->GetSlotData()[0];
+            TestTrue("Slot should use the definition", Slot.bUsesDefinition);
+            TestFalse("Slot should hold no copy", Slot.Item.IsValid());
+            TestEqual("Slot item resolves through the registry", Slot.GetItem().Get<const FSimpleInventoryItem>().ID, 1);
+            
+            USimpleInventorySlot* View = nullptr;
+            TestInventory->GetSlot(0, View);
+            TestTrue("Slot view should still see the item", View->Item.IsValid());
+        });
+        
+        It("should keep a copy for items with unique state", [this]() {
+            FSimpleInventoryItem ItemMetadata;
+            ItemMetadata.ID = 1;
+            ItemMetadata.bIsStackable = true;
+            ItemMetadata.StackSize = 10;
+            ItemMetadata.ItemName = FText::FromString(TEXT("Engraved"));
+            
+            bool bResult = false;
+            TestInventory->AddItem(FInstancedStruct::Make(ItemMetadata), 1, bResult);
+            
+            const FSimpleInventorySlot& Slot = TestInventory->GetSlotData()[0];
+            TestFalse("Slot should not use the definition", Slot.bUsesDefinition);
+            TestTrue("Slot should hold its own copy", Slot.Item.IsValid());
+        });
+        
+        It("should add items by ID", [this]() {
+            bool bResult = false;
+            TestInventory->AddItemByID(1, 12, bResult);
+            TestTrue("Item added", bResult);
+            
+            int32 Len;
+            TestInventory->GetLength(Len);
+            TestEqual("Should stack using the definition's StackSize", Len, 2);
+            
+            TestInventory->AddItemByID(2, 1, bResult);
+            TestFalse("Unregistered IDs should fail", bResult);
+        });
+        
+        It("should copy the definition into slots when its table is unregistered", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            const uint64 Generation = TestInventory->GetGeneration();
+            
+            FSimpleInventoryItemRegistry::Unregister(TestItemTable);
+            
+            const FSimpleInventorySlot& Slot = TestInventory->GetSlotData()[0];
+            TestFalse("Slot should no longer use the definition", Slot.bUsesDefinition);
+            TestTrue("Slot should keep its item", Slot.GetItem().IsValid() && Slot.GetItem().Get<const FSimpleInventoryItem>().ID == 1);
+            TestTrue("Generation should advance", TestInventory->GetGeneration() > Generation);
+        });
+        
+        It("should keep reporting the definition a snapshot captured after its table is replaced", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            const FSimpleInventorySnapshot Snapshot = TestInventory->GetSnapshot();
+            
+            UDataTable* OtherTable = NewObject<UDataTable>();
+            OtherTable->RowStruct = FSimpleInventoryItem::StaticStruct();
+            FSimpleInventoryItem Row;
+            Row.ID = 1;
+            Row.StackSize = 99;
+            OtherTable->AddRow(TEXT("Item1"), Row);
+            FSimpleInventoryItemRegistry::Unregister(TestItemTable);
+            FSimpleInventoryItemRegistry::Register(OtherTable);
+            
+            const FConstStructView Item = Snapshot[0].GetItem();
+            TestTrue("The snapshot should still see the unregistered table's row",
+                     Item.IsValid() && Item.Get<const FSimpleInventoryItem>().StackSize == 10);
+            
+            FSimpleInventoryItemRegistry::Unregister(OtherTable);
+        });
+        
+        It("should let worker threads look up definitions while tables change", [this]() {
+            std::atomic<bool> bStop = false;
+            std::atomic<int32> NumInvalidReads = 0;
+            UE::Tasks::FTask Reader = UE::Tasks::Launch(TEXT("SimpleInventorySpec.DefinitionReader"), [&bStop, &NumInvalidReads]() {
+                while (!bStop) {
+                    const FConstStructView Definition = FSimpleInventoryItemRegistry::Find(1);
+                    if (Definition.IsValid() && Definition.Get<const FSimpleInventoryItem>().ID != 1) {
+                        ++NumInvalidReads;
+                    }
+                }
+            });
+            
+            UDataTable* OtherTable = NewObject<UDataTable>();
+            OtherTable->RowStruct = FSimpleInventoryItem::StaticStruct();
+            FSimpleInventoryItem Row;
+            Row.ID = 2;
+            OtherTable->AddRow(TEXT("Item2"), Row);
+            for (int32 Iteration = 0; Iteration < 200; ++Iteration) {
+                FSimpleInventoryItemRegistry::Register(OtherTable);
+                FSimpleInventoryItemRegistry::Unregister(OtherTable);
+            }
+            
+            bStop = true;
+            Reader.Wait();
+            TestEqual("Every lookup should see a whole definition", NumInvalidReads.load(), 0);
+        });
+    });
+    
     Describe("Clear", [this]() {
         It("should remove all slots", [this]() {
             bool bResult = false;
@@ -161,6 +435,32 @@ void SimpleInventorySpec::Define() {
         });
     });
 
+    Describe("RestoreSlots", [this]() {
+        It("should keep the given layout and broadcast one LOAD change", [this]() {
+            TArray<FSimpleInventorySlot> Slots;
+            for (const int32 Count : { 4, 3 }) {
+                FSimpleInventorySlot& Slot = Slots.AddDefaulted_GetRef();
+                Slot.ItemID = 1;
+                Slot.Item = MakeTestItem(1, true);
+                Slot.Count = Count;
+            }
+
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            TestInventory->RestoreSlots(MoveTemp(Slots));
+
+            TestEqual("Both partial stacks should be kept", TestInventory->GetSlotData().Num(), 2);
+            TestEqual("One change should be broadcast", Changes.Num(), 1);
+            TestTrue("The change should be LOAD", Changes.Num() == 1 && Changes[0].Type == ESimpleInventoryChangeType::LOAD);
+
+            int32 Total = 0;
+            TestInventory->GetItemCount(1, Total);
+            TestEqual("Restored slots should be counted", Total, 7);
+        });
+    });
+
     Describe("GetLength / GetMaxSize", [this]() {
         It("should return correct counts", [this]() {
             int32 Len;
@@ -195,9 +495,551 @@ void SimpleInventorySpec::Define() {
             TestInventory->HasItem(1, 3, bHas);
             TestTrue("Should have the item", bHas);
         });
+        
+        It("should find items after earlier slots are removed", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, false), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2, false), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(3), 4, bResult);
+            
+            TestInventory->RemoveItemAtIndex(0, 1, bResult);
+            
+            bool bHas = false;
+            TestInventory->HasItem(3, 4, bHas);
+            TestTrue("Should still have item 3", bHas);
+            TestInventory->HasItem(1, 1, bHas);
+            TestFalse("Should no longer have item 1", bHas);
+            
+            TArray<FInstancedStruct> ItemsToRemove = { MakeTestItem(3) };
+            TestInventory->RemoveItems(ItemsToRemove, bResult);
+            TestTrue("Removal after shift should succeed", bResult);
+            
+            USimpleInventorySlot* Slot = nullptr;
+            TestInventory->GetSlot(1, Slot);
+            TestEqual("Shifted slot should have been decremented", Slot->Count, 3);
+        });
+        
+        It("should not find items after Clear", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestInventory->Clear();
+            
+            bool bHas = true;
+            TestInventory->HasItem(1, 3, bHas);
+            TestFalse("Should not have the item", bHas);
+        });
     });
 
+    Describe("GetItemCount / HasAtLeast", [this]() {
+        It("should total an item across every stack", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, true, 5), 12, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            int32 Total = 0;
+            TestInventory->GetItemCount(1, Total);
+            TestEqual("Total should cover all three stacks", Total, 12);
+            
+            bool bHasAtLeast = false;
+            TestInventory->HasAtLeast(1, 12, bHasAtLeast);
+            TestTrue("Should have at least the total", bHasAtLeast);
+            TestInventory->HasAtLeast(1, 13, bHasAtLeast);
+            TestFalse("Should not have more than the total", bHasAtLeast);
+        });
+        
+        It("should follow removals, Clear and CopyInventory", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, true, 5), 7, bResult);
+            TestInventory->RemoveItemAtIndex(0, 5, bResult);
+            
+            int32 Total = 0;
+            TestInventory->GetItemCount(1, Total);
+            TestEqual("Total should drop with the removed stack", Total, 2);
+            
+            TArray<bool> EntryResults;
+            TestInventory->RemoveItemsByCount({ MakeTestCountEntry(1, 1) }, false, EntryResults, bResult);
+            TestInventory->GetItemCount(1, Total);
+            TestEqual("Total should drop with RemoveItemsByCount", Total, 1);
+            
+            USimpleInventory* Other = NewObject<USimpleInventory>();
+            Other->MaxSlotSize = 5;
+            Other->CopyInventory(TestInventory);
+            Other->GetItemCount(1, Total);
+            TestEqual("Copied inventory should have the same total", Total, 1);
+            
+            TestInventory->Clear();
+            TestInventory->GetItemCount(1, Total);
+            TestEqual("Total should be zero after Clear", Total, 0);
+        });
+    });
+    
+    Describe("GetSlotsOfType", [this]() {
+        It("should list slots under their struct type and every parent type", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            TArray<int32> Result;
+            TestInventory->GetSlotsOfType(FSimpleInventoryItem::StaticStruct(), Result);
+            TestTrue("Item type should list both slots", Result == TArray<int32>({ 0, 1 }));
+            
+            TestInventory->GetSlotsOfType(FTableRowBase::StaticStruct(), Result);
+            TestTrue("Parent type should list both slots", Result == TArray<int32>({ 0, 1 }));
+            
+            TestInventory->GetSlotsOfType(FSimpleInventoryItemEntry::StaticStruct(), Result);
+            TestEqual("Unrelated type should list nothing", Result.Num(), 0);
+        });
+        
+        It("should follow removals and Clear", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(3), 1, bResult);
+            TestInventory->RemoveItemAtIndex(0, 1, bResult);
+            
+            TArray<int32> Result;
+            TestInventory->GetSlotsOfType(FSimpleInventoryItem::StaticStruct(), Result);
+            TestTrue("Remaining slots should shift down", Result == TArray<int32>({ 0, 1 }));
+            
+            TestInventory->Clear();
+            TestInventory->GetSlotsOfType(FSimpleInventoryItem::StaticStruct(), Result);
+            TestEqual("Clear should empty the index", Result.Num(), 0);
+        });
+    });
+    
+    Describe("QueryItems", [this]() {
+        BeforeEach([this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, true, 5), 5, bResult);
+            TestInventory->AddItem(MakeTestItem(2, false, 1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(3, true, 10), 4, bResult);
+        });
+        
+        It("should return the slots matching a property comparison", [this]() {
+            FSimpleInventoryQuery Query;
+            Query.Conditions.Add(MakeTestCondition(TEXT("StackSize"), ESimpleInventoryQueryOperator::GREATER_OR_EQUAL, TEXT("5")));
+            
+            TArray<int32> Result;
+            TestInventory->QueryItems(Query, Result);
+            TestTrue("Should match both stackable items", Result == TArray<int32>({ 0, 2 }));
+        });
+        
+        It("should require every condition to match", [this]() {
+            FSimpleInventoryQuery Query;
+            Query.Conditions.Add(MakeTestCondition(TEXT("bIsStackable"), ESimpleInventoryQueryOperator::EQUAL, TEXT("true")));
+            Query.Conditions.Add(MakeTestCondition(TEXT("ID"), ESimpleInventoryQueryOperator::NOT_EQUAL, TEXT("1")));
+            
+            TArray<int32> Result;
+            TestInventory->QueryItems(Query, Result);
+            TestTrue("Should only match item 3", Result == TArray<int32>({ 2 }));
+        });
+        
+        It("should filter by struct type including parent types", [this]() {
+            FSimpleInventoryQuery Query;
+            Query.StructType = FTableRowBase::StaticStruct();
+            
+            TArray<int32> Result;
+            TestInventory->QueryItems(Query, Result);
+            TestEqual("Parent struct type should match every slot", Result.Num(), 3);
+            
+            Query.StructType = FSimpleInventoryItemEntry::StaticStruct();
+            TestInventory->QueryItems(Query, Result);
+            TestEqual("Unrelated struct type should match nothing", Result.Num(), 0);
+        });
+        
+        It("should not match items without the property", [this]() {
+            FSimpleInventoryQuery Query;
+            Query.Conditions.Add(MakeTestCondition(TEXT("Rarity"), ESimpleInventoryQueryOperator::EQUAL, TEXT("1")));
+            
+            TArray<int32> Result;
+            TestInventory->QueryItems(Query, Result);
+            TestEqual("Unknown property should match nothing", Result.Num(), 0);
+        });
+        
+        It("should reuse a compiled query across inventories", [this]() {
+            FSimpleInventoryQuery Query;
+            Query.Conditions.Add(MakeTestCondition(TEXT("StackSize"), ESimpleInventoryQueryOperator::LESS, TEXT("5")));
+            const FSimpleInventoryCompiledQuery CompiledQuery(Query);
+            
+            USimpleInventory* Other = NewObject<USimpleInventory>();
+            Other->MaxSlotSize = 5;
+            bool bResult = false;
+            Other->AddItem(MakeTestItem(4, true, 2), 2, bResult);
+            Other->AddItem(MakeTestItem(5, true, 20), 2, bResult);
+            
+            TArray<int32> Result;
+            TestInventory->QueryItemsCompiled(CompiledQuery, Result);
+            TestTrue("Should match the non-stackable item", Result == TArray<int32>({ 1 }));
+            Other->QueryItemsCompiled(CompiledQuery, Result);
+            TestTrue("Should match the small stack in the other inventory", Result == TArray<int32>({ 0 }));
+        });
+        
+        It("should compare text properties by their text", [this]() {
+            FSimpleInventoryItem Named;
+            Named.ID = 6;
+            Named.ItemName = FText::FromString(TEXT("Engraved"));
+            bool bResult = false;
+            TestInventory->AddItem(FInstancedStruct::Make(Named), 1, bResult);
+            
+            FSimpleInventoryQuery Query;
+            Query.Conditions.Add(MakeTestCondition(TEXT("ItemName"), ESimpleInventoryQueryOperator::EQUAL, TEXT("Engraved")));
+            TArray<int32> Result;
+            TestInventory->QueryItems(Query, Result);
+            TestTrue("Should match the named item", Result == TArray<int32>({ 3 }));
+            
+            Query.Conditions[0].Operator = ESimpleInventoryQueryOperator::NOT_EQUAL;
+            TestInventory->QueryItems(Query, Result);
+            TestTrue("Should match every other item", Result == TArray<int32>({ 0, 1, 2 }));
+        });
+        
+        It("should compare unsigned properties as unsigned", [this]() {
+            UScriptStruct* UnsignedItem = NewObject<UScriptStruct>(GetTransientPackage(), TEXT("SimpleInventoryUnsignedItem"));
+            FUInt64Property* ValueProperty = new FUInt64Property(UnsignedItem, TEXT("Value"), RF_Public);
+            UnsignedItem->AddCppProperty(ValueProperty);
+            UnsignedItem->Bind();
+            UnsignedItem->StaticLink(true);
+            
+            FInstancedStruct Item;
+            Item.InitializeAs(UnsignedItem);
+            ValueProperty->SetPropertyValue_InContainer(Item.GetMutableMemory(), MAX_uint64);
+            
+            FSimpleInventoryQuery Query;
+            Query.Conditions.Add(MakeTestCondition(TEXT("Value"), ESimpleInventoryQueryOperator::GREATER, TEXT("9223372036854775807")));
+            TestTrue("A value above INT64_MAX should compare greater", FSimpleInventoryCompiledQuery(Query).Matches(Item));
+            
+            Query.Conditions[0].Operator = ESimpleInventoryQueryOperator::EQUAL;
+            Query.Conditions[0].Value = TEXT("18446744073709551615");
+            TestTrue("The largest value should compare equal to itself", FSimpleInventoryCompiledQuery(Query).Matches(Item));
+        });
+    });
+    
+    Describe("SortInventory", [this]() {
+        It("should sort by ID and broadcast one REORDER change with the permutation", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(3), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            FSimpleInventorySortKey Key;
+            Key.Type = ESimpleInventorySortKeyType::ID;
+            TestInventory->SortInventory(Key);
+            
+            const TArray<FSimpleInventorySlot>& Slots = TestInventory->GetSlotData();
+            TestTrue("Slots should be in ID order", Slots[0].ItemID == 1 && Slots[1].ItemID == 2 && Slots[2].ItemID == 3);
+            TestEqual("One change should be broadcast", Changes.Num(), 1);
+            TestTrue("The change should be REORDER", Changes.Num() == 1 && Changes[0].Type == ESimpleInventoryChangeType::REORDER);
+            TestTrue("The permutation should map new slots to old slots", Changes.Num() == 1 && Changes[0].Permutation == TArray<int32>({ 1, 2, 0 }));
+            
+            bool bHas = false;
+            TestInventory->HasItem(3, 1, bHas);
+            TestTrue("Item index should follow the sort", bHas);
+        });
+        
+        It("should not broadcast when already sorted", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            int32 NumChanges = 0;
+            TestInventory->OnInventoryChangeNative.AddLambda([&NumChanges](const FSimpleInventoryChange&) {
+                ++NumChanges;
+            });
+            TestInventory->SortInventory(FSimpleInventorySortKey());
+            TestEqual("No change should be broadcast", NumChanges, 0);
+        });
+        
+        It("should sort by a property in descending order and keep ties stable", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, true, 5), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2, true, 20), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(3, true, 5), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(4, true, 10), 1, bResult);
+            
+            FSimpleInventorySortKey Key;
+            Key.Type = ESimpleInventorySortKeyType::PROPERTY;
+            Key.PropertyName = TEXT("StackSize");
+            Key.bDescending = true;
+            TestInventory->SortInventory(Key);
+            
+            const TArray<FSimpleInventorySlot>& Slots = TestInventory->GetSlotData();
+            TestTrue("Slots should be ordered by StackSize, ties in their previous order",
+                     Slots[0].ItemID == 2 && Slots[1].ItemID == 4 && Slots[2].ItemID == 1 && Slots[3].ItemID == 3);
+        });
+        
+        It("should sort with a custom comparison and keep empty slots last", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 2, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 7, bResult);
+            TestInventory->ForceResize();
+            
+            TestInventory->SortInventoryBy([](const FSimpleInventorySlot& A, const FSimpleInventorySlot& B) {
+                return A.Count > B.Count;
+            });
+            
+            const TArray<FSimpleInventorySlot>& Slots = TestInventory->GetSlotData();
+            TestEqual("Largest stack should come first", Slots[0].ItemID, 2);
+            TestTrue("Empty slots should stay at the end", Slots[4].IsEmpty());
+        });
+        
+        It("should stable sort inventories above the parallel threshold", [this]() {
+            const int32 NumSlots = FSimpleInventoryParallelSort::ParallelThreshold * 3;
+            TestInventory->MaxSlotSize = NumSlots;
+            
+            TArray<FSimpleInventorySlot> Slots;
+            for (int32 Index = 0; Index < NumSlots; ++Index) {
+                FSimpleInventorySlot& Slot = Slots.AddDefaulted_GetRef();
+                Slot.ItemID = (Index * 7919) % 100;
+                Slot.Item = MakeTestItem(Slot.ItemID, false, 1);
+                Slot.Count = 1;
+            }
+            TArray<int32> PreviousItemIDs;
+            for (const FSimpleInventorySlot& Slot : Slots) {
+                PreviousItemIDs.Add(Slot.ItemID);
+            }
+            TestInventory->RestoreSlots(MoveTemp(Slots));
+            
+            TArray<int32> Permutation;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Permutation](const FSimpleInventoryChange& Change) {
+                Permutation = Change.Permutation;
+            });
+            TestInventory->SortInventory(FSimpleInventorySortKey());
+            
+            const TArray<FSimpleInventorySlot>& SortedSlots = TestInventory->GetSlotData();
+            bool bSorted = Permutation.Num() == NumSlots;
+            for (int32 Index = 1; bSorted && Index < NumSlots; ++Index) {
+                const bool bSameID = SortedSlots[Index - 1].ItemID == SortedSlots[Index].ItemID;
+                bSorted = SortedSlots[Index - 1].ItemID <= SortedSlots[Index].ItemID
+                    && (!bSameID || Permutation[Index - 1] < Permutation[Index])
+                    && PreviousItemIDs[Permutation[Index]] == SortedSlots[Index].ItemID;
+            }
+            TestTrue("Slots should be stable sorted and match the permutation", bSorted);
+        });
+    });
+
+    Describe("Consolidate", [this]() {
+        It("should merge partial stacks and compact the slots with one BATCH change", [this]() {
+            // ID 1 split over three partial stacks, with a non-stackable ID 2 in between.
+            TArray<FSimpleInventorySlot> Slots;
+            const int32 ItemIDs[] = { 1, 2, 1, 1 };
+            const int32 Counts[] = { 4, 1, 3, 5 };
+            for (int32 Index = 0; Index < 4; ++Index) {
+                FSimpleInventorySlot& Slot = Slots.AddDefaulted_GetRef();
+                Slot.ItemID = ItemIDs[Index];
+                Slot.Item = MakeTestItem(ItemIDs[Index], ItemIDs[Index] == 1);
+                Slot.Count = Counts[Index];
+            }
+            TestInventory->RestoreSlots(MoveTemp(Slots));
+            
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            int32 FreedSlots = 0;
+            TestInventory->Consolidate(FreedSlots);
+            
+            const TArray<FSimpleInventorySlot>& Consolidated = TestInventory->GetSlotData();
+            TestEqual("One slot should be freed", FreedSlots, 1);
+            TestEqual("Three slots should remain", Consolidated.Num(), 3);
+            TestTrue("The first stack should be filled", Consolidated[0].ItemID == 1 && Consolidated[0].Count == 10);
+            TestTrue("The non-stackable slot should keep its place", Consolidated[1].ItemID == 2 && Consolidated[1].Count == 1);
+            TestTrue("The rest should stay in one stack", Consolidated[2].ItemID == 1 && Consolidated[2].Count == 2);
+            TestEqual("One change should be broadcast", Changes.Num(), 1);
+            TestTrue("The change should be BATCH and list the changed slots",
+                     Changes.Num() == 1 && Changes[0].Type == ESimpleInventoryChangeType::BATCH && Changes[0].SlotIndices == TArray<int32>({ 0, 2, 3 }));
+            
+            int32 Total = 0;
+            TestInventory->GetItemCount(1, Total);
+            TestEqual("The item total should not change", Total, 12);
+        });
+        
+        It("should keep padded inventories padded", [this]() {
+            TArray<FSimpleInventorySlot> Slots;
+            Slots.SetNum(5);
+            Slots[1].ItemID = 2;
+            Slots[1].Item = MakeTestItem(2);
+            Slots[1].Count = 3;
+            Slots[3].ItemID = 1;
+            Slots[3].Item = MakeTestItem(1);
+            Slots[3].Count = 3;
+            TestInventory->RestoreSlots(MoveTemp(Slots));
+            
+            int32 FreedSlots = INDEX_NONE;
+            TestInventory->Consolidate(FreedSlots);
+            
+            const TArray<FSimpleInventorySlot>& Consolidated = TestInventory->GetSlotData();
+            TestEqual("No slot should be freed", FreedSlots, 0);
+            TestEqual("The slot count should stay the same", Consolidated.Num(), 5);
+            TestTrue("Items should move to the front in order", Consolidated[0].ItemID == 2 && Consolidated[1].ItemID == 1);
+            TestTrue("Empty slots should move to the end", Consolidated[2].IsEmpty() && Consolidated[4].IsEmpty());
+        });
+        
+        It("should not broadcast when already consolidated", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 10, bResult);
+            TestInventory->AddItem(MakeTestItem(2, false, 1), 1, bResult);
+            
+            int32 NumChanges = 0;
+            TestInventory->OnInventoryChangeNative.AddLambda([&NumChanges](const FSimpleInventoryChange&) {
+                ++NumChanges;
+            });
+            
+            int32 FreedSlots = INDEX_NONE;
+            TestInventory->Consolidate(FreedSlots);
+            TestEqual("No slot should be freed", FreedSlots, 0);
+            TestEqual("No change should be broadcast", NumChanges, 0);
+        });
+    });
+    
+    Describe("TransferItems", [this]() {
+        It("should move an emptied slot's item and broadcast one TRANSFER change on each side", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestInventory->AddItem(MakeTestItem(2, false, 1), 1, bResult);
+            const void* ItemMemory = TestInventory->GetSlotData()[0].Item.GetMemory();
+            
+            USimpleInventory* Target = NewObject<USimpleInventory>();
+            Target->InventoryName = TEXT("TargetInv");
+            Target->MaxSlotSize = 5;
+            
+            TArray<FSimpleInventoryChange> SourceChanges;
+            TestInventory->OnInventoryChangeNative.AddLambda([&SourceChanges](const FSimpleInventoryChange& Change) {
+                SourceChanges.Add(Change);
+            });
+            TArray<FSimpleInventoryChange> TargetChanges;
+            Target->OnInventoryChangeNative.AddLambda([&TargetChanges](const FSimpleInventoryChange& Change) {
+                TargetChanges.Add(Change);
+            });
+            
+            TestInventory->TransferItems(0, Target, 3, bResult);
+            TestTrue("Transfer should succeed", bResult);
+            
+            TestEqual("The emptied slot should be removed", TestInventory->GetSlotData().Num(), 1);
+            TestEqual("The target should hold the items", Target->GetSlotData().Num(), 1);
+            TestTrue("The item should be moved, not copied", Target->GetSlotData()[0].Item.GetMemory() == ItemMemory);
+            
+            int32 SourceTotal = INDEX_NONE;
+            TestInventory->GetItemCount(1, SourceTotal);
+            int32 TargetTotal = INDEX_NONE;
+            Target->GetItemCount(1, TargetTotal);
+            TestEqual("The source total should drop", SourceTotal, 0);
+            TestEqual("The target total should rise", TargetTotal, 3);
+            
+            TestTrue("The source should broadcast one TRANSFER change",
+                     SourceChanges.Num() == 1 && SourceChanges[0].Type == ESimpleInventoryChangeType::TRANSFER && SourceChanges[0].bIsTransferSource);
+            TestTrue("The target should broadcast one TRANSFER change describing both sides",
+                     TargetChanges.Num() == 1 && TargetChanges[0].Type == ESimpleInventoryChangeType::TRANSFER
+                     && TargetChanges[0].TransferInventoryName == TestInventory->InventoryName
+                     && TargetChanges[0].SlotIndices == TArray<int32>({ 0 }) && TargetChanges[0].TransferSlotIndices == TArray<int32>({ 0 }));
+        });
+        
+        It("should fill the target's stacks and leave the rest of a partial slot", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 6, bResult);
+            
+            USimpleInventory* Target = NewObject<USimpleInventory>();
+            Target->MaxSlotSize = 5;
+            Target->AddItem(MakeTestItem(1), 8, bResult);
+            
+            TestInventory->TransferItems(0, Target, 5, bResult);
+            TestTrue("Transfer should succeed", bResult);
+            
+            const TArray<FSimpleInventorySlot>& TargetSlots = Target->GetSlotData();
+            TestTrue("The existing stack should be filled first", TargetSlots.Num() == 2 && TargetSlots[0].Count == 10 && TargetSlots[1].Count == 3);
+            TestEqual("The source slot should keep the rest", TestInventory->GetSlotData()[0].Count, 1);
+            TestTrue("The source slot should keep its item", TestInventory->GetSlotData()[0].Item.IsValid());
+        });
+        
+        It("should move several slots with one change per inventory", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, false, 1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 4, bResult);
+            TestInventory->AddItem(MakeTestItem(3, false, 1), 1, bResult);
+            
+            USimpleInventory* Target = NewObject<USimpleInventory>();
+            Target->MaxSlotSize = 5;
+            
+            TArray<FSimpleInventoryChange> SourceChanges;
+            TestInventory->OnInventoryChangeNative.AddLambda([&SourceChanges](const FSimpleInventoryChange& Change) {
+                SourceChanges.Add(Change);
+            });
+            TArray<FSimpleInventoryChange> TargetChanges;
+            Target->OnInventoryChangeNative.AddLambda([&TargetChanges](const FSimpleInventoryChange& Change) {
+                TargetChanges.Add(Change);
+            });
+            
+            FSimpleInventoryTransferEntry First;
+            First.SlotIndex = 0;
+            First.Count = 1;
+            FSimpleInventoryTransferEntry Last;
+            Last.SlotIndex = 2;
+            Last.Count = 1;
+            TestInventory->TransferItemsBatch({ First, Last }, Target, bResult);
+            TestTrue("Transfer should succeed", bResult);
+            
+            TestTrue("Only the middle slot should remain", TestInventory->GetSlotData().Num() == 1 && TestInventory->GetSlotData()[0].ItemID == 2);
+            TestTrue("The target should hold both items in entry order",
+                     Target->GetSlotData().Num() == 2 && Target->GetSlotData()[0].ItemID == 1 && Target->GetSlotData()[1].ItemID == 3);
+            TestEqual("The source should broadcast once", SourceChanges.Num(), 1);
+            TestEqual("The target should broadcast once", TargetChanges.Num(), 1);
+            TestTrue("The source change should report its slots in ascending order",
+                     SourceChanges.Num() == 1 && SourceChanges[0].SlotIndices == TArray<int32>({ 0, 2 }));
+            TestTrue("The target change should report the source slots in ascending order",
+                     TargetChanges.Num() == 1 && TargetChanges[0].TransferSlotIndices == TArray<int32>({ 0, 2 }));
+        });
+        
+        It("should change nothing if the transfer does not fit", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, false, 1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2, false, 1), 1, bResult);
+            
+            USimpleInventory* Target = NewObject<USimpleInventory>();
+            Target->MaxSlotSize = 2;
+            Target->AddItem(MakeTestItem(3, false, 1), 1, bResult);
+            
+            int32 NumChanges = 0;
+            TestInventory->OnInventoryChangeNative.AddLambda([&NumChanges](const FSimpleInventoryChange&) {
+                ++NumChanges;
+            });
+            Target->OnInventoryChangeNative.AddLambda([&NumChanges](const FSimpleInventoryChange&) {
+                ++NumChanges;
+            });
+            
+            FSimpleInventoryTransferEntry First;
+            First.SlotIndex = 0;
+            First.Count = 1;
+            FSimpleInventoryTransferEntry Second;
+            Second.SlotIndex = 1;
+            Second.Count = 1;
+            TestInventory->TransferItemsBatch({ First, Second }, Target, bResult);
+            TestFalse("Transfer should fail", bResult);
+            
+            TestEqual("The source should keep its slots", TestInventory->GetSlotData().Num(), 2);
+            TestEqual("The target should keep its slots", Target->GetSlotData().Num(), 1);
+            TestEqual("Nothing should be broadcast", NumChanges, 0);
+        });
+    });
+    
     Describe("CopyInventory", [this]() {
+        It("should not share slots with the source inventory", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            
+            USimpleInventory* Other = NewObject<USimpleInventory>();
+            Other->MaxSlotSize = 5;
+            Other->CopyInventory(TestInventory);
+            TestInventory->RemoveItemAtIndex(0, 1, bResult);
+            
+            USimpleInventorySlot* Slot = nullptr;
+            Other->GetSlot(0, Slot);
+            TestEqual("Copied slot should keep its count", Slot->Count, 3);
+        });
+        
         It("should copy slots from another inventory", [this]() {
             bool bResult = false;
             TestInventory->AddItem(MakeTestItem(1), 1, bResult);
@@ -210,9 +1052,275 @@ void SimpleInventorySpec::Define() {
             int32 Len;
             Other->GetLength(Len);
             TestEqual("Copied inventory length", Len, 1);
+            
+            bool bHas = false;
+            Other->HasItem(1, 1, bHas);
+            TestTrue("Copied inventory should find the item", bHas);
+        });
+        
+        It("should share the source snapshot until the copy is used", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            USimpleInventory* Other = NewObject<USimpleInventory>();
+            Other->MaxSlotSize = 5;
+            Other->CopyInventory(TestInventory);
+            
+            const FSimpleInventorySnapshot Source = TestInventory->GetSnapshot();
+            const FSimpleInventorySnapshot Copy = Other->GetSnapshot();
+            TestTrue("Copy should share the source's slots", &Source[0] == &Copy[0]);
+            TestEqual("Copy snapshot should have its own generation", Copy.GetGeneration(), Other->GetGeneration());
+            
+            int32 Len = 0;
+            int32 Total = 0;
+            Other->GetLength(Len);
+            Other->GetItemCount(1, Total);
+            TestEqual("Length should be known before the copy is used", Len, 2);
+            TestEqual("Totals should be known before the copy is used", Total, 3);
+            TestEqual("Reading the copy's slots should fill them in", Other->GetSlotData().Num(), 2);
+            TestTrue("Snapshot should stay valid once the slots are filled in", Other->GetSnapshot().GetGeneration() == Copy.GetGeneration());
+        });
+        
+        It("should serve reads from the shared snapshot until the copy changes", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            USimpleInventory* Other = NewObject<USimpleInventory>();
+            Other->MaxSlotSize = 5;
+            Other->CopyInventory(TestInventory);
+            const FSimpleInventorySnapshot Source = TestInventory->GetSnapshot();
+            
+            USimpleInventorySlot* Slot = nullptr;
+            Other->GetSlot(1, Slot);
+            bool bHas = false;
+            Other->HasItem(1, 3, bHas);
+            TArray<int32> SlotsOfType;
+            Other->GetSlotsOfType(FSimpleInventoryItem::StaticStruct(), SlotsOfType);
+            FSimpleInventorySlot ThreadSafeSlot;
+            
+            TestTrue("GetSlot should read the copied slot", Slot && Slot->Count == 1);
+            TestTrue("HasItem should find the copied item", bHas);
+            TestTrue("GetSlotsOfType should find the copied slots", SlotsOfType == TArray<int32>({ 0, 1 }));
+            TestTrue("GetSlotThreadSafe should read the copied slot", Other->GetSlotThreadSafe(0, ThreadSafeSlot) && ThreadSafeSlot.Count == 3);
+            TestEqual("GetLengthThreadSafe should count the copied slots", Other->GetLengthThreadSafe(), 2);
+            TestTrue("Reads should leave the slots shared", &Other->GetSlotDataAt(0) == &Source[0]);
+            
+            // The copy keeps its own slot indices, so changing the source does not reach its lookups.
+            TestInventory->RemoveItemAtIndex(0, 3, bResult);
+            Other->HasItem(1, 3, bHas);
+            TestTrue("HasItem should not see changes to the source", bHas);
+            
+            Other->AddItem(MakeTestItem(3), 1, bResult);
+            TestTrue("The first change should copy the slots", &Other->GetSlotDataAt(0) != &Source[0]);
+            TestEqual("The copied slots should keep their counts", Other->GetSlotDataAt(0).Count, 3);
+            Other->GetSlotsOfType(FSimpleInventoryItem::StaticStruct(), SlotsOfType);
+            TestTrue("The copied indices should keep up with later changes", SlotsOfType == TArray<int32>({ 0, 1, 2 }));
+        });
+        
+        It("should not change the source when the copy changes", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            
+            USimpleInventory* Other = NewObject<USimpleInventory>();
+            Other->MaxSlotSize = 5;
+            Other->CopyInventory(TestInventory);
+            Other->RemoveItemAtIndex(0, 1, bResult);
+            Other->AddItem(MakeTestItem(2), 1, bResult);
+            
+            TestEqual("Source should keep its count", TestInventory->GetSlotData()[0].Count, 3);
+            TestEqual("Source should keep its length", TestInventory->GetSlotData().Num(), 1);
+            TestEqual("Copy should see its own change", Other->GetSlotData()[0].Count, 2);
+            
+            bool bHas = false;
+            Other->HasItem(2, 1, bHas);
+            TestTrue("Copy should index the slots it filled in", bHas);
+        });
+        
+        It("should drop a pending copy on Clear", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            
+            USimpleInventory* Other = NewObject<USimpleInventory>();
+            Other->MaxSlotSize = 5;
+            Other->CopyInventory(TestInventory);
+            Other->Clear();
+            
+            int32 Len = 0;
+            int32 Total = 0;
+            Other->GetLength(Len);
+            Other->GetItemCount(1, Total);
+            TestEqual("Cleared copy should be empty", Len, 0);
+            TestEqual("Cleared copy should have no items", Total, 0);
         });
     });
 
+    Describe("OnInventoryChangeNative", [this]() {
+        It("should broadcast the change struct with the item", [this]() {
+            TArray<FSimpleInventoryChange> Changes;
+            int32 BroadcastItemID = INDEX_NONE;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes, &BroadcastItemID](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+                if (const FSimpleInventoryItem* Item = Change.Item.GetPtr<const FSimpleInventoryItem>()) {
+                    BroadcastItemID = Item->ID;
+                }
+            });
+            
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(7), 2, bResult);
+            
+            TestEqual("One change should be broadcast", Changes.Num(), 1);
+            TestTrue("Change type should be ADDITION", Changes[0].Type == ESimpleInventoryChangeType::ADDITION);
+            TestEqual("Change item ID", Changes[0].ItemID, 7);
+            TestEqual("Change count", Changes[0].Count, 2);
+            TestEqual("Item view should be valid during broadcast", BroadcastItemID, 7);
+        });
+        
+        It("should broadcast after the whole change so listeners can change the inventory again", [this]() {
+            TestInventory->MaxSlotSize = 10;
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1, true, 3), 3, bResult);
+            TestInventory->AddItem(MakeTestItem(2, false), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(1, true, 3), 1, bResult);
+            TestInventory->RemoveItemAtIndex(0, 1, bResult);
+            
+            TArray<int32> TotalsSeen;
+            TArray<int32> ItemIDsSeen;
+            TestInventory->OnInventoryChangeNative.AddLambda([this, &TotalsSeen, &ItemIDsSeen](const FSimpleInventoryChange& Change) {
+                int32 Total = 0;
+                TestInventory->GetItemCount(1, Total);
+                TotalsSeen.Add(Total);
+                if (const FSimpleInventoryItem* Item = Change.Item.GetPtr<const FSimpleInventoryItem>()) {
+                    ItemIDsSeen.Add(Item->ID);
+                }
+                if (Change.ItemID == 1) {
+                    bool bAdded = false;
+                    TestInventory->AddItem(MakeTestItem(3, false), 1, bAdded);
+                }
+            });
+            
+            // Tops up both partial stacks of item 1, then opens a new slot for the rest.
+            TestInventory->AddItem(MakeTestItem(1, true, 3), 6, bResult);
+            TestTrue("Add successful", bResult);
+            
+            int32 Total = 0;
+            TestInventory->GetItemCount(1, Total);
+            TestEqual("Item 1 total", Total, 9);
+            TestTrue("Every listener should see the finished addition", TotalsSeen.Num() > 1 && TotalsSeen.FindByPredicate([](const int32 Seen) { return Seen != 9; }) == nullptr);
+            TestEqual("Each item 1 change should have added one item 3", ItemIDsSeen.FilterByPredicate([](const int32 ID) { return ID == 3; }).Num(), ItemIDsSeen.FilterByPredicate([](const int32 ID) { return ID == 1; }).Num());
+            
+            int32 Len = 0;
+            TestInventory->GetLength(Len);
+            TestEqual("Inventory length", Len, 4 + ItemIDsSeen.FilterByPredicate([](const int32 ID) { return ID == 3; }).Num());
+        });
+    });
+    
+    Describe("BeginBatch / EndBatch", [this]() {
+        It("should broadcast one merged change for the whole batch", [this]() {
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            bool bResult = false;
+            {
+                FSimpleInventoryBatchScope Batch(TestInventory);
+                TestInventory->AddItem(MakeTestItem(1), 2, bResult);
+                TestInventory->AddItem(MakeTestItem(1), 2, bResult);
+                TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+                TestInventory->RemoveItemAtIndex(0, 1, bResult);
+                TestEqual("Nothing should be broadcast inside the batch", Changes.Num(), 0);
+            }
+            
+            TestEqual("One change should be broadcast", Changes.Num(), 1);
+            TestTrue("Change type should be BATCH", Changes[0].Type == ESimpleInventoryChangeType::BATCH);
+            TestEqual("Two slots should be affected", Changes[0].SlotIndices.Num(), 2);
+            TestEqual("Two items should have changed", Changes[0].ItemDeltas.Num(), 2);
+            for (const FSimpleInventoryItemDelta& ItemDelta : Changes[0].ItemDeltas) {
+                TestEqual("Net delta", ItemDelta.Delta, ItemDelta.ItemID == 1 ? 3 : 1);
+            }
+        });
+        
+        It("should only broadcast when the outermost batch ends", [this]() {
+            int32 NumChanges = 0;
+            TestInventory->OnInventoryChangeNative.AddLambda([&NumChanges](const FSimpleInventoryChange&) {
+                ++NumChanges;
+            });
+            
+            bool bResult = false;
+            TestInventory->BeginBatch();
+            TestInventory->BeginBatch();
+            TestInventory->AddItem(MakeTestItem(1), 1, bResult);
+            TestInventory->EndBatch();
+            TestEqual("Inner EndBatch should not broadcast", NumChanges, 0);
+            TestInventory->EndBatch();
+            TestEqual("Outer EndBatch should broadcast", NumChanges, 1);
+        });
+        
+        It("should report slots as they are after a removal shifted them", [this]() {
+            bool bResult = false;
+            for (int32 ItemID = 1; ItemID <= 4; ++ItemID) {
+                TestInventory->AddItem(MakeTestItem(ItemID), 1, bResult);
+            }
+            
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            {
+                FSimpleInventoryBatchScope Batch(TestInventory);
+                TestInventory->AddItem(MakeTestItem(4), 1, bResult);
+                TestInventory->RemoveItemAtIndex(1, 1, bResult);
+            }
+            
+            TestTrue("Every slot from the removed one on should be reported, and none past the end",
+                     Changes.Num() == 1 && Changes[0].SlotIndices == TArray<int32>({ 1, 2 }));
+        });
+        
+        It("should forward FULL after the batch instead of merging it", [this]() {
+            TestInventory->MaxSlotSize = 1;
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 1, bResult);
+            
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            {
+                FSimpleInventoryBatchScope Batch(TestInventory);
+                TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            }
+            
+            TestTrue("Only the FULL change should be broadcast",
+                     Changes.Num() == 1 && Changes[0].Type == ESimpleInventoryChangeType::FULL && Changes[0].ItemID == 2);
+        });
+        
+        It("should report every slot when the batch sorts", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(3), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(1), 1, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            TArray<FSimpleInventoryChange> Changes;
+            TestInventory->OnInventoryChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            {
+                FSimpleInventoryBatchScope Batch(TestInventory);
+                FSimpleInventorySortKey Key;
+                Key.Type = ESimpleInventorySortKeyType::ID;
+                TestInventory->SortInventory(Key);
+            }
+            
+            TestTrue("A batched sort should refresh every slot",
+                     Changes.Num() == 1 && Changes[0].Type == ESimpleInventoryChangeType::BATCH && Changes[0].SlotIndices == TArray<int32>({ 0, 1, 2 }));
+        });
+    });
+    
     Describe("ForceOnChange / ForceResize", [this]() {
         It("should resize slot array and broadcast", [this]() {
             TestInventory->ForceResize();
@@ -221,4 +1329,295 @@ void SimpleInventorySpec::Define() {
             TestEqual("Length should equal MaxSlotSize after resize", Len, 5);
         });
     });
+    
+    Describe("GetSnapshot", [this]() {
+        It("should return the same snapshot while nothing changes", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            
+            const FSimpleInventorySnapshot First = TestInventory->GetSnapshot();
+            const FSimpleInventorySnapshot Second = TestInventory->GetSnapshot();
+            TestEqual("Snapshot should hold one slot", First.Num(), 1);
+            TestEqual("Snapshot generation should match the inventory", First.GetGeneration(), TestInventory->GetGeneration());
+            TestTrue("Unchanged inventory should return the same slots", &First[0] == &Second[0]);
+        });
+        
+        It("should keep its slots after the inventory changes", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 4, bResult);
+            
+            const FSimpleInventorySnapshot Snapshot = TestInventory->GetSnapshot();
+            TestInventory->RemoveItemAtIndex(0, 3, bResult);
+            TestInventory->Clear();
+            
+            TestEqual("Snapshot should keep both slots", Snapshot.Num(), 2);
+            TestEqual("First slot should be unchanged", Snapshot[0].ItemID, 1);
+            TestEqual("First slot count should be unchanged", Snapshot[0].Count, 3);
+            TestEqual("Second slot should be unchanged", Snapshot[1].ItemID, 2);
+            TestEqual("New snapshot should be empty", TestInventory->GetSnapshot().Num(), 0);
+        });
+        
+        It("should only copy the chunks holding changed slots", [this]() {
+            constexpr int32 NumSlots = FSimpleInventorySnapshot::ChunkSize * 2 + 2;
+            TestInventory->MaxSlotSize = NumSlots;
+            bool bResult = false;
+            for (int32 ItemID = 0; ItemID < NumSlots; ++ItemID) {
+                TestInventory->AddItem(MakeTestItem(ItemID), 1, bResult);
+            }
+            
+            const int32 ChangedIndex = FSimpleInventorySnapshot::ChunkSize + 1;
+            const FSimpleInventorySnapshot Before = TestInventory->GetSnapshot();
+            TestInventory->AddItem(MakeTestItem(ChangedIndex), 1, bResult);
+            const FSimpleInventorySnapshot After = TestInventory->GetSnapshot();
+            
+            TestTrue("First chunk should be shared", &Before[0] == &After[0]);
+            TestTrue("Last chunk should be shared", &Before[NumSlots - 1] == &After[NumSlots - 1]);
+            TestFalse("Changed chunk should be copied", &Before[ChangedIndex] == &After[ChangedIndex]);
+            TestEqual("Old snapshot should keep the old count", Before[ChangedIndex].Count, 1);
+            TestEqual("New snapshot should see the new count", After[ChangedIndex].Count, 2);
+        });
+        
+        It("should copy every chunk after a removed slot", [this]() {
+            constexpr int32 NumSlots = FSimpleInventorySnapshot::ChunkSize * 2;
+            TestInventory->MaxSlotSize = NumSlots;
+            bool bResult = false;
+            for (int32 ItemID = 0; ItemID < NumSlots; ++ItemID) {
+                TestInventory->AddItem(MakeTestItem(ItemID), 1, bResult);
+            }
+            
+            const FSimpleInventorySnapshot Before = TestInventory->GetSnapshot();
+            TestInventory->RemoveItemAtIndex(FSimpleInventorySnapshot::ChunkSize, 1, bResult);
+            const FSimpleInventorySnapshot After = TestInventory->GetSnapshot();
+            
+            TestTrue("Chunk before the removal should be shared", &Before[0] == &After[0]);
+            TestEqual("Snapshot should have one slot less", After.Num(), NumSlots - 1);
+            TestEqual("Slots after the removal should shift down", After[FSimpleInventorySnapshot::ChunkSize].ItemID, FSimpleInventorySnapshot::ChunkSize + 1);
+        });
+        
+        It("should keep the objects referenced by a held snapshot alive", [this]() {
+            // An item struct with an object reference, as an item with an icon or mesh would have.
+            UScriptStruct* ObjectItem = NewObject<UScriptStruct>(GetTransientPackage(), TEXT("SimpleInventorySnapshotObjectItem"));
+            FObjectProperty* ObjectProperty = new FObjectProperty(ObjectItem, TEXT("Object"), RF_Public);
+            ObjectProperty->PropertyClass = UObject::StaticClass();
+            ObjectItem->AddCppProperty(ObjectProperty);
+            ObjectItem->Bind();
+            ObjectItem->StaticLink(true);
+            ObjectItem->AddToRoot();
+            TestInventory->AddToRoot();
+            
+            TWeakObjectPtr<UObject> Referenced = NewObject<UDataTable>(GetTransientPackage());
+            TArray<FSimpleInventorySlot> Slots;
+            FSimpleInventorySlot& Slot = Slots.AddDefaulted_GetRef();
+            Slot.ItemID = 1;
+            Slot.Item.InitializeAs(ObjectItem);
+            ObjectProperty->SetObjectPropertyValue_InContainer(Slot.Item.GetMutableMemory(), Referenced.Get());
+            Slot.Count = 1;
+            TestInventory->RestoreSlots(MoveTemp(Slots));
+            
+            {
+                // Neither the inventory nor its latest snapshot holds the item anymore; only Held does.
+                const FSimpleInventorySnapshot Held = TestInventory->GetSnapshot();
+                TestInventory->Clear();
+                TestInventory->GetSnapshot();
+                CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+                TestTrue("The held snapshot's object should survive garbage collection", Referenced.IsValid());
+            }
+            
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+            TestFalse("The object should be collected once the snapshot is released", Referenced.IsValid());
+            
+            TestInventory->RemoveFromRoot();
+            ObjectItem->RemoveFromRoot();
+        });
+    });
+    
+    Describe("Serialize", [this]() {
+        It("should rebuild the slot index and totals after loading", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            TArray<uint8> Bytes;
+            FMemoryWriter Writer(Bytes, true);
+            FObjectAndNameAsStringProxyArchive SaveArchive(Writer, false);
+            TestInventory->Serialize(SaveArchive);
+            
+            USimpleInventory* Loaded = NewObject<USimpleInventory>();
+            FMemoryReader Reader(Bytes, true);
+            FObjectAndNameAsStringProxyArchive LoadArchive(Reader, false);
+            Loaded->Serialize(LoadArchive);
+            
+            bool bHas = false;
+            int32 Total = 0;
+            Loaded->HasItem(2, 1, bHas);
+            Loaded->GetItemCount(1, Total);
+            TestTrue("Loaded inventory should find the item", bHas);
+            TestEqual("Loaded inventory should know its totals", Total, 3);
+        });
+        
+        It("should save a copied inventory off the game thread before its copy is applied", [this]() {
+            bool bResult = false;
+            TestInventory->AddItem(MakeTestItem(1), 3, bResult);
+            TestInventory->AddItem(MakeTestItem(2), 1, bResult);
+            
+            USimpleInventory* Copy = NewObject<USimpleInventory>();
+            Copy->CopyInventory(TestInventory);
+            
+            TArray<uint8> Bytes;
+            UE::Tasks::Launch(TEXT("SimpleInventorySpec.Saver"), [Copy, &Bytes]() {
+                FMemoryWriter Writer(Bytes, true);
+                FObjectAndNameAsStringProxyArchive SaveArchive(Writer, false);
+                Copy->Serialize(SaveArchive);
+            }).Wait();
+            
+            USimpleInventory* Loaded = NewObject<USimpleInventory>();
+            FMemoryReader Reader(Bytes, true);
+            FObjectAndNameAsStringProxyArchive LoadArchive(Reader, false);
+            Loaded->Serialize(LoadArchive);
+            
+            bool bHas = false;
+            int32 Total = 0;
+            Loaded->HasItem(2, 1, bHas);
+            Loaded->GetItemCount(1, Total);
+            TestEqual("Loaded inventory should have the copied slots", Loaded->GetNumSlots(), TestInventory->GetNumSlots());
+            TestTrue("Loaded inventory should find the item", bHas);
+            TestEqual("Loaded inventory should know its totals", Total, 3);
+            TestEqual("The copy should still read its slots", Copy->GetNumSlots(), TestInventory->GetNumSlots());
+        });
+        
+        It("should convert slots saved as USimpleInventorySlot objects", [this]() {
+            // The layout InventorySlots had before it held structs: TArray<USimpleInventorySlot*>.
+            UScriptStruct* LegacyLayout = NewObject<UScriptStruct>(GetTransientPackage(), TEXT("SimpleInventoryLegacyLayout"));
+            FArrayProperty* LegacyArray = new FArrayProperty(LegacyLayout, TEXT("InventorySlots"), RF_Public);
+            FObjectProperty* LegacyInner = new FObjectProperty(LegacyArray, TEXT("InventorySlots"), RF_Public);
+            LegacyInner->PropertyClass = USimpleInventorySlot::StaticClass();
+            LegacyArray->AddCppProperty(LegacyInner);
+            LegacyLayout->AddCppProperty(LegacyArray);
+            LegacyLayout->Bind();
+            LegacyLayout->StaticLink(true);
+            
+            TArray<USimpleInventorySlot*> LegacySlots;
+            for (int32 Index = 0; Index < 2; ++Index) {
+                USimpleInventorySlot* LegacySlot = NewObject<USimpleInventorySlot>(GetTransientPackage());
+                LegacySlot->Item = MakeTestItem(4 + Index);
+                LegacySlot->Count = 2 + Index;
+                LegacySlots.Add(LegacySlot);
+            }
+            
+            TArray<uint8> LegacyData;
+            LegacyData.SetNumZeroed(LegacyLayout->GetStructureSize());
+            LegacyLayout->InitializeStruct(LegacyData.GetData());
+            FScriptArrayHelper LegacyHelper(LegacyArray, LegacyArray->ContainerPtrToValuePtr<void>(LegacyData.GetData()));
+            LegacyHelper.AddValues(LegacySlots.Num());
+            for (int32 Index = 0; Index < LegacySlots.Num(); ++Index) {
+                LegacyInner->SetObjectPropertyValue(LegacyHelper.GetRawPtr(Index), LegacySlots[Index]);
+            }
+            
+            TArray<uint8> Bytes;
+            FMemoryWriter Writer(Bytes, true);
+            FObjectAndNameAsStringProxyArchive SaveArchive(Writer, false);
+            LegacyLayout->SerializeTaggedProperties(SaveArchive, LegacyData.GetData(), LegacyLayout, nullptr);
+            LegacyLayout->DestroyStruct(LegacyData.GetData());
+            
+            USimpleInventory* Loaded = NewObject<USimpleInventory>();
+            FMemoryReader Reader(Bytes, true);
+            FObjectAndNameAsStringProxyArchive LoadArchive(Reader, false);
+            UClass* InventoryClass = USimpleInventory::StaticClass();
+            InventoryClass->SerializeTaggedProperties(LoadArchive, reinterpret_cast<uint8*>(Loaded), InventoryClass, nullptr);
+            
+            const TArray<FSimpleInventorySlot>& Slots = Loaded->GetSlotData();
+            TestEqual("Every legacy slot should be converted", Slots.Num(), 2);
+            if (Slots.Num() == 2) {
+                TestTrue("ItemIDs should be read from the items", Slots[0].ItemID == 4 && Slots[1].ItemID == 5);
+                TestTrue("Counts should be copied", Slots[0].Count == 2 && Slots[1].Count == 3);
+                TestTrue("Slots should hold their own items", Slots[0].Item.IsValid() && !Slots[0].bUsesDefinition && !Slots[1].bUsesDefinition);
+            }
+        });
+    });
+    
+    Describe("Thread-safe reads", [this]() {
+        It("should read consistent slots from worker threads while the game thread changes them", [this]() {
+            constexpr int32 NumReaders = 4;
+            constexpr int32 StackSize = 10;
+            TestInventory->MaxSlotSize = 8;
+            
+            std::atomic<bool> bStop = false;
+            std::atomic<int32> NumInvalidReads = 0;
+            std::atomic<int32> NumReads = 0;
+            
+            TArray<UE::Tasks::FTask> Readers;
+            for (int32 ReaderIndex = 0; ReaderIndex < NumReaders; ++ReaderIndex) {
+                Readers.Add(UE::Tasks::Launch(TEXT("SimpleInventorySpec.Reader"), [this, &bStop, &NumInvalidReads, &NumReads]() {
+                    while (!bStop) {
+                        const int32 Total = TestInventory->GetItemCountThreadSafe(1);
+                        if (Total < 0 || Total > 8 * StackSize) {
+                            ++NumInvalidReads;
+                        }
+                        
+                        TestInventory->ReadSlotsThreadSafe([&NumInvalidReads](TConstArrayView<FSimpleInventorySlot> Slots, const int32 FirstIndex) {
+                            for (const FSimpleInventorySlot& Slot : Slots) {
+                                if (Slot.Count <= 0 || Slot.Count > StackSize || Slot.ItemID != 1) {
+                                    ++NumInvalidReads;
+                                }
+                            }
+                        });
+                        
+                        FSimpleInventorySlot Slot;
+                        if (TestInventory->GetSlotThreadSafe(0, Slot) && Slot.ItemID != 1) {
+                            ++NumInvalidReads;
+                        }
+                        
+                        TestInventory->HasItemThreadSafe(1, StackSize);
+                        TestInventory->GetLengthThreadSafe();
+                        ++NumReads;
+                    }
+                }));
+            }
+            
+            bool bResult = false;
+            const FInstancedStruct Item = MakeTestItem(1, true, StackSize);
+            const double EndTime = FPlatformTime::Seconds() + 0.5;
+            while (FPlatformTime::Seconds() < EndTime) {
+                TestInventory->AddItem(Item, 25, bResult);
+                
+                int32 Len = 0;
+                TestInventory->GetLength(Len);
+                if (Len > 4) {
+                    TestInventory->RemoveItemAtIndex(0, StackSize, bResult);
+                }
+            }
+            
+            bStop = true;
+            UE::Tasks::Wait(Readers);
+            
+            TestTrue("Readers should have run", NumReads > 0);
+            TestEqual("Readers should never see a partially changed inventory", NumInvalidReads.load(), 0);
+        });
+        
+        It("should read a copied inventory's shared chunks in place", [this]() {
+            const int32 NumSlots = FSimpleInventorySnapshot::ChunkSize + 6;
+            TestInventory->MaxSlotSize = NumSlots;
+            bool bResult = false;
+            for (int32 ItemID = 0; ItemID < NumSlots; ++ItemID) {
+                TestInventory->AddItem(MakeTestItem(ItemID, false), 1, bResult);
+            }
+            const FSimpleInventorySnapshot SourceSnapshot = TestInventory->GetSnapshot();
+            
+            USimpleInventory* Copy = NewObject<USimpleInventory>();
+            Copy->CopyInventory(TestInventory);
+            
+            TArray<int32> FirstIndices;
+            bool bInPlace = true;
+            UE::Tasks::Launch(TEXT("SimpleInventorySpec.ChunkReader"), [Copy, &SourceSnapshot, &FirstIndices, &bInPlace]() {
+                Copy->ReadSlotsThreadSafe([&SourceSnapshot, &FirstIndices, &bInPlace](TConstArrayView<FSimpleInventorySlot> Slots, const int32 FirstIndex) {
+                    FirstIndices.Add(FirstIndex);
+                    bInPlace &= !Slots.IsEmpty() && &Slots[0] == &SourceSnapshot[FirstIndex];
+                });
+            }).Wait();
+            
+            TestTrue("Each chunk should be read once, in order", FirstIndices == TArray<int32>({ 0, FSimpleInventorySnapshot::ChunkSize }));
+            TestTrue("The slots should be the source snapshot's", bInPlace);
+        });
+    });
 }
@@ -0,0 +1,589 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Algo/StableSort.h"
+#include "Engine/DataTable.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "StructUtils/InstancedStruct.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "SimpleInventory.h"
+#include "SimpleInventoryHandle.h"
+#include "SimpleInventoryItem.h"
+#include "SimpleInventoryItemAccessor.h"
+#include "SimpleInventoryItemRegistry.h"
+#include "SimpleInventorySlot.h"
+#include "SimpleInventorySubsystem.h"
+#include "SimpleInventorySubsystemStorage.h"
+#include "SimpleInventoryTestHelpers.h"
+
+static TArray<USimpleInventory*> MakeBenchmarkInventories(const int32 NumInventories,
+                                                      const int32 SlotsPerInventory)
+{
+    TArray<FInstancedStruct> Items = MakeNumberedTestItems(SlotsPerInventory, true);
+    TArray<USimpleInventory*> Inventories;
+    Inventories.Reserve(NumInventories);
+    for (int32 i = 0; i < NumInventories; i++) {
+        USimpleInventory* Inventory = NewObject<USimpleInventory>();
+        Inventory->AddToRoot();
+        Inventory->MaxSlotSize = SlotsPerInventory;
+        for (const FInstancedStruct& Item : Items) {
+            bool bResult = false;
+            Inventory->AddItem(Item, 1, bResult);
+        }
+        Inventories.Add(Inventory);
+    }
+    return Inventories;
+}
+
+static void ReleaseBenchmarkInventories(TArray<USimpleInventory*>& Inventories)
+{
+    for (USimpleInventory* Inventory : Inventories) {
+        Inventory->RemoveFromRoot();
+    }
+    Inventories.Empty();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+}
+
+static SIZE_T MeasureSlotPayloadBytes(const TArray<USimpleInventory*>& Inventories)
+{
+    SIZE_T Bytes = 0;
+    for (const USimpleInventory* Inventory : Inventories) {
+        const TArray<FSimpleInventorySlot>& Slots = Inventory->GetSlotData();
+        Bytes += Slots.GetAllocatedSize();
+        for (const FSimpleInventorySlot& Slot : Slots) {
+            // Each per-slot copy is a separate heap allocation of the item struct.
+            if (const UScriptStruct* Struct = Slot.Item.GetScriptStruct()) {
+                Bytes += Struct->GetStructureSize();
+            }
+        }
+    }
+    return Bytes;
+}
+
+static double MeasureGarbageCollection()
+{
+    const double Start = FPlatformTime::Seconds();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+    return FPlatformTime::Seconds() - Start;
+}
+
+struct FBenchmarkRun
+{
+    double Seconds = 0.0;
+    int32 Notifications = 0;
+};
+
+/**
+ * Times Body and counts the changes the given inventories broadcast while it runs.
+ *
+ * @param Inventories  The inventories whose OnInventoryChangeNative is counted.
+ * @param Body  The work to measure.
+ */
+static FBenchmarkRun RunBenchmark(const TArray<USimpleInventory*>& Inventories, TFunctionRef<void()> Body)
+{
+    FBenchmarkRun Run;
+    TArray<FDelegateHandle> Handles;
+    for (USimpleInventory* Inventory : Inventories) {
+        Handles.Add(Inventory->OnInventoryChangeNative.AddLambda([&Run](const FSimpleInventoryChange&) {
+            ++Run.Notifications;
+        }));
+    }
+    
+    const double Start = FPlatformTime::Seconds();
+    Body();
+    Run.Seconds = FPlatformTime::Seconds() - Start;
+    
+    for (int32 Index = 0; Index < Inventories.Num(); ++Index) {
+        Inventories[Index]->OnInventoryChangeNative.Remove(Handles[Index]);
+    }
+    return Run;
+}
+
+static FString DescribeBenchmarkRun(const TCHAR* Label, const FBenchmarkRun& Run)
+{
+    return FString::Printf(TEXT("%s: %.2f ms, %d notifications"), Label, Run.Seconds * 1000.0, Run.Notifications);
+}
+
+DEFINE_SPEC(SimpleInventoryBenchmarkSpec, "SimpleInventory.Benchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void SimpleInventoryBenchmarkSpec::Define() {
+    Describe("FSimpleInventoryItemAccessor", [this]() {
+        It("should read slot properties faster than FindPropertyByName", [this]() {
+            const int32 NumSlots = 500;
+            const int32 NumIterations = 200;
+            TArray<FInstancedStruct> Items = MakeNumberedTestItems(NumSlots, true);
+
+            int64 FindPropertyChecksum = 0;
+            const double FindPropertyStart = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+                for (const FInstancedStruct& Item : Items) {
+                    const UScriptStruct* Struct = Item.GetScriptStruct();
+                    const void* Memory = Item.GetMemory();
+                    const FIntProperty* IDProp = CastField<FIntProperty>(Struct->FindPropertyByName(TEXT("ID")));
+                    const FBoolProperty* StackableProp = CastField<FBoolProperty>(Struct->FindPropertyByName(TEXT("bIsStackable")));
+                    const FIntProperty* StackSizeProp = CastField<FIntProperty>(Struct->FindPropertyByName(TEXT("StackSize")));
+                    FindPropertyChecksum += IDProp->GetPropertyValue_InContainer(Memory)
+                        + StackableProp->GetPropertyValue_InContainer(Memory)
+                        + StackSizeProp->GetPropertyValue_InContainer(Memory);
+                }
+            }
+            const double FindPropertySeconds = FPlatformTime::Seconds() - FindPropertyStart;
+
+            int64 AccessorChecksum = 0;
+            const double AccessorStart = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < NumIterations; Iteration++) {
+                for (const FInstancedStruct& Item : Items) {
+                    const FSimpleInventoryItemAccessor Accessor = FSimpleInventoryItemAccessorCache::Get(Item.GetScriptStruct());
+                    const void* Memory = Item.GetMemory();
+                    AccessorChecksum += Accessor.GetID(Memory)
+                        + Accessor.IsStackable(Memory)
+                        + Accessor.GetStackSize(Memory);
+                }
+            }
+            const double AccessorSeconds = FPlatformTime::Seconds() - AccessorStart;
+
+            const double SlotReads = static_cast<double>(NumSlots) * NumIterations;
+            AddInfo(FString::Printf(TEXT("FindPropertyByName: %.1f ns/slot"), FindPropertySeconds * 1e9 / SlotReads));
+            AddInfo(FString::Printf(TEXT("Cached accessor:    %.1f ns/slot"), AccessorSeconds * 1e9 / SlotReads));
+
+            TestEqual("Both paths should read the same values", AccessorChecksum, FindPropertyChecksum);
+        });
+    });
+    
+    Describe("FSimpleInventorySlot storage", [this]() {
+        It("should allocate fewer UObjects and collect faster than one UObject per slot", [this]() {
+            const int32 NumInventories = 10000;
+            const int32 SlotsPerInventory = 8;
+            
+            // Struct storage: only the inventories themselves are UObjects.
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+            const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+            TArray<USimpleInventory*> Inventories = MakeBenchmarkInventories(NumInventories, SlotsPerInventory);
+            const double StructGCSeconds = MeasureGarbageCollection();
+            const int32 StructObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+            
+            // UObject-per-slot layout: materialize a USimpleInventorySlot for every slot, as the old storage did.
+            const int32 ObjectsBeforeViews = GUObjectArray.GetObjectArrayNumMinusAvailable();
+            for (USimpleInventory* Inventory : Inventories) {
+                TArray<USimpleInventorySlot*> Slots;
+                Inventory->GetSlots(Slots);
+            }
+            const int32 SlotObjects = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBeforeViews;
+            const double SlotObjectGCSeconds = MeasureGarbageCollection();
+            
+            ReleaseBenchmarkInventories(Inventories);
+            
+            AddInfo(FString::Printf(TEXT("Struct slots:   %d UObjects, GC %.2f ms"), StructObjects, StructGCSeconds * 1000.0));
+            AddInfo(FString::Printf(TEXT("UObject slots:  %d UObjects, GC %.2f ms"), StructObjects + SlotObjects, SlotObjectGCSeconds * 1000.0));
+            
+            TestEqual("Struct storage should allocate one UObject per inventory", StructObjects, NumInventories);
+            TestEqual("UObject storage allocates one UObject per slot", SlotObjects, NumInventories * SlotsPerInventory);
+        });
+    });
+    
+    Describe("FSimpleInventoryItemRegistry", [this]() {
+        It("should use less memory than per-slot item copies in a 50k-slot world", [this]() {
+            const int32 NumInventories = 500;
+            const int32 SlotsPerInventory = 100;
+            
+            TArray<FInstancedStruct> Items = MakeNumberedTestItems(SlotsPerInventory, true);
+            for (int32 i = 0; i < Items.Num(); i++) {
+                Items[i].GetMutable<FSimpleInventoryItem>().ItemName = FText::FromString(FString::Printf(TEXT("Benchmark Item %d"), i));
+            }
+            
+            auto BuildWorld = [&Items, NumInventories, SlotsPerInventory]() {
+                TArray<USimpleInventory*> Inventories;
+                for (int32 i = 0; i < NumInventories; i++) {
+                    USimpleInventory* Inventory = NewObject<USimpleInventory>();
+                    Inventory->AddToRoot();
+                    Inventory->MaxSlotSize = SlotsPerInventory;
+                    for (const FInstancedStruct& Item : Items) {
+                        bool bResult = false;
+                        Inventory->AddItem(Item, 1, bResult);
+                    }
+                    Inventories.Add(Inventory);
+                }
+                return Inventories;
+            };
+            
+            // Per-slot copies: no definitions registered.
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+            const int64 CopyMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+            TArray<USimpleInventory*> CopyInventories = BuildWorld();
+            const int64 CopyMemoryUsed = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - CopyMemoryBefore;
+            const SIZE_T CopyBytes = MeasureSlotPayloadBytes(CopyInventories);
+            ReleaseBenchmarkInventories(CopyInventories);
+            
+            // Shared definitions: the same items registered from a DataTable.
+            UDataTable* ItemTable = NewObject<UDataTable>();
+            ItemTable->RowStruct = FSimpleInventoryItem::StaticStruct();
+            for (int32 i = 0; i < Items.Num(); i++) {
+                ItemTable->AddRow(*FString::Printf(TEXT("Item%d"), i), Items[i].Get<FSimpleInventoryItem>());
+            }
+            FSimpleInventoryItemRegistry::Register(ItemTable);
+            
+            const int64 SharedMemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+            TArray<USimpleInventory*> SharedInventories = BuildWorld();
+            const int64 SharedMemoryUsed = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - SharedMemoryBefore;
+            const SIZE_T SharedBytes = MeasureSlotPayloadBytes(SharedInventories);
+            ReleaseBenchmarkInventories(SharedInventories);
+            FSimpleInventoryItemRegistry::Unregister(ItemTable);
+            
+            const int32 NumSlots = NumInventories * SlotsPerInventory;
+            AddInfo(FString::Printf(TEXT("Per-slot copies:    %.2f MB slot data (%.1f B/slot), %.2f MB process delta"), CopyBytes / (1024.0 * 1024.0), static_cast<double>(CopyBytes) / NumSlots, CopyMemoryUsed / (1024.0 * 1024.0)));
+            AddInfo(FString::Printf(TEXT("Shared definitions: %.2f MB slot data (%.1f B/slot), %.2f MB process delta"), SharedBytes / (1024.0 * 1024.0), static_cast<double>(SharedBytes) / NumSlots, SharedMemoryUsed / (1024.0 * 1024.0)));
+            
+            TestTrue("Shared definitions should use less slot memory", SharedBytes < CopyBytes);
+        });
+    });
+    
+    Describe("FSimpleInventorySubsystemStorage", [this]() {
+        It("should write smaller and faster saves than tagged serialization", [this]() {
+            const int32 NumInventories = 1000;
+            const int32 SlotsPerInventory = 50;
+            const int32 NumDistinctItems = 200;
+            
+            TArray<FInstancedStruct> Items = MakeNumberedTestItems(NumDistinctItems, true);
+            for (int32 i = 0; i < Items.Num(); i++) {
+                Items[i].GetMutable<FSimpleInventoryItem>().ItemName = FText::FromString(FString::Printf(TEXT("Benchmark Item %d"), i));
+            }
+            
+            FSimpleInventorySubsystemStorage Storage;
+            for (int32 i = 0; i < NumInventories; i++) {
+                FSimpleInventoryStorage& Inventory = Storage.Value.Add(FName(*FString::Printf(TEXT("Inventory_%d"), i)));
+                Inventory.MaxSlots = SlotsPerInventory;
+                for (int32 SlotIndex = 0; SlotIndex < SlotsPerInventory; SlotIndex++) {
+                    const FInstancedStruct& Item = Items[(i + SlotIndex) % NumDistinctItems];
+                    FSimpleInventorySlotStorage& StoredSlot = Inventory.StoredSlots.AddDefaulted_GetRef();
+                    StoredSlot.Metadata = Item;
+                    StoredSlot.ItemID = Item.Get<FSimpleInventoryItem>().ID;
+                    StoredSlot.Count = 1 + SlotIndex % 10;
+                }
+            }
+            
+            UScriptStruct* StorageStruct = FSimpleInventorySubsystemStorage::StaticStruct();
+            
+            TArray<uint8> TaggedBytes;
+            const double TaggedWriteStart = FPlatformTime::Seconds();
+            {
+                FMemoryWriter Writer(TaggedBytes, true);
+                StorageStruct->SerializeTaggedProperties(Writer, reinterpret_cast<uint8*>(&Storage), StorageStruct, nullptr);
+            }
+            const double TaggedWriteSeconds = FPlatformTime::Seconds() - TaggedWriteStart;
+            
+            const double TaggedReadStart = FPlatformTime::Seconds();
+            {
+                FSimpleInventorySubsystemStorage Loaded;
+                FMemoryReader Reader(TaggedBytes, true);
+                StorageStruct->SerializeTaggedProperties(Reader, reinterpret_cast<uint8*>(&Loaded), StorageStruct, nullptr);
+            }
+            const double TaggedReadSeconds = FPlatformTime::Seconds() - TaggedReadStart;
+            
+            TArray<uint8> CompactBytes;
+            const double CompactWriteStart = FPlatformTime::Seconds();
+            {
+                FMemoryWriter Writer(CompactBytes, true);
+                StorageStruct->SerializeItem(Writer, &Storage, nullptr);
+            }
+            const double CompactWriteSeconds = FPlatformTime::Seconds() - CompactWriteStart;
+            
+            const double CompactReadStart = FPlatformTime::Seconds();
+            {
+                FSimpleInventorySubsystemStorage Loaded;
+                FMemoryReader Reader(CompactBytes, true);
+                StorageStruct->SerializeItem(Reader, &Loaded, nullptr);
+                TestEqual("Compact load should restore every inventory", Loaded.Value.Num(), NumInventories);
+            }
+            const double CompactReadSeconds = FPlatformTime::Seconds() - CompactReadStart;
+            
+            AddInfo(FString::Printf(TEXT("Tagged:  %.2f KB, write %.2f ms, read %.2f ms"), TaggedBytes.Num() / 1024.0, TaggedWriteSeconds * 1000.0, TaggedReadSeconds * 1000.0));
+            AddInfo(FString::Printf(TEXT("Compact: %.2f KB, write %.2f ms, read %.2f ms"), CompactBytes.Num() / 1024.0, CompactWriteSeconds * 1000.0, CompactReadSeconds * 1000.0));
+            
+            TestTrue("Compact format should be smaller", CompactBytes.Num() < TaggedBytes.Num());
+        });
+    });
+    
+    Describe("InflateFromStorage", [this]() {
+        It("should restore a 5k slot save with its saved layout", [this]() {
+            const int32 NumSlots = 5000;
+            const int32 NumDistinctItems = 1000;
+            const FName InventoryName = TEXT("Benchmark");
+            
+            // Several partial stacks per item, so replaying AddItem would merge them.
+            TArray<FInstancedStruct> Items = MakeNumberedTestItems(NumDistinctItems, true);
+            FSimpleInventorySubsystemStorage Storage;
+            FSimpleInventoryStorage& InventoryStorage = Storage.Value.Add(InventoryName);
+            InventoryStorage.MaxSlots = NumSlots;
+            for (int32 SlotIndex = 0; SlotIndex < NumSlots; SlotIndex++) {
+                const FInstancedStruct& Item = Items[SlotIndex % NumDistinctItems];
+                FSimpleInventorySlotStorage& StoredSlot = InventoryStorage.StoredSlots.AddDefaulted_GetRef();
+                StoredSlot.Metadata = Item;
+                StoredSlot.ItemID = Item.Get<FSimpleInventoryItem>().ID;
+                StoredSlot.Count = 1;
+            }
+            
+            USimpleInventorySubsystem* Subsystem = MakeTestSubsystem();
+            USimpleInventory* Inventory;
+            Subsystem->RegisterInventory(InventoryName, NumSlots, Inventory);
+            
+            const FBenchmarkRun Direct = RunBenchmark({ Inventory }, [Subsystem, &Storage]() {
+                Subsystem->InflateFromStorage(Storage);
+            });
+            const int32 DirectSlots = Inventory->GetSlotData().Num();
+            
+            // The previous restore: clear, then AddItem for every stored slot.
+            const FBenchmarkRun Replay = RunBenchmark({ Inventory }, [Inventory, &InventoryStorage]() {
+                Inventory->Clear();
+                for (const FSimpleInventorySlotStorage& StoredSlot : InventoryStorage.StoredSlots) {
+                    bool bResult = false;
+                    Inventory->AddItem(StoredSlot.Metadata, StoredSlot.Count, bResult);
+                }
+            });
+            
+            AddInfo(DescribeBenchmarkRun(TEXT("Direct restore"), Direct));
+            AddInfo(DescribeBenchmarkRun(TEXT("AddItem replay"), Replay));
+            
+            TestEqual("Direct restore should keep the saved layout", DirectSlots, NumSlots);
+        });
+    });
+    
+    Describe("SortInventory", [this]() {
+        It("should sort a 50k slot stash by descending ID", [this]() {
+            const int32 NumSlots = 50000;
+            TArray<USimpleInventory*> Inventories = MakeBenchmarkInventories(1, NumSlots);
+            USimpleInventory* Inventory = Inventories[0];
+            
+            FSimpleInventorySortKey Key;
+            Key.Type = ESimpleInventorySortKeyType::PROPERTY;
+            Key.PropertyName = TEXT("ID");
+            Key.bDescending = true;
+            
+            const FBenchmarkRun Parallel = RunBenchmark(Inventories, [Inventory, &Key]() {
+                Inventory->SortInventory(Key);
+            });
+            
+            // The same comparisons on one thread, for reference.
+            TArray<int32> Order;
+            for (int32 Index = 0; Index < NumSlots; ++Index) {
+                Order.Add(Index);
+            }
+            const TArray<FSimpleInventorySlot>& Slots = Inventory->GetSlotData();
+            const FBenchmarkRun Serial = RunBenchmark({}, [&Order, &Slots]() {
+                Algo::StableSort(Order, [&Slots](const int32 A, const int32 B) {
+                    return Slots[A].ItemID < Slots[B].ItemID;
+                });
+            });
+            
+            AddInfo(DescribeBenchmarkRun(TEXT("SortInventory"), Parallel));
+            AddInfo(FString::Printf(TEXT("Single-threaded index sort: %.2f ms"), Serial.Seconds * 1000.0));
+            
+            TestEqual("Highest ID should come first", Inventory->GetSlotData()[0].ItemID, NumSlots - 1);
+            
+            ReleaseBenchmarkInventories(Inventories);
+        });
+    });
+    
+    Describe("Consolidate", [this]() {
+        It("should consolidate a 10k slot stash to the layout size of replaying AddItem", [this]() {
+            const int32 NumSlots = 10000;
+            const int32 NumDistinctItems = 1000;
+            
+            // Ten single-count slots per item; half the items stack up to 10, so they fit one stack each.
+            TArray<FInstancedStruct> Items = MakeNumberedTestItems(NumDistinctItems, true);
+            TArray<FSimpleInventorySlot> FragmentedSlots;
+            FragmentedSlots.Reserve(NumSlots);
+            for (int32 SlotIndex = 0; SlotIndex < NumSlots; SlotIndex++) {
+                const FInstancedStruct& Item = Items[SlotIndex % NumDistinctItems];
+                FSimpleInventorySlot& Slot = FragmentedSlots.AddDefaulted_GetRef();
+                Slot.Item = Item;
+                Slot.ItemID = Item.Get<FSimpleInventoryItem>().ID;
+                Slot.Count = 1;
+            }
+            
+            USimpleInventory* Inventory = NewObject<USimpleInventory>();
+            Inventory->AddToRoot();
+            Inventory->MaxSlotSize = NumSlots;
+            Inventory->RestoreSlots(CopyTemp(FragmentedSlots));
+            
+            int32 FreedSlots = 0;
+            const FBenchmarkRun Consolidate = RunBenchmark({ Inventory }, [Inventory, &FreedSlots]() {
+                Inventory->Consolidate(FreedSlots);
+            });
+            const int32 ConsolidatedSlots = Inventory->GetSlotData().Num();
+            
+            // The previous approach: clear, then AddItem every slot back so it merges into existing stacks.
+            Inventory->RestoreSlots(CopyTemp(FragmentedSlots));
+            const FBenchmarkRun Replay = RunBenchmark({ Inventory }, [Inventory, &FragmentedSlots]() {
+                Inventory->Clear();
+                for (const FSimpleInventorySlot& Slot : FragmentedSlots) {
+                    bool bResult = false;
+                    Inventory->AddItem(Slot.Item, Slot.Count, bResult);
+                }
+            });
+            
+            AddInfo(DescribeBenchmarkRun(TEXT("Consolidate"), Consolidate));
+            AddInfo(DescribeBenchmarkRun(TEXT("AddItem replay"), Replay));
+            
+            TestEqual("Consolidate should free every merged slot", FreedSlots, NumSlots / 2 - NumDistinctItems / 2);
+            TestEqual("Consolidate should match the AddItem layout size", ConsolidatedSlots, Inventory->GetSlotData().Num());
+            
+            Inventory->RemoveFromRoot();
+        });
+    });
+    
+    Describe("TransferItems", [this]() {
+        It("should loot every slot of a 2k slot chest", [this]() {
+            const int32 NumSlots = 2000;
+            
+            auto LootChest = [NumSlots](const bool bTransfer, int32& OutLootedSlots) {
+                TArray<USimpleInventory*> Inventories = MakeBenchmarkInventories(1, NumSlots);
+                USimpleInventory* Chest = Inventories[0];
+                USimpleInventory* Player = NewObject<USimpleInventory>();
+                Player->AddToRoot();
+                Player->MaxSlotSize = NumSlots;
+                
+                const FBenchmarkRun Run = RunBenchmark({ Chest, Player }, [bTransfer, NumSlots, Chest, Player]() {
+                    if (bTransfer) {
+                        TArray<FSimpleInventoryTransferEntry> Entries;
+                        Entries.SetNum(NumSlots);
+                        for (int32 SlotIndex = 0; SlotIndex < NumSlots; SlotIndex++) {
+                            Entries[SlotIndex].SlotIndex = SlotIndex;
+                            Entries[SlotIndex].Count = Chest->GetSlotData()[SlotIndex].Count;
+                        }
+                        bool bResult = false;
+                        Chest->TransferItemsBatch(Entries, Player, bResult);
+                    }
+                    else {
+                        // The previous approach: copy each slot's item into the player, then remove it from the chest.
+                        for (int32 SlotIndex = NumSlots - 1; SlotIndex >= 0; SlotIndex--) {
+                            const FSimpleInventorySlot& Slot = Chest->GetSlotData()[SlotIndex];
+                            bool bResult = false;
+                            Player->AddItem(Slot.Item, Slot.Count, bResult);
+                            Chest->RemoveItemAtIndex(SlotIndex, Slot.Count, bResult);
+                        }
+                    }
+                });
+                
+                OutLootedSlots = Player->GetSlotData().Num();
+                Player->RemoveFromRoot();
+                ReleaseBenchmarkInventories(Inventories);
+                return Run;
+            };
+            
+            int32 TransferSlots = 0;
+            const FBenchmarkRun Transfer = LootChest(true, TransferSlots);
+            int32 CopySlots = 0;
+            const FBenchmarkRun Copy = LootChest(false, CopySlots);
+            
+            AddInfo(DescribeBenchmarkRun(TEXT("TransferItemsBatch"), Transfer));
+            AddInfo(DescribeBenchmarkRun(TEXT("Copy then remove"), Copy));
+            
+            TestEqual("Transfer should loot every slot", TransferSlots, NumSlots);
+            TestEqual("Copy then remove should loot every slot", CopySlots, NumSlots);
+        });
+    });
+    
+    Describe("CopyInventory", [this]() {
+        It("should clone a loadout onto many inventories without copying its slots", [this]() {
+            const int32 NumCopies = 1000;
+            const int32 NumSlots = 200;
+            
+            TArray<USimpleInventory*> Inventories = MakeBenchmarkInventories(1, NumSlots);
+            USimpleInventory* Loadout = Inventories[0];
+            
+            const FSimpleInventorySnapshot LoadoutSnapshot = Loadout->GetSnapshot();
+            int32 NumSharedCopies = 0;
+            
+            auto CloneLoadout = [Loadout, NumCopies, NumSlots, &LoadoutSnapshot, &NumSharedCopies](const bool bUseSlots) {
+                TArray<USimpleInventory*> Copies;
+                for (int32 i = 0; i < NumCopies; i++) {
+                    USimpleInventory* Copy = NewObject<USimpleInventory>();
+                    Copy->AddToRoot();
+                    Copy->MaxSlotSize = NumSlots;
+                    Copies.Add(Copy);
+                }
+                
+                const double Start = FPlatformTime::Seconds();
+                for (USimpleInventory* Copy : Copies) {
+                    Copy->CopyInventory(Loadout);
+                    if (bUseSlots) {
+                        // Taking the slot array fills it in, which is what every copy cost before.
+                        Copy->GetSlotData();
+                    }
+                    else {
+                        // Reads are served from the shared snapshot.
+                        bool bHasItem = false;
+                        Copy->HasItem(0, 1, bHasItem);
+                        Copy->GetLengthThreadSafe();
+                    }
+                }
+                const double Seconds = FPlatformTime::Seconds() - Start;
+                
+                for (const USimpleInventory* Copy : Copies) {
+                    if (&Copy->GetSlotDataAt(0) == &LoadoutSnapshot[0]) {
+                        ++NumSharedCopies;
+                    }
+                }
+                
+                ReleaseBenchmarkInventories(Copies);
+                return Seconds;
+            };
+            
+            const double SharedSeconds = CloneLoadout(false);
+            TestEqual("Reads should not copy the loadout's slots", NumSharedCopies, NumCopies);
+            
+            NumSharedCopies = 0;
+            const double CopiedSeconds = CloneLoadout(true);
+            TestEqual("Taking the slot array should copy the loadout's slots", NumSharedCopies, 0);
+            ReleaseBenchmarkInventories(Inventories);
+            
+            AddInfo(FString::Printf(TEXT("Shared snapshot: %.2f ms for %d copies"), SharedSeconds * 1000.0, NumCopies));
+            AddInfo(FString::Printf(TEXT("Copied slots:    %.2f ms for %d copies"), CopiedSeconds * 1000.0, NumCopies));
+        });
+    });
+    
+    Describe("Inventory handles", [this]() {
+        It("should resolve handles faster than inventory names", [this]() {
+            const int32 NumInventories = 64;
+            const int32 NumCalls = 200000;
+            
+            USimpleInventorySubsystem* Subsystem = MakeTestSubsystem();
+            TArray<FName> Names;
+            TArray<FSimpleInventoryHandle> Handles;
+            for (int32 i = 0; i < NumInventories; i++) {
+                const FName InventoryName(*FString::Printf(TEXT("Inventory_%d"), i));
+                USimpleInventory* Inventory;
+                FSimpleInventoryHandle Handle;
+                Subsystem->RegisterInventory(InventoryName, 8, Inventory, Handle);
+                Names.Add(InventoryName);
+                Handles.Add(Handle);
+            }
+            
+            int32 NameHits = 0;
+            const double NameStart = FPlatformTime::Seconds();
+            for (int32 Call = 0; Call < NumCalls; Call++) {
+                int32 Count = 0;
+                Subsystem->GetItemCount(Names[Call % NumInventories], 0, Count);
+                NameHits += Count + 1;
+            }
+            const double NameSeconds = FPlatformTime::Seconds() - NameStart;
+            
+            int32 HandleHits = 0;
+            const double HandleStart = FPlatformTime::Seconds();
+            for (int32 Call = 0; Call < NumCalls; Call++) {
+                int32 Count = 0;
+                Subsystem->GetItemCount(Handles[Call % NumInventories], 0, Count);
+                HandleHits += Count + 1;
+            }
+            const double HandleSeconds = FPlatformTime::Seconds() - HandleStart;
+            
+            AddInfo(FString::Printf(TEXT("FName lookup:  %.1f ns/call"), NameSeconds * 1e9 / NumCalls));
+            AddInfo(FString::Printf(TEXT("Handle lookup: %.1f ns/call"), HandleSeconds * 1e9 / NumCalls));
+            
+            TestEqual("Both paths should reach every inventory", HandleHits, NameHits);
+        });
+    });
+}
@@ -0,0 +1,261 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "StructUtils/InstancedStruct.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "SimpleInventory.h"
+#include "SimpleInventoryItem.h"
+#include "SimpleInventorySubsystem.h"
+#include "SimpleInventorySubsystemStorage.h"
+#include "SimpleInventoryTestHelpers.h"
+
+/** One measured operation at one scale. Written as a CSV row. */
+struct FSimpleInventoryPerformanceSample
+{
+    FString Operation;
+    int32 Slots = 0;
+    int32 Inventories = 0;
+    int64 Ops = 0;
+    double Seconds = 0.0;
+    int64 UsedPhysicalDeltaBytes = 0;
+    int32 LiveObjectDelta = 0;
+    double GCSeconds = 0.0;
+};
+
+/** Times operations and collects the samples of one performance run. */
+class FSimpleInventoryPerformanceRecorder
+{
+public:
+    /**
+     * Run Body once and record its throughput, the change in used physical memory and in live UObjects, and the cost
+     * of the garbage collection that follows it. Neither delta counts individual heap allocations.
+     *
+     * @param Operation    The operation name written to the CSV.
+     * @param Slots        Slots per inventory at this scale.
+     * @param Inventories  Inventories at this scale.
+     * @param Body         The measured work. Returns the number of operations it performed.
+     */
+    void Measure(const TCHAR* Operation,
+                 const int32 Slots,
+                 const int32 Inventories,
+                 TFunctionRef<int64()> Body)
+    {
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+        const int64 MemoryBefore = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+        const int32 ObjectsBefore = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+        const double Start = FPlatformTime::Seconds();
+        const int64 Ops = Body();
+        const double Seconds = FPlatformTime::Seconds() - Start;
+
+        FSimpleInventoryPerformanceSample& Sample = Samples.AddDefaulted_GetRef();
+        Sample.Operation = Operation;
+        Sample.Slots = Slots;
+        Sample.Inventories = Inventories;
+        Sample.Ops = Ops;
+        Sample.Seconds = Seconds;
+        Sample.UsedPhysicalDeltaBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - MemoryBefore;
+        Sample.LiveObjectDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - ObjectsBefore;
+
+        const double GCStart = FPlatformTime::Seconds();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+        Sample.GCSeconds = FPlatformTime::Seconds() - GCStart;
+    }
+
+    /**
+     * Write every sample to Saved/Automation/SimpleInventory/<FileName>.
+     *
+     * @return  The path written to.
+     */
+    FString SaveCSV(const FString& FileName) const
+    {
+        FString CSV = TEXT("Operation,Slots,Inventories,Ops,Seconds,OpsPerSec,UsedPhysicalDeltaBytes,LiveUObjectDelta,GCMs\n");
+        for (const FSimpleInventoryPerformanceSample& Sample : Samples) {
+            const double OpsPerSec = Sample.Seconds > 0.0 ? Sample.Ops / Sample.Seconds : 0.0;
+            CSV += FString::Printf(TEXT("%s,%d,%d,%lld,%.6f,%.1f,%lld,%d,%.3f\n"),
+                                   *Sample.Operation, Sample.Slots, Sample.Inventories, Sample.Ops, Sample.Seconds,
+                                   OpsPerSec, Sample.UsedPhysicalDeltaBytes, Sample.LiveObjectDelta, Sample.GCSeconds * 1000.0);
+        }
+
+        const FString Path = FPaths::Combine(FPaths::AutomationDir(), TEXT("SimpleInventory"), FileName);
+        FFileHelper::SaveStringToFile(CSV, *Path);
+        return Path;
+    }
+
+    const TArray<FSimpleInventoryPerformanceSample>& GetSamples() const
+    {
+        return Samples;
+    }
+
+private:
+    TArray<FSimpleInventoryPerformanceSample> Samples;
+};
+
+DEFINE_SPEC(SimpleInventoryPerformanceSpec, "SimpleInventory.Performance", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void SimpleInventoryPerformanceSpec::Define() {
+    Describe("USimpleInventory", [this]() {
+        It("should measure inventory operations from 10 to 100k slots", [this]() {
+            // Operations that shift slots are capped so the largest scales finish in reasonable time.
+            const int32 MaxRemovals = 1000;
+            FSimpleInventoryPerformanceRecorder Recorder;
+
+            for (const int32 NumSlots : { 10, 100, 1000, 10000, 100000 }) {
+                const TArray<FInstancedStruct> Items = MakeNumberedTestItems(NumSlots, false);
+                const int32 NumRemovals = FMath::Min(NumSlots, MaxRemovals);
+                const int32 NumRepeats = FMath::Clamp(100000 / NumSlots, 1, 100);
+
+                USimpleInventorySubsystem* Subsystem = MakeTestSubsystem();
+                Subsystem->AddToRoot();
+                USimpleInventory* Inventory;
+                Subsystem->RegisterInventory(TEXT("Performance"), NumSlots, Inventory);
+                // Measure calls CollectGarbage; the working copy is not referenced by anything else.
+                USimpleInventory* Working = NewObject<USimpleInventory>(Subsystem);
+                Working->AddToRoot();
+                Working->MaxSlotSize = NumSlots;
+
+                Recorder.Measure(TEXT("AddItem"), NumSlots, 1, [&]() {
+                    for (const FInstancedStruct& Item : Items) {
+                        bool bResult = false;
+                        Inventory->AddItem(Item, 1, bResult);
+                    }
+                    return static_cast<int64>(NumSlots);
+                });
+                TestEqual(FString::Printf(TEXT("%d slots should be filled"), NumSlots), Inventory->GetSlotData().Num(), NumSlots);
+
+                Recorder.Measure(TEXT("HasItem"), NumSlots, 1, [&]() {
+                    for (int32 ItemID = 0; ItemID < NumSlots; ItemID++) {
+                        bool bResult = false;
+                        Inventory->HasItem(ItemID, 1, bResult);
+                    }
+                    return static_cast<int64>(NumSlots);
+                });
+
+                Recorder.Measure(TEXT("CopyInventory"), NumSlots, 1, [&]() {
+                    for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++) {
+                        Working->CopyInventory(Inventory);
+                    }
+                    return static_cast<int64>(NumRepeats);
+                });
+
+                Recorder.Measure(TEXT("RemoveItemAtIndex (front)"), NumSlots, 1, [&]() {
+                    for (int32 i = 0; i < NumRemovals; i++) {
+                        bool bResult = false;
+                        Working->RemoveItemAtIndex(0, 1, bResult);
+                    }
+                    return static_cast<int64>(NumRemovals);
+                });
+
+                Working->CopyInventory(Inventory);
+                const TArray<FInstancedStruct> RemovedItems(Items.GetData(), NumRemovals);
+                Recorder.Measure(TEXT("RemoveItems"), NumSlots, 1, [&]() {
+                    bool bResult = false;
+                    Working->RemoveItems(RemovedItems, bResult);
+                    return static_cast<int64>(NumRemovals);
+                });
+
+                FSimpleInventorySubsystemStorage Storage;
+                Recorder.Measure(TEXT("GetStorage (changed)"), NumSlots, 1, [&]() {
+                    Subsystem->GetStorage(Storage);
+                    return static_cast<int64>(1);
+                });
+
+                Recorder.Measure(TEXT("GetStorage (unchanged)"), NumSlots, 1, [&]() {
+                    for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++) {
+                        Subsystem->GetStorage(Storage);
+                    }
+                    return static_cast<int64>(NumRepeats);
+                });
+
+                Recorder.Measure(TEXT("InflateFromStorage"), NumSlots, 1, [&]() {
+                    for (int32 Repeat = 0; Repeat < NumRepeats; Repeat++) {
+                        Subsystem->InflateFromStorage(Storage);
+                    }
+                    return static_cast<int64>(NumRepeats);
+                });
+                TestEqual(FString::Printf(TEXT("%d slots should be restored"), NumSlots), Inventory->GetSlotData().Num(), NumSlots);
+
+                Working->RemoveFromRoot();
+                Subsystem->RemoveFromRoot();
+            }
+
+            AddInfo(FString::Printf(TEXT("Wrote %s"), *Recorder.SaveCSV(TEXT("InventoryPerformance.csv"))));
+            for (const FSimpleInventoryPerformanceSample& Sample : Recorder.GetSamples()) {
+                AddInfo(FString::Printf(TEXT("%-26s %6d slots: %12.0f ops/s, GC %.2f ms"), *Sample.Operation, Sample.Slots, Sample.Seconds > 0.0 ? Sample.Ops / Sample.Seconds : 0.0, Sample.GCSeconds * 1000.0));
+            }
+        });
+    });
+
+    Describe("USimpleInventorySubsystem", [this]() {
+        It("should measure subsystem operations from 1 to 10k inventories", [this]() {
+            const int32 SlotsPerInventory = 10;
+            const TArray<FInstancedStruct> Items = MakeNumberedTestItems(SlotsPerInventory, false);
+            FSimpleInventoryPerformanceRecorder Recorder;
+
+            for (const int32 NumInventories : { 1, 10, 100, 1000, 10000 }) {
+                TArray<FName> InventoryNames;
+                InventoryNames.Reserve(NumInventories);
+                for (int32 i = 0; i < NumInventories; i++) {
+                    InventoryNames.Add(FName(*FString::Printf(TEXT("Inventory_%d"), i)));
+                }
+
+                USimpleInventorySubsystem* Subsystem = MakeTestSubsystem();
+                Subsystem->AddToRoot();
+
+                Recorder.Measure(TEXT("RegisterInventory"), SlotsPerInventory, NumInventories, [&]() {
+                    for (const FName InventoryName : InventoryNames) {
+                        USimpleInventory* Inventory;
+                        Subsystem->RegisterInventory(InventoryName, SlotsPerInventory, Inventory);
+                    }
+                    return static_cast<int64>(NumInventories);
+                });
+
+                Recorder.Measure(TEXT("AddItem"), SlotsPerInventory, NumInventories, [&]() {
+                    for (const FName InventoryName : InventoryNames) {
+                        for (const FInstancedStruct& Item : Items) {
+                            bool bResult = false;
+                            Subsystem->AddItem(InventoryName, Item, 1, bResult);
+                        }
+                    }
+                    return static_cast<int64>(NumInventories) * SlotsPerInventory;
+                });
+
+                Recorder.Measure(TEXT("HasItem"), SlotsPerInventory, NumInventories, [&]() {
+                    for (const FName InventoryName : InventoryNames) {
+                        bool bResult = false;
+                        Subsystem->HasItem(InventoryName, 0, 1, bResult);
+                    }
+                    return static_cast<int64>(NumInventories);
+                });
+
+                FSimpleInventorySubsystemStorage Storage;
+                Recorder.Measure(TEXT("GetStorage (changed)"), SlotsPerInventory, NumInventories, [&]() {
+                    Subsystem->GetStorage(Storage);
+                    return static_cast<int64>(1);
+                });
+                TestEqual(FString::Printf(TEXT("%d inventories should be stored"), NumInventories), Storage.Value.Num(), NumInventories);
+
+                Recorder.Measure(TEXT("GetStorage (unchanged)"), SlotsPerInventory, NumInventories, [&]() {
+                    Subsystem->GetStorage(Storage);
+                    return static_cast<int64>(1);
+                });
+
+                Recorder.Measure(TEXT("InflateFromStorage"), SlotsPerInventory, NumInventories, [&]() {
+                    Subsystem->InflateFromStorage(Storage);
+                    return static_cast<int64>(1);
+                });
+
+                Subsystem->RemoveFromRoot();
+            }
+
+            AddInfo(FString::Printf(TEXT("Wrote %s"), *Recorder.SaveCSV(TEXT("SubsystemPerformance.csv"))));
+            for (const FSimpleInventoryPerformanceSample& Sample : Recorder.GetSamples()) {
+                AddInfo(FString::Printf(TEXT("%-26s %6d inventories: %12.0f ops/s, GC %.2f ms"), *Sample.Operation, Sample.Inventories, Sample.Seconds > 0.0 ? Sample.Ops / Sample.Seconds : 0.0, Sample.GCSeconds * 1000.0));
+            }
+        });
+    });
+}
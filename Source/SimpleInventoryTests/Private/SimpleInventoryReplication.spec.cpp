@@ -0,0 +1,201 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_EDITOR
+
+#include "Containers/Ticker.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+#include "Settings/LevelEditorPlaySettings.h"
+#include "StructUtils/InstancedStruct.h"
+#include "Tests/AutomationEditorCommon.h"
+
+#include "SimpleInventory.h"
+#include "SimpleInventoryComponent.h"
+#include "SimpleInventoryItem.h"
+
+static FInstancedStruct MakeReplicationTestItem(int32 ID)
+{
+    FSimpleInventoryItem ItemMetadata;
+    ItemMetadata.ID = ID;
+    ItemMetadata.bIsStackable = true;
+    ItemMetadata.StackSize = 10;
+    return FInstancedStruct::Make(ItemMetadata);
+}
+
+static UWorld* FindPIEWorld(const ENetMode NetMode)
+{
+    for (const FWorldContext& Context : GEngine->GetWorldContexts()) {
+        UWorld* World = Context.World();
+        if (Context.WorldType == EWorldType::PIE && World && World->GetNetMode() == NetMode) {
+            return World;
+        }
+    }
+    return nullptr;
+}
+
+static APlayerController* FindRemotePlayerController(UWorld* ServerWorld)
+{
+    for (FConstPlayerControllerIterator It = ServerWorld->GetPlayerControllerIterator(); It; ++It) {
+        APlayerController* PlayerController = It->Get();
+        if (PlayerController && !PlayerController->IsLocalController()) {
+            return PlayerController;
+        }
+    }
+    return nullptr;
+}
+
+static int64 GetServerOutBytes(UWorld* ServerWorld)
+{
+    const UNetDriver* NetDriver = ServerWorld ? ServerWorld->GetNetDriver() : nullptr;
+    return NetDriver ? static_cast<int64>(NetDriver->OutTotalBytes) : 0;
+}
+
+/** One add/remove pattern applied on the server, measured over a fixed window. */
+struct FSimpleInventoryReplicationPattern
+{
+    FString Name;
+    TFunction<void(USimpleInventory*)> Apply;
+};
+
+/** State shared across ticks while the PIE session runs. */
+struct FSimpleInventoryReplicationRun
+{
+    TArray<FSimpleInventoryReplicationPattern> Patterns;
+    int32 PatternIndex = INDEX_NONE;
+    double WindowStart = 0.0;
+    int64 WindowStartBytes = 0;
+    double StartTime = 0.0;
+    TWeakObjectPtr<USimpleInventoryComponent> ServerComponent;
+    ULevelEditorPlaySettings* PlaySettings = nullptr;
+};
+
+DEFINE_SPEC(SimpleInventoryReplicationSpec, "SimpleInventory.Replication", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void SimpleInventoryReplicationSpec::Define() {
+    Describe("USimpleInventoryComponent", [this]() {
+        LatentIt("should replicate slot deltas to the owning client", FTimespan::FromSeconds(60.0), [this](const FDoneDelegate& Done) {
+            const double WindowSeconds = 0.5;
+            const double SessionTimeoutSeconds = 45.0;
+
+            TSharedRef<FSimpleInventoryReplicationRun> Run = MakeShared<FSimpleInventoryReplicationRun>();
+            Run->Patterns.Add({ TEXT("Idle (baseline)"), [](USimpleInventory*) {} });
+            Run->Patterns.Add({ TEXT("Add to existing stack"), [](USimpleInventory* Inventory) {
+                bool bResult = false;
+                Inventory->AddItem(MakeReplicationTestItem(1), 1, bResult);
+            } });
+            Run->Patterns.Add({ TEXT("Add new slot"), [](USimpleInventory* Inventory) {
+                bool bResult = false;
+                Inventory->AddItem(MakeReplicationTestItem(100 + Inventory->GetSlotData().Num()), 1, bResult);
+            } });
+            Run->Patterns.Add({ TEXT("Remove from last slot"), [](USimpleInventory* Inventory) {
+                bool bResult = false;
+                Inventory->RemoveItemAtIndex(Inventory->GetSlotData().Num() - 1, 1, bResult);
+            } });
+            Run->Patterns.Add({ TEXT("Remove first slot (shifts the rest)"), [](USimpleInventory* Inventory) {
+                bool bResult = false;
+                Inventory->RemoveItemAtIndex(0, Inventory->GetSlotData()[0].Count, bResult);
+            } });
+
+            FAutomationEditorCommonUtils::CreateNewMap();
+
+            Run->PlaySettings = NewObject<ULevelEditorPlaySettings>();
+            Run->PlaySettings->AddToRoot();
+            Run->PlaySettings->SetPlayNetMode(EPlayNetMode::PIE_ListenServer);
+            Run->PlaySettings->SetPlayNumberOfClients(2);
+            Run->PlaySettings->bLaunchSeparateServer = false;
+            Run->PlaySettings->SetRunUnderOneProcess(true);
+
+            FRequestPlaySessionParams Params;
+            Params.WorldType = EPlaySessionWorldType::PlayInEditor;
+            Params.EditorPlaySettings = Run->PlaySettings;
+            GEditor->RequestPlaySession(Params);
+            Run->StartTime = FPlatformTime::Seconds();
+
+            FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, Run, Done, WindowSeconds, SessionTimeoutSeconds](float) {
+                auto Finish = [this, Run, Done]() {
+                    GEditor->RequestEndPlayMap();
+                    Run->PlaySettings->RemoveFromRoot();
+                    Done.Execute();
+                    return false;
+                };
+
+                const double Now = FPlatformTime::Seconds();
+                if (Now - Run->StartTime > SessionTimeoutSeconds) {
+                    AddError(TEXT("Timed out waiting for the listen server and client"));
+                    return Finish();
+                }
+
+                UWorld* ServerWorld = FindPIEWorld(NM_ListenServer);
+                UWorld* ClientWorld = FindPIEWorld(NM_Client);
+                if (!ServerWorld || !ClientWorld) {
+                    return true;
+                }
+
+                // Wait for the client to connect, then add the component to its controller on the server.
+                if (!Run->ServerComponent.IsValid()) {
+                    APlayerController* RemoteController = FindRemotePlayerController(ServerWorld);
+                    if (!RemoteController) {
+                        return true;
+                    }
+
+                    USimpleInventoryComponent* Component = NewObject<USimpleInventoryComponent>(RemoteController);
+                    // Zero so BeginPlay's ForceResize adds no padding slots; capacity is set on the inventory below.
+                    Component->MaxSlotSize = 0;
+                    Component->RegisterComponent();
+                    Component->Inventory->MaxSlotSize = 20;
+
+                    bool bResult = false;
+                    Component->Inventory->AddItem(MakeReplicationTestItem(1), 5, bResult);
+                    for (int32 i = 0; i < 8; i++) {
+                        Component->Inventory->AddItem(MakeReplicationTestItem(100 + i), 1, bResult);
+                    }
+
+                    Run->ServerComponent = Component;
+                    Run->WindowStart = Now;
+                    return true;
+                }
+
+                if (Now - Run->WindowStart < WindowSeconds) {
+                    return true;
+                }
+
+                // Close the current window and report the bytes sent during it.
+                const int64 OutBytes = GetServerOutBytes(ServerWorld);
+                if (Run->PatternIndex != INDEX_NONE) {
+                    AddInfo(FString::Printf(TEXT("%-36s %lld bytes"), *Run->Patterns[Run->PatternIndex].Name, OutBytes - Run->WindowStartBytes));
+                }
+
+                APlayerController* ClientController = ClientWorld->GetFirstPlayerController();
+                USimpleInventoryComponent* ClientComponent = ClientController ? ClientController->FindComponentByClass<USimpleInventoryComponent>() : nullptr;
+                if (Run->PatternIndex != INDEX_NONE && ClientComponent && ClientComponent->Inventory) {
+                    const TArray<FSimpleInventorySlot>& ServerSlots = Run->ServerComponent->Inventory->GetSlotData();
+                    const TArray<FSimpleInventorySlot>& ClientSlots = ClientComponent->Inventory->GetSlotData();
+                    TestEqual(FString::Printf(TEXT("%s: client slot count"), *Run->Patterns[Run->PatternIndex].Name), ClientSlots.Num(), ServerSlots.Num());
+                    for (int32 Index = 0; Index < FMath::Min(ServerSlots.Num(), ClientSlots.Num()); ++Index) {
+                        TestEqual(TEXT("Client slot count matches server"), ClientSlots[Index].Count, ServerSlots[Index].Count);
+                    }
+                }
+                else if (Run->PatternIndex != INDEX_NONE) {
+                    AddError(TEXT("Client did not receive the inventory component"));
+                    return Finish();
+                }
+
+                ++Run->PatternIndex;
+                if (!Run->Patterns.IsValidIndex(Run->PatternIndex)) {
+                    return Finish();
+                }
+
+                Run->WindowStart = Now;
+                Run->WindowStartBytes = OutBytes;
+                Run->Patterns[Run->PatternIndex].Apply(Run->ServerComponent->Inventory);
+                return true;
+            }));
+        });
+    });
+}
+
+#endif
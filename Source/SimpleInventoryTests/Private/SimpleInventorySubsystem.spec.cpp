@@ -3,9 +3,13 @@
 #include "Engine/GameInstance.h"
 #include "Tests/AutomationCommon.h"
 #include "Editor/UnrealEd/Public/Tests/AutomationEditorCommon.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 #include "SimpleInventoryChange.h"
+#include "SimpleInventoryHandle.h"
 #include "SimpleInventoryItem.h"
+#include "SimpleInventoryItemEntry.h"
 #include "SimpleInventory.h"
 #include "SimpleInventorySlot.h"
 #include "SimpleInventorySubsystem.h"
@@ -33,6 +37,70 @@ void SimpleInventorySubsystemSpec::Define() {
         });
     });
 
+    Describe("Inventory handles", [this]() {
+        It("should resolve a handle to its inventory and forward operations", [this]() {
+            FSimpleInventoryHandle Handle;
+            InventorySubsystem->RegisterInventory(TEXT("Inv1"), 4, RegisteredInventory, Handle);
+
+            TestTrue("Handle should be set", Handle.IsSet());
+            TestTrue("Handle should resolve to the inventory", InventorySubsystem->ResolveHandle(Handle) == RegisteredInventory);
+
+            FSimpleInventoryItem Item;
+            Item.ID = 7;
+            Item.bIsStackable = true;
+            Item.StackSize = 5;
+            bool bResult = false;
+            InventorySubsystem->AddItem(Handle, FInstancedStruct::Make(Item), 3, bResult);
+            TestTrue("AddItem should succeed through the handle", bResult);
+
+            int32 Total = 0;
+            InventorySubsystem->GetItemCount(TEXT("Inv1"), 7, Total);
+            TestEqual("The named inventory should hold the item", Total, 3);
+
+            USimpleInventory* Existing = nullptr;
+            FSimpleInventoryHandle ExistingHandle;
+            InventorySubsystem->RegisterInventory(TEXT("Inv1"), 4, Existing, ExistingHandle);
+            TestTrue("Registering again should return the same handle", ExistingHandle == Handle);
+        });
+
+        It("should not resolve stale handles after unregistering", [this]() {
+            FSimpleInventoryHandle Handle;
+            InventorySubsystem->RegisterInventory(TEXT("Inv1"), 4, RegisteredInventory, Handle);
+            InventorySubsystem->UnregisterInventory(TEXT("Inv1"));
+
+            TestFalse("Inventory should be removed from the map", InventorySubsystem->InventoryMap.Contains(TEXT("Inv1")));
+            TestNull("Stale handle should not resolve", InventorySubsystem->ResolveHandle(Handle));
+
+            USimpleInventory* Replacement = nullptr;
+            FSimpleInventoryHandle NewHandle;
+            InventorySubsystem->RegisterInventory(TEXT("Inv2"), 4, Replacement, NewHandle);
+            TestEqual("The freed index should be reused", NewHandle.Index, Handle.Index);
+            TestNotEqual("The serial should differ", NewHandle.Serial, Handle.Serial);
+            TestNull("Stale handle should still not resolve", InventorySubsystem->ResolveHandle(Handle));
+
+            int32 Length = INDEX_NONE;
+            InventorySubsystem->GetLength(Handle, Length);
+            TestEqual("Operations on a stale handle should return defaults", Length, 0);
+        });
+
+        It("should find handles of inventories registered from definitions", [this]() {
+            USimpleInventoryDefinitions* Definitions = NewObject<USimpleInventoryDefinitions>(GetTransientPackage(), USimpleInventoryDefinitions::StaticClass());
+            FSimpleInventoryDefinition Definition;
+            Definition.InventoryName = TEXT("InvFromDef");
+            Definition.MaxSlots = 3;
+            Definitions->Values.Add(Definition);
+            InventorySubsystem->RegisterInventoryDefinitions(Definitions);
+
+            FSimpleInventoryHandle Handle;
+            InventorySubsystem->FindHandle(TEXT("InvFromDef"), Handle);
+            TestTrue("Handle should resolve to the registered inventory", InventorySubsystem->ResolveHandle(Handle) == InventorySubsystem->InventoryMap.FindRef(TEXT("InvFromDef")));
+
+            FSimpleInventoryHandle Missing;
+            InventorySubsystem->FindHandle(TEXT("Unknown"), Missing);
+            TestFalse("Unknown inventories should have no handle", Missing.IsSet());
+        });
+    });
+
     Describe("RegisterInventoryDefinitions", [this]() {
         It("should register all inventories from a definitions asset", [this]() {
             USimpleInventoryDefinitions* Definitions = NewObject<USimpleInventoryDefinitions>(GetTransientPackage(), USimpleInventoryDefinitions::StaticClass());
@@ -170,6 +238,23 @@ void SimpleInventorySubsystemSpec::Define() {
             
             TestFalse("Should not have the item", bHas);
         });
+        
+        It("should count an item across stacks with GetItemCount and HasAtLeast", [this]() {
+            FSimpleInventoryItem Item;
+            Item.ID = 7;
+            Item.bIsStackable = true;
+            Item.StackSize = 5;
+            bool bResult = false;
+            InventorySubsystem->AddItem(TEXT("Inv1"), FInstancedStruct::Make(Item), 8, bResult);
+            
+            int32 Total = 0;
+            InventorySubsystem->GetItemCount(TEXT("Inv1"), 7, Total);
+            TestEqual("Total should cover both stacks", Total, 8);
+            
+            bool bHasAtLeast = false;
+            InventorySubsystem->HasAtLeast(TEXT("Inv1"), 7, 6, bHasAtLeast);
+            TestTrue("Should have at least 6", bHasAtLeast);
+        });
     });
     
     Describe("AddItem / RemoveItemAtIndex / RemoveItems", [this]() {
@@ -199,6 +284,77 @@ void SimpleInventorySubsystemSpec::Define() {
             
             TestTrue("Should handle removing empty list", bRemoved);
         });
+
+        It("should fail for an unknown inventory", [this]() {
+            AddExpectedError(TEXT("Invalid Inventory: Missing"), EAutomationExpectedErrorFlags::Contains, 2);
+
+            bool bRemovedAtIndex = true;
+            InventorySubsystem->RemoveItemAtIndex(TEXT("Missing"), 0, 1, bRemovedAtIndex);
+            bool bRemoved = true;
+            InventorySubsystem->RemoveItems(TEXT("Missing"), TArray<FInstancedStruct>(), bRemoved);
+
+            TestFalse("RemoveItemAtIndex should fail", bRemovedAtIndex);
+            TestFalse("RemoveItems should fail", bRemoved);
+        });
+    });
+    
+    Describe("AddItems / RemoveItemsByCount", [this]() {
+        It("should fail every entry for an unknown inventory", [this]() {
+            AddExpectedError(TEXT("Invalid Inventory: Missing"), EAutomationExpectedErrorFlags::Contains, 2);
+            
+            FSimpleInventoryItem TestItem;
+            TestItem.ID = 1;
+            FSimpleInventoryItemEntry AddEntry;
+            AddEntry.Item = FInstancedStruct::Make(TestItem);
+            AddEntry.Count = 1;
+            FSimpleInventoryItemCountEntry RemoveEntry;
+            RemoveEntry.ItemID = 1;
+            RemoveEntry.Count = 1;
+            
+            bool bAdded = true;
+            TArray<bool> AddResults;
+            InventorySubsystem->AddItems(TEXT("Missing"), { AddEntry, AddEntry }, false, AddResults, bAdded);
+            bool bRemoved = true;
+            TArray<bool> RemoveResults;
+            InventorySubsystem->RemoveItemsByCount(TEXT("Missing"), { RemoveEntry }, false, RemoveResults, bRemoved);
+            
+            TestFalse("AddItems should fail", bAdded);
+            TestTrue("AddItems should fail each entry", AddResults == TArray<bool>({ false, false }));
+            TestFalse("RemoveItemsByCount should fail", bRemoved);
+            TestTrue("RemoveItemsByCount should fail each entry", RemoveResults == TArray<bool>({ false }));
+        });
+    });
+    
+    Describe("TransferItems", [this]() {
+        BeforeEach([this]() {
+            InventorySubsystem->RegisterInventory(TEXT("Inv1"), 4, RegisteredInventory);
+            USimpleInventory* OtherInv = nullptr;
+            InventorySubsystem->RegisterInventory(TEXT("Inv2"), 4, OtherInv);
+        });
+        
+        It("should rebroadcast a transfer as one paired change", [this]() {
+            FSimpleInventoryItem TestItem;
+            TestItem.ID = 3;
+            TestItem.bIsStackable = true;
+            TestItem.StackSize = 10;
+            bool bResult = false;
+            InventorySubsystem->AddItem(TEXT("Inv1"), FInstancedStruct::Make(TestItem), 4, bResult);
+            
+            TArray<FSimpleInventoryChange> Changes;
+            InventorySubsystem->OnInventorySubsystemChangeNative.AddLambda([&Changes](const FSimpleInventoryChange& Change) {
+                Changes.Add(Change);
+            });
+            
+            InventorySubsystem->TransferItems(TEXT("Inv1"), 0, TEXT("Inv2"), 4, bResult);
+            TestTrue("Transfer should succeed", bResult);
+            
+            int32 Total = 0;
+            InventorySubsystem->GetItemCount(TEXT("Inv2"), 3, Total);
+            TestEqual("The items should arrive in the target inventory", Total, 4);
+            TestEqual("Subsystem should broadcast once", Changes.Num(), 1);
+            TestTrue("The change should name both inventories",
+                     Changes.Num() == 1 && Changes[0].InventoryName == TEXT("Inv2") && Changes[0].TransferInventoryName == TEXT("Inv1"));
+        });
     });
     
     Describe("Clear / ClearAll", [this]() {
@@ -248,6 +404,31 @@ void SimpleInventorySubsystemSpec::Define() {
         });
     });
     
+    Describe("BeginBatch / EndBatch", [this]() {
+        BeforeEach([this]() {
+            InventorySubsystem->RegisterInventory(TEXT("Inv1"), 4, RegisteredInventory);
+        });
+        
+        It("should rebroadcast a batch as a single change", [this]() {
+            int32 NumChanges = 0;
+            InventorySubsystem->OnInventorySubsystemChangeNative.AddLambda([&NumChanges](const FSimpleInventoryChange&) {
+                ++NumChanges;
+            });
+            
+            FSimpleInventoryItem TestItem;
+            TestItem.bIsStackable = true;
+            TestItem.StackSize = 10;
+            bool bAdded = false;
+            
+            InventorySubsystem->BeginBatch(TEXT("Inv1"));
+            InventorySubsystem->AddItem(TEXT("Inv1"), FInstancedStruct::Make(TestItem), 1, bAdded);
+            InventorySubsystem->AddItem(TEXT("Inv1"), FInstancedStruct::Make(TestItem), 1, bAdded);
+            InventorySubsystem->EndBatch(TEXT("Inv1"));
+            
+            TestEqual("Subsystem should broadcast once", NumChanges, 1);
+        });
+    });
+    
     Describe("GetStorage / InflateFromStorage", [this]() {
         It("should export and import storage without crash", [this]() {
             // Register a test inventory
@@ -278,5 +459,385 @@ void SimpleInventorySubsystemSpec::Define() {
             InventorySubsystem->GetSlots(InventoryName, SlotsAfterInflate);
             TestEqual("Inventory should have 1 item after InflateFromStorage", SlotsAfterInflate.Num(), 1);
         });
+        
+        It("should restore the saved slot layout with a single LOAD change", [this]() {
+            const FName InventoryName = TEXT("LayoutInventory");
+            FSimpleInventoryItem TestItem;
+            TestItem.ID = 3;
+            TestItem.bIsStackable = true;
+            TestItem.StackSize = 10;
+            
+            // Two partial stacks of the same item; AddItem would have merged them.
+            FSimpleInventorySubsystemStorage Storage;
+            FSimpleInventoryStorage& InventoryStorage = Storage.Value.Add(InventoryName);
+            InventoryStorage.MaxSlots = 5;
+            for (const int32 Count : { 4, 3 }) {
+                FSimpleInventorySlotStorage& StoredSlot = InventoryStorage.StoredSlots.AddDefaulted_GetRef();
+                StoredSlot.Metadata = FInstancedStruct::Make(TestItem);
+                StoredSlot.ItemID = TestItem.ID;
+                StoredSlot.Count = Count;
+            }
+            
+            USimpleInventory* Inv;
+            InventorySubsystem->RegisterInventory(InventoryName, 5, Inv);
+            TArray<ESimpleInventoryChangeType> ChangeTypes;
+            Inv->OnInventoryChangeNative.AddLambda([&ChangeTypes](const FSimpleInventoryChange& Change) {
+                ChangeTypes.Add(Change.Type);
+            });
+            
+            InventorySubsystem->InflateFromStorage(Storage);
+            
+            const TArray<FSimpleInventorySlot>& Slots = Inv->GetSlotData();
+            if (TestEqual("Both stacks should be restored", Slots.Num(), 2)) {
+                TestEqual("First stack count", Slots[0].Count, 4);
+                TestEqual("Second stack count", Slots[1].Count, 3);
+            }
+            TestEqual("One change should be broadcast", ChangeTypes.Num(), 1);
+            TestTrue("The change should be LOAD", ChangeTypes.Num() == 1 && ChangeTypes[0] == ESimpleInventoryChangeType::LOAD);
+            
+            bool bHasItem = false;
+            Inv->HasItem(3, 4, bHasItem);
+            TestTrue("Restored slots should be indexed", bHasItem);
+        });
+        
+        It("should keep slots whose item definition is not registered yet", [this]() {
+            AddExpectedError(TEXT("No item definition registered yet for ItemID 42"), EAutomationExpectedErrorFlags::Contains, 1);
+            
+            const FName InventoryName = TEXT("DefinitionInventory");
+            FSimpleInventorySubsystemStorage Storage;
+            FSimpleInventoryStorage& InventoryStorage = Storage.Value.Add(InventoryName);
+            InventoryStorage.MaxSlots = 5;
+            FSimpleInventorySlotStorage& StoredSlot = InventoryStorage.StoredSlots.AddDefaulted_GetRef();
+            StoredSlot.ItemID = 42;
+            StoredSlot.Count = 2;
+            
+            InventorySubsystem->InflateFromStorage(Storage);
+            
+            USimpleInventory* Inv = nullptr;
+            InventorySubsystem->GetInventory(InventoryName, Inv);
+            const TArray<FSimpleInventorySlot>& Slots = Inv->GetSlotData();
+            TestTrue("The slot should keep referencing its definition",
+                     Slots.Num() == 1 && Slots[0].bUsesDefinition && Slots[0].ItemID == 42 && Slots[0].Count == 2);
+            
+            FSimpleInventorySubsystemStorage Saved;
+            InventorySubsystem->GetStorage(Saved);
+            const FSimpleInventoryStorage* SavedInventory = Saved.Value.Find(InventoryName);
+            TestTrue("The next save should keep the slot",
+                     SavedInventory && SavedInventory->StoredSlots.Num() == 1 && SavedInventory->StoredSlots[0].ItemID == 42);
+        });
+    });
+    
+    Describe("InflateFromStorageLazy", [this]() {
+        auto MakeLazyStorage = []() {
+            FSimpleInventoryItem TestItem;
+            TestItem.ID = 8;
+            
+            FSimpleInventorySubsystemStorage Storage;
+            FSimpleInventoryStorage& InventoryStorage = Storage.Value.Add(TEXT("Chest"));
+            InventoryStorage.MaxSlots = 4;
+            FSimpleInventorySlotStorage& StoredSlot = InventoryStorage.StoredSlots.AddDefaulted_GetRef();
+            StoredSlot.Metadata = FInstancedStruct::Make(TestItem);
+            StoredSlot.ItemID = TestItem.ID;
+            StoredSlot.Count = 2;
+            return Storage;
+        };
+        
+        It("should not create inventories until they are accessed", [this, MakeLazyStorage]() {
+            InventorySubsystem->InflateFromStorageLazy(MakeLazyStorage());
+            
+            TestFalse("Inventory should not be created yet", InventorySubsystem->InventoryMap.Contains(TEXT("Chest")));
+            TestTrue("Inventory should be pending", InventorySubsystem->IsInventoryPendingInflation(TEXT("Chest")));
+            
+            bool bHasItem = false;
+            InventorySubsystem->HasItem(TEXT("Chest"), 8, 2, bHasItem);
+            TestTrue("Accessing the inventory should restore it", bHasItem);
+            TestFalse("Inventory should no longer be pending", InventorySubsystem->IsInventoryPendingInflation(TEXT("Chest")));
+        });
+        
+        It("should write untouched inventories back unchanged", [this, MakeLazyStorage]() {
+            InventorySubsystem->InflateFromStorageLazy(MakeLazyStorage());
+            
+            FSimpleInventorySubsystemStorage Saved;
+            InventorySubsystem->GetStorage(Saved);
+            
+            TestTrue("Inventory should still be pending", InventorySubsystem->IsInventoryPendingInflation(TEXT("Chest")));
+            const FSimpleInventoryStorage* Chest = Saved.Value.Find(TEXT("Chest"));
+            if (TestNotNull("Pending inventory should be saved", Chest)) {
+                TestEqual("MaxSlots", Chest->MaxSlots, 4);
+                TestEqual("Slot count", Chest->StoredSlots.Num(), 1);
+            }
+        });
+        
+        It("should restore registered inventories immediately", [this, MakeLazyStorage]() {
+            USimpleInventory* Inv;
+            InventorySubsystem->RegisterInventory(TEXT("Chest"), 4, Inv);
+            
+            InventorySubsystem->InflateFromStorageLazy(MakeLazyStorage());
+            
+            TestFalse("Registered inventory should not be pending", InventorySubsystem->IsInventoryPendingInflation(TEXT("Chest")));
+            TestEqual("Registered inventory should be restored", Inv->GetSlotData().Num(), 1);
+        });
+    });
+    
+    Describe("GetStorageDelta", [this]() {
+        It("should only return inventories changed since the previous call", [this]() {
+            USimpleInventory* First;
+            USimpleInventory* Second;
+            InventorySubsystem->RegisterInventory(TEXT("First"), 5, First);
+            InventorySubsystem->RegisterInventory(TEXT("Second"), 5, Second);
+            
+            FSimpleInventoryItem TestItem;
+            TestItem.ID = 1;
+            bool bResult = false;
+            InventorySubsystem->AddItem(TEXT("First"), FInstancedStruct::Make(TestItem), 1, bResult);
+            
+            FSimpleInventorySubsystemStorageDelta Delta;
+            InventorySubsystem->GetStorageDelta(Delta);
+            TestEqual("First delta should contain every inventory", Delta.Changed.Num(), 2);
+            
+            InventorySubsystem->GetStorageDelta(Delta);
+            TestTrue("Delta should be empty without changes", Delta.IsEmpty());
+            
+            const uint64 Generation = Second->GetGeneration();
+            InventorySubsystem->AddItem(TEXT("Second"), FInstancedStruct::Make(TestItem), 2, bResult);
+            TestTrue("Generation should advance", Second->GetGeneration() > Generation);
+            
+            InventorySubsystem->GetStorageDelta(Delta);
+            TestEqual("Only the changed inventory should be returned", Delta.Changed.Num(), 1);
+            TestTrue("Changed inventory should be Second", Delta.Changed.Contains(TEXT("Second")));
+        });
+        
+        It("should report removed inventories and apply onto saved storage", [this]() {
+            USimpleInventory* Inv;
+            InventorySubsystem->RegisterInventory(TEXT("Temporary"), 5, Inv);
+            
+            FSimpleInventorySubsystemStorage Saved;
+            InventorySubsystem->GetStorage(Saved);
+            FSimpleInventorySubsystemStorageDelta Delta;
+            InventorySubsystem->GetStorageDelta(Delta);
+            
+            InventorySubsystem->InventoryMap.Remove(TEXT("Temporary"));
+            InventorySubsystem->GetStorageDelta(Delta);
+            TestEqual("Removed inventory should be reported", Delta.Removed.Num(), 1);
+            
+            Saved.ApplyDelta(Delta);
+            TestFalse("Applied storage should drop the removed inventory", Saved.Value.Contains(TEXT("Temporary")));
+        });
+        
+        It("should rebuild cached storage after a change", [this]() {
+            USimpleInventory* Inv;
+            InventorySubsystem->RegisterInventory(TEXT("Cached"), 5, Inv);
+            
+            FSimpleInventoryItem TestItem;
+            TestItem.ID = 1;
+            bool bResult = false;
+            Inv->AddItem(FInstancedStruct::Make(TestItem), 1, bResult);
+            
+            FSimpleInventorySubsystemStorage Storage;
+            InventorySubsystem->GetStorage(Storage);
+            TestEqual("Initial slot count", Storage.Value[TEXT("Cached")].StoredSlots.Num(), 1);
+            
+            Inv->AddItem(FInstancedStruct::Make(TestItem), 1, bResult);
+            InventorySubsystem->GetStorage(Storage);
+            TestEqual("Storage should see the new slot", Storage.Value[TEXT("Cached")].StoredSlots.Num(), 2);
+        });
+    });
+    
+    Describe("FSimpleInventorySubsystemStorage Serialize", [this]() {
+        auto MakeStorage = []() {
+            FSimpleInventoryItem Sword;
+            Sword.ID = 1;
+            Sword.ItemName = FText::FromString(TEXT("Sword"));
+            FSimpleInventoryItem Potion;
+            Potion.ID = -2;
+            Potion.bIsStackable = true;
+            Potion.StackSize = 300;
+            
+            FSimpleInventorySubsystemStorage Storage;
+            for (const FName InventoryName : { FName(TEXT("Backpack")), FName(TEXT("Chest")) }) {
+                FSimpleInventoryStorage& Inventory = Storage.Value.Add(InventoryName);
+                Inventory.MaxSlots = 20;
+                for (int32 i = 0; i < 3; i++) {
+                    FSimpleInventorySlotStorage& SwordSlot = Inventory.StoredSlots.AddDefaulted_GetRef();
+                    SwordSlot.Metadata = FInstancedStruct::Make(Sword);
+                    SwordSlot.ItemID = Sword.ID;
+                    SwordSlot.Count = 1;
+                }
+                FSimpleInventorySlotStorage& PotionSlot = Inventory.StoredSlots.AddDefaulted_GetRef();
+                PotionSlot.Metadata = FInstancedStruct::Make(Potion);
+                PotionSlot.ItemID = Potion.ID;
+                PotionSlot.Count = 250;
+                FSimpleInventorySlotStorage& DefinitionSlot = Inventory.StoredSlots.AddDefaulted_GetRef();
+                DefinitionSlot.ItemID = 7;
+                DefinitionSlot.Count = 3;
+            }
+            return Storage;
+        };
+        
+        auto TestStorageEqual = [this](const FSimpleInventorySubsystemStorage& Expected, const FSimpleInventorySubsystemStorage& Actual) {
+            TestEqual("Inventory count", Actual.Value.Num(), Expected.Value.Num());
+            for (const auto& ExpectedInventory : Expected.Value) {
+                const FSimpleInventoryStorage* ActualInventory = Actual.Value.Find(ExpectedInventory.Key);
+                if (!TestNotNull("Inventory should exist", ActualInventory)) {
+                    continue;
+                }
+                TestEqual("MaxSlots", ActualInventory->MaxSlots, ExpectedInventory.Value.MaxSlots);
+                if (!TestEqual("Slot count", ActualInventory->StoredSlots.Num(), ExpectedInventory.Value.StoredSlots.Num())) {
+                    continue;
+                }
+                for (int32 i = 0; i < ActualInventory->StoredSlots.Num(); i++) {
+                    const FSimpleInventorySlotStorage& ExpectedSlot = ExpectedInventory.Value.StoredSlots[i];
+                    const FSimpleInventorySlotStorage& ActualSlot = ActualInventory->StoredSlots[i];
+                    TestEqual("ItemID", ActualSlot.ItemID, ExpectedSlot.ItemID);
+                    TestEqual("Count", ActualSlot.Count, ExpectedSlot.Count);
+                    TestTrue("Metadata", ActualSlot.Metadata == ExpectedSlot.Metadata);
+                }
+            }
+        };
+        
+        It("should round-trip through the compact format", [this, MakeStorage, TestStorageEqual]() {
+            FSimpleInventorySubsystemStorage Saved = MakeStorage();
+            
+            TArray<uint8> Bytes;
+            FMemoryWriter Writer(Bytes, true);
+            FSimpleInventorySubsystemStorage::StaticStruct()->SerializeItem(Writer, &Saved, nullptr);
+            
+            FSimpleInventorySubsystemStorage Loaded;
+            FMemoryReader Reader(Bytes, true);
+            FSimpleInventorySubsystemStorage::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+            
+            TestFalse("Reader should not error", Reader.IsError());
+            TestEqual("Reader should consume every byte", Reader.Tell(), static_cast<int64>(Bytes.Num()));
+            TestStorageEqual(Saved, Loaded);
+        });
+        
+        It("should still load storage saved with tagged properties", [this, MakeStorage, TestStorageEqual]() {
+            FSimpleInventorySubsystemStorage Saved = MakeStorage();
+            
+            TArray<uint8> Bytes;
+            FMemoryWriter Writer(Bytes, true);
+            UScriptStruct* StorageStruct = FSimpleInventorySubsystemStorage::StaticStruct();
+            StorageStruct->SerializeTaggedProperties(Writer, reinterpret_cast<uint8*>(&Saved), StorageStruct, nullptr);
+            
+            FSimpleInventorySubsystemStorage Loaded;
+            FMemoryReader Reader(Bytes, true);
+            StorageStruct->SerializeItem(Reader, &Loaded, nullptr);
+            
+            TestFalse("Reader should not error", Reader.IsError());
+            TestStorageEqual(Saved, Loaded);
+        });
+        
+        It("should realign to the next record when an item reads less than was saved", [this, MakeStorage, TestStorageEqual]() {
+            AddExpectedError(TEXT("read"), EAutomationExpectedErrorFlags::Contains, 1);
+            FSimpleInventorySubsystemStorage Saved = MakeStorage();
+            
+            TArray<uint8> Bytes;
+            FMemoryWriter Writer(Bytes, true);
+            FSimpleInventorySubsystemStorage::StaticStruct()->SerializeItem(Writer, &Saved, nullptr);
+            
+            // Find the first item's size prefix and payload, then pad the payload as if the struct had lost a field.
+            const FSimpleInventorySlotStorage& FirstSlot = Saved.Value.CreateConstIterator()->Value.StoredSlots[0];
+            TArray<uint8> Payload;
+            FMemoryWriter PayloadWriter(Payload, true);
+            UScriptStruct* ItemStruct = const_cast<UScriptStruct*>(FirstSlot.Metadata.GetScriptStruct());
+            ItemStruct->SerializeItem(PayloadWriter, const_cast<uint8*>(FirstSlot.Metadata.GetMemory()), nullptr);
+            
+            TArray<uint8> Record;
+            FMemoryWriter RecordWriter(Record, true);
+            int32 ByteSize = Payload.Num();
+            RecordWriter << ByteSize;
+            Record.Append(Payload);
+            
+            int32 RecordStart = INDEX_NONE;
+            for (int32 Position = 0; Position + Record.Num() <= Bytes.Num(); ++Position) {
+                if (FMemory::Memcmp(Bytes.GetData() + Position, Record.GetData(), Record.Num()) == 0) {
+                    RecordStart = Position;
+                    break;
+                }
+            }
+            if (!TestNotEqual("The item record should be found", RecordStart, static_cast<int32>(INDEX_NONE))) {
+                return;
+            }
+            constexpr int32 Padding = 4;
+            const int32 PaddedSize = ByteSize + Padding;
+            FMemory::Memcpy(Bytes.GetData() + RecordStart, &PaddedSize, sizeof(int32));
+            Bytes.InsertZeroed(RecordStart + Record.Num(), Padding);
+            
+            FSimpleInventorySubsystemStorage Loaded;
+            FMemoryReader Reader(Bytes, true);
+            FSimpleInventorySubsystemStorage::StaticStruct()->SerializeItem(Reader, &Loaded, nullptr);
+            
+            TestFalse("Reader should not error", Reader.IsError());
+            TestEqual("Reader should consume every byte", Reader.Tell(), static_cast<int64>(Bytes.Num()));
+            TestStorageEqual(Saved, Loaded);
+        });
+        
+        It("should round-trip through compressed bytes", [this, MakeStorage, TestStorageEqual]() {
+            FSimpleInventorySubsystemStorage Saved = MakeStorage();
+            
+            TArray<uint8> Bytes;
+            TestTrue("Save should succeed", Saved.SaveToCompressedBytes(Bytes));
+            
+            FSimpleInventorySubsystemStorage Loaded;
+            TestTrue("Load should succeed", Loaded.LoadFromCompressedBytes(Bytes));
+            TestStorageEqual(Saved, Loaded);
+        });
+        
+        It("should reject corrupt compressed bytes", [this, MakeStorage]() {
+            TArray<uint8> Bytes;
+            MakeStorage().SaveToCompressedBytes(Bytes);
+            Bytes.SetNum(Bytes.Num() / 2);
+            
+            FSimpleInventorySubsystemStorage Loaded;
+            AddExpectedError(TEXT("LoadFromCompressedBytes"), EAutomationExpectedErrorFlags::Contains, 0);
+            TestFalse("Load should fail", Loaded.LoadFromCompressedBytes(Bytes));
+            TestEqual("Storage should be untouched", Loaded.Value.Num(), 0);
+        });
+        
+        It("should reject a header claiming more than the data can decompress to", [this, MakeStorage]() {
+            TArray<uint8> Bytes;
+            MakeStorage().SaveToCompressedBytes(Bytes);
+            const int32 HugeSize = MAX_int32;
+            FMemory::Memcpy(Bytes.GetData(), &HugeSize, sizeof(int32));
+            
+            FSimpleInventorySubsystemStorage Loaded;
+            AddExpectedError(TEXT("Invalid size"), EAutomationExpectedErrorFlags::Contains, 1);
+            TestFalse("Load should fail", Loaded.LoadFromCompressedBytes(Bytes));
+        });
+    });
+    
+    Describe("SaveStorageAsync / LoadStorageAsync", [this]() {
+        LatentIt("should save and restore inventories off the game thread", [this](const FDoneDelegate& Done) {
+            // Keep the subsystem alive across the frames the latent test spans.
+            InventorySubsystem->AddToRoot();
+            
+            USimpleInventory* Inv;
+            InventorySubsystem->RegisterInventory(TEXT("AsyncInv"), 10, Inv);
+            FSimpleInventoryItem TestItem;
+            TestItem.ID = 4;
+            TestItem.bIsStackable = true;
+            TestItem.StackSize = 10;
+            bool bResult = false;
+            Inv->AddItem(FInstancedStruct::Make(TestItem), 7, bResult);
+            
+            USimpleInventorySubsystem* Subsystem = InventorySubsystem;
+            Subsystem->SaveStorageAsyncNative(USimpleInventorySubsystem::FOnSimpleInventorySaveCompleteNativeDelegate::CreateLambda([this, Subsystem, Done](bool bSaved, const TArray<uint8>& SaveData) {
+                TestTrue("Save should succeed", bSaved);
+                Subsystem->Clear(TEXT("AsyncInv"));
+                
+                Subsystem->LoadStorageAsyncNative(SaveData, USimpleInventorySubsystem::FOnSimpleInventoryLoadCompleteNativeDelegate::CreateLambda([this, Subsystem, Done](bool bLoaded) {
+                    TestTrue("Load should succeed", bLoaded);
+                    TestFalse("Load should be finished", Subsystem->IsLoadingAsync());
+                    
+                    bool bHasItem = false;
+                    Subsystem->HasItem(TEXT("AsyncInv"), 4, 7, bHasItem);
+                    TestTrue("Restored inventory should contain the item", bHasItem);
+                    
+                    Subsystem->RemoveFromRoot();
+                    Done.Execute();
+                }));
+                TestTrue("Load should be in progress", Subsystem->IsLoadingAsync());
+            }));
+        });
     });
 }
@@ -0,0 +1,43 @@
+// Copyright Eric Downey - 2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/GameInstance.h"
+#include "StructUtils/InstancedStruct.h"
+#include "UObject/Package.h"
+
+#include "SimpleInventoryItem.h"
+#include "SimpleInventorySubsystem.h"
+
+/**
+ * Makes Num distinct items with IDs 0 to Num - 1.
+ *
+ * @param Num            The number of items.
+ * @param bStackEvenIDs  If true, items with an even ID stack up to 10. Otherwise no item stacks.
+ * @return               The items, in ID order.
+ */
+inline TArray<FInstancedStruct> MakeNumberedTestItems(const int32 Num,
+                                                      const bool bStackEvenIDs)
+{
+    TArray<FInstancedStruct> Items;
+    Items.Reserve(Num);
+    for (int32 i = 0; i < Num; i++) {
+        FSimpleInventoryItem ItemMetadata;
+        ItemMetadata.ID = i;
+        ItemMetadata.bIsStackable = bStackEvenIDs && (i % 2) == 0;
+        ItemMetadata.StackSize = bStackEvenIDs ? 10 : 1;
+        Items.Add(FInstancedStruct::Make(ItemMetadata));
+    }
+    return Items;
+}
+
+/**
+ * Makes a subsystem outside of a running game, owned by a transient game instance.
+ * The subsystem is not rooted; callers that collect garbage while using it must root it themselves.
+ */
+inline USimpleInventorySubsystem* MakeTestSubsystem()
+{
+    UGameInstance* GameInstance = NewObject<UGameInstance>(GetTransientPackage());
+    return NewObject<USimpleInventorySubsystem>(GameInstance);
+}